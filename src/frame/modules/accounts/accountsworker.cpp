@@ -24,6 +24,7 @@
  */
 
 #include "accountsworker.h"
+#include "userpropertyloader.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
 
@@ -49,6 +50,7 @@ using namespace DCC_NAMESPACE;
 const QString AccountsService("com.deepin.daemon.Accounts");
 const QString FingerPrintService("com.deepin.daemon.Authenticate");
 const QString DisplayManagerService("org.freedesktop.DisplayManager");
+const QString AccountsUserInterface("com.deepin.daemon.Accounts.User");
 
 const QString AutoLoginVisable = "auto-login-visable";
 const QString NoPasswordVisable = "nopasswd-login-visable";
@@ -62,6 +64,7 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
 #endif
     , m_dmInter(new DisplayManager(DisplayManagerService, "/org/freedesktop/DisplayManager", QDBusConnection::systemBus(), this))
     , m_userModel(userList)
+    , m_userLoader(new UserPropertyLoader(AccountsService, AccountsUserInterface, QDBusConnection::systemBus(), this))
 {
     struct passwd *pws;
     pws = getpwuid(getuid());
@@ -72,6 +75,11 @@ AccountsWorker::AccountsWorker(UserModel *userList, QObject *parent)
     connect(m_accountsInter, &Accounts::UserDeleted, this, &AccountsWorker::removeUser, Qt::QueuedConnection);
 
     connect(m_dmInter, &DisplayManager::SessionsChanged, this, &AccountsWorker::updateUserOnlineStatus);
+    connect(m_userLoader, &UserPropertyLoader::loaded, this, &AccountsWorker::onUsersLoaded);
+
+    // 所有用户的属性变化只监听一次, 不需要为每个用户创建 DBus 对象
+    QDBusConnection::systemBus().connect(AccountsService, QString(), "org.freedesktop.DBus.Properties", "PropertiesChanged",
+                                         this, SLOT(onUserPropertiesChanged(QDBusMessage)));
 
     m_accountsInter->setSync(false);
     m_dmInter->setSync(false);
@@ -145,22 +153,16 @@ void AccountsWorker::getPresetGroupsResult(QDBusPendingCallWatcher *watch)
 
 void AccountsWorker::setGroups(User *user, const QStringList &usrGroups)
 {
-    AccountsUser *userInter = m_userInters[user];
-    Q_ASSERT(userInter);
+    AccountsUser *ui = userInter(user);
+    Q_ASSERT(ui);
 
-    userInter->SetGroups(usrGroups);
+    ui->SetGroups(usrGroups);
 }
 
 void AccountsWorker::active()
 {
-    for (auto it(m_userInters.cbegin()); it != m_userInters.cend(); ++it) {
-        it.key()->setName(it.value()->userName());
-        it.key()->setAutoLogin(it.value()->automaticLogin());
-        it.key()->setAvatars(it.value()->iconList());
-        it.key()->setGroups(it.value()->groups());
-        it.key()->setCurrentAvatar(it.value()->iconFile());
-        it.key()->setCreatedTime(it.value()->createdTime());
-    }
+    // 重新获取所有用户的属性
+    m_userLoader->load(m_userPaths.values());
 }
 
 QString AccountsWorker::getCurrentUserName()
@@ -204,7 +206,7 @@ void AccountsWorker::createAccount(const User *user)
 void AccountsWorker::setAvatar(User *user, const QString &iconPath)
 {
     qDebug() << "set account avatar";
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     ui->SetIconFile(iconPath);
@@ -212,7 +214,7 @@ void AccountsWorker::setAvatar(User *user, const QString &iconPath)
 
 void AccountsWorker::setFullname(User *user, const QString &fullname)
 {
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     Q_EMIT requestFrameAutoHide(false);
@@ -238,7 +240,7 @@ void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
         Q_EMIT m_userModel->isCancelChanged();
     } else {
         Q_EMIT m_userModel->deleteUserSuccess();
-        removeUser(m_userInters.value(user)->path());
+        removeUser(m_userPaths.value(user));
         getAllGroups();
 
         QDBusPendingReply<> listFingersReply = m_fingerPrint->ListFingers(user->name());
@@ -259,7 +261,7 @@ void AccountsWorker::deleteAccount(User *user, const bool deleteHome)
 
 void AccountsWorker::setAutoLogin(User *user, const bool autoLogin)
 {
-    AccountsUser *ui = m_userInters[user];
+    AccountsUser *ui = userInter(user);
     Q_ASSERT(ui);
 
     // because this operate need root permission, we must wait for finished and refersh result
@@ -277,27 +279,15 @@ void AccountsWorker::setAutoLogin(User *user, const bool autoLogin)
     });
 }
 
-void AccountsWorker::loadUserList()
-{
-    onUserListChanged(m_accountsInter->userList());
-}
-
 void AccountsWorker::onUserListChanged(const QStringList &userList)
 {
-    int count = 0;
-    static bool first = true;
+    QStringList paths;
     for (const QString &path : userList) {
-        if (!m_userModel->contains(path)) {
-            count++;
-            addUser(path);
-            if (count > 50 && first) {
-                first = false;
-                break; // 第一次打开用户列表只加载51个用户信息
-            } else if (count > 2 && !first) {
-                break; // 滚动条每滑动一次，加载3个用户
-            }
-        }
+        if (!path.contains("User0", Qt::CaseInsensitive) && !m_userModel->contains(path))
+            paths << path;
     }
+
+    m_userLoader->load(paths);
 }
 
 void AccountsWorker::setPassword(User *user, const QString &oldpwd, const QString &passwd)
@@ -322,84 +312,133 @@ void AccountsWorker::setPassword(User *user, const QString &oldpwd, const QStrin
 
 void AccountsWorker::deleteUserIcon(User *user, const QString &iconPath)
 {
-    AccountsUser *userInter = m_userInters[user];
-    Q_ASSERT(userInter);
+    AccountsUser *ui = userInter(user);
+    Q_ASSERT(ui);
 
-    userInter->DeleteIconFile(iconPath);
+    ui->DeleteIconFile(iconPath);
 }
 
 void AccountsWorker::addUser(const QString &userPath)
 {
-    if (userPath.contains("User0", Qt::CaseInsensitive))
+    if (userPath.contains("User0", Qt::CaseInsensitive) || m_userModel->contains(userPath))
         return;
-    AccountsUser *userInter = new AccountsUser(AccountsService, userPath, QDBusConnection::systemBus(), this);
-    userInter->setSync(false);
 
-    User *user = new User(this);
+    m_userLoader->load({ userPath });
+}
 
-    connect(userInter, &AccountsUser::UserNameChanged, user, [=](const QString &name) {
-        user->setName(name);
-        user->setOnline(m_onlineUsers.contains(name));
-        user->setIsCurrentUser(name == m_currentUserName);
-#ifdef DCC_ENABLE_ADDOMAIN
-        checkADUser();
-#endif
-    });
+void AccountsWorker::removeUser(const QString &userPath)
+{
+    // 还没有返回的属性请求(如 active() 中的重新获取)不能再创建已删除的用户
+    m_userLoader->cancel(userPath);
+
+    User *user = m_pathUsers.take(userPath);
+    if (!user)
+        return;
+
+    m_userPaths.remove(user);
+    if (m_nameUsers.value(user->name()) == user)
+        m_nameUsers.remove(user->name());
+    if (AccountsUser *ui = m_userInters.take(user))
+        ui->deleteLater();
 
-    connect(userInter, &AccountsUser::AutomaticLoginChanged, user, &User::setAutoLogin);
-    connect(userInter, &AccountsUser::IconListChanged, user, &User::setAvatars);
-    connect(userInter, &AccountsUser::IconFileChanged, user, &User::setCurrentAvatar);
-    connect(userInter, &AccountsUser::FullNameChanged, user, &User::setFullname);
-    connect(userInter, &AccountsUser::NoPasswdLoginChanged, user, &User::setNopasswdLogin);
-    connect(userInter, &AccountsUser::PasswordStatusChanged, user, &User::setPasswordStatus);
-    connect(userInter, &AccountsUser::CreatedTimeChanged, user, &User::setCreatedTime);
-    connect(userInter, &AccountsUser::GroupsChanged, user, &User::setGroups);
-    connect(userInter, &AccountsUser::AccountTypeChanged, user, &User::setUserType);
-    connect(userInter, &AccountsUser::MaxPasswordAgeChanged, user, &User::setPasswordAge);
-
-    // 这里直接赋值的话, 由于请求是异步的, 所以一开始会被初始化成乱码,
-    // 然后数据正常了以后会额外产生一次变化信号
-    // 对于计算当前有多少个管理员有干扰.
-    userInter->userName();
-    userInter->fullName();
-    userInter->automaticLogin();
-    userInter->iconList();
-    userInter->groups();
-    userInter->iconFile();
-    userInter->noPasswdLogin();
-    userInter->passwordStatus();
-    userInter->createdTime();
-    userInter->accountType();
-    userInter->maxPasswordAge();
-    userInter->IsPasswordExpired();
-
-    m_userInters[user] = userInter;
-    m_userModel->addUser(userPath, user);
+    user->deleteLater();
+    m_userModel->removeUser(userPath);
 }
 
-void AccountsWorker::removeUser(const QString &userPath)
+void AccountsWorker::onUsersLoaded(const QList<QPair<QString, QVariantMap>> &users)
 {
-    for (AccountsUser *userInter : m_userInters.values()) {
-        if (userInter->path() == userPath) {
-            User *user = m_userInters.key(userInter);
-            user->deleteLater();
+    for (const auto &data : users) {
+        User *user = m_pathUsers.value(data.first);
+        if (user) {
+            updateUser(user, data.second);
+            continue;
+        }
 
-            m_userInters.remove(user);
-            m_userModel->removeUser(userPath);
+        // 先设置好所有属性再加入列表, 计算管理员数量时不会受到初始值的干扰
+        user = new User(this);
+        updateUser(user, data.second);
 
-            return;
+        m_pathUsers.insert(data.first, user);
+        m_userPaths.insert(user, data.first);
+        m_userModel->addUser(data.first, user);
+    }
+}
+
+void AccountsWorker::onUserPropertiesChanged(const QDBusMessage &msg)
+{
+    const QList<QVariant> &arguments = msg.arguments();
+    if (arguments.size() < 2 || arguments.at(0).toString() != AccountsUserInterface)
+        return;
+
+    User *user = m_pathUsers.value(msg.path());
+    if (!user)
+        return;
+
+    updateUser(user, qdbus_cast<QVariantMap>(arguments.at(1)));
+}
+
+void AccountsWorker::updateUser(User *user, const QVariantMap &properties)
+{
+    for (auto it = properties.cbegin(); it != properties.cend(); ++it) {
+        const QString &key = it.key();
+        const QVariant &value = it.value();
+
+        if (key == "UserName") {
+            const QString &name = value.toString();
+            if (m_nameUsers.value(user->name()) == user)
+                m_nameUsers.remove(user->name());
+            m_nameUsers.insert(name, user);
+            user->setName(name);
+            user->setOnline(m_onlineUsers.contains(name));
+            user->setIsCurrentUser(name == m_currentUserName);
+#ifdef DCC_ENABLE_ADDOMAIN
+            checkADUser();
+#endif
+        } else if (key == "FullName") {
+            user->setFullname(value.toString());
+        } else if (key == "AutomaticLogin") {
+            user->setAutoLogin(value.toBool());
+        } else if (key == "IconList") {
+            user->setAvatars(value.toStringList());
+        } else if (key == "IconFile") {
+            user->setCurrentAvatar(value.toString());
+        } else if (key == "Groups") {
+            user->setGroups(value.toStringList());
+        } else if (key == "NoPasswdLogin") {
+            user->setNopasswdLogin(value.toBool());
+        } else if (key == "PasswordStatus") {
+            user->setPasswordStatus(value.toString());
+        } else if (key == "CreatedTime") {
+            user->setCreatedTime(value.toULongLong());
+        } else if (key == "AccountType") {
+            user->setUserType(value.toInt());
+        } else if (key == "MaxPasswordAge") {
+            user->setPasswordAge(value.toInt());
         }
     }
 }
 
+AccountsUser *AccountsWorker::userInter(User *user)
+{
+    AccountsUser *ui = m_userInters.value(user);
+    if (ui || !m_userPaths.contains(user))
+        return ui;
+
+    // 只有修改用户信息时才需要, 第一次使用时再创建
+    ui = new AccountsUser(AccountsService, m_userPaths.value(user), QDBusConnection::systemBus(), this);
+    ui->setSync(false);
+    m_userInters.insert(user, ui);
+    return ui;
+}
+
 void AccountsWorker::setNopasswdLogin(User *user, const bool nopasswdLogin)
 {
-    AccountsUser *userInter = m_userInters[user];
-    Q_ASSERT(userInter);
+    AccountsUser *ui = userInter(user);
+    Q_ASSERT(ui);
 
     Q_EMIT requestFrameAutoHide(false);
 
-    QDBusPendingCall call = userInter->EnableNoPasswdLogin(nopasswdLogin);
+    QDBusPendingCall call = ui->EnableNoPasswdLogin(nopasswdLogin);
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
         if (call.isError()) {
@@ -413,10 +452,10 @@ void AccountsWorker::setNopasswdLogin(User *user, const bool nopasswdLogin)
 
 void AccountsWorker::setMaxPasswordAge(User *user, const int maxAge)
 {
-    AccountsUser *userInter = m_userInters[user];
-    Q_ASSERT(userInter);
+    AccountsUser *ui = userInter(user);
+    Q_ASSERT(ui);
 
-    QDBusPendingCall call = userInter->SetMaxPasswordAge(maxAge);
+    QDBusPendingCall call = ui->SetMaxPasswordAge(maxAge);
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] {
         if (call.isError()) {
@@ -506,15 +545,26 @@ void AccountsWorker::ADDomainHandle(const QString &server, const QString &admin,
 
 void AccountsWorker::updateUserOnlineStatus(const QList<QDBusObjectPath> &paths)
 {
-    m_onlineUsers.clear();
+    QSet<QString> sessions;
+    for (const QDBusObjectPath &path : paths)
+        sessions << path.path();
+
+    // 已经结束的会话
+    for (auto it = m_sessionUsers.begin(); it != m_sessionUsers.end();) {
+        if (sessions.contains(it.key())) {
+            ++it;
+            continue;
+        }
 
-    for (const QDBusObjectPath &path : paths) {
-        Session tmpSession(DisplayManagerService, path.path(), QDBusConnection::systemBus());
-        m_onlineUsers << tmpSession.userName();
+        setUserOnline(it.value(), false);
+        it = m_sessionUsers.erase(it);
     }
+    m_pendingSessions.intersect(sessions);
 
-    for (User *user : m_userModel->userList()) {
-        user->setOnline(m_onlineUsers.contains(user->name()));
+    // 新增的会话, 同时发出所有查询
+    for (const QString &path : sessions) {
+        if (!m_sessionUsers.contains(path) && !m_pendingSessions.contains(path))
+            requestSessionUser(path);
     }
 
 #ifdef DCC_ENABLE_ADDOMAIN
@@ -522,20 +572,68 @@ void AccountsWorker::updateUserOnlineStatus(const QList<QDBusObjectPath> &paths)
 #endif
 }
 
+void AccountsWorker::requestSessionUser(const QString &sessionPath)
+{
+    m_pendingSessions << sessionPath;
+
+    QDBusMessage msg = QDBusMessage::createMethodCall(DisplayManagerService, sessionPath, "org.freedesktop.DBus.Properties", "Get");
+    msg << "org.freedesktop.DisplayManager.Session" << "UserName";
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::systemBus().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, sessionPath](QDBusPendingCallWatcher *w) {
+        QDBusPendingReply<QVariant> reply = *w;
+        w->deleteLater();
+
+        // 返回前会话已经结束
+        if (!m_pendingSessions.remove(sessionPath))
+            return;
+
+        if (reply.isError()) {
+            qDebug() << "get user of session" << sessionPath << "failed:" << reply.error().message();
+            return;
+        }
+
+        const QString &name = reply.value().toString();
+        m_sessionUsers.insert(sessionPath, name);
+        setUserOnline(name, true);
+
+#ifdef DCC_ENABLE_ADDOMAIN
+        checkADUser();
+#endif
+    });
+}
+
+void AccountsWorker::setUserOnline(const QString &name, bool online)
+{
+    auto it = m_onlineUsers.find(name);
+    if (online) {
+        if (it == m_onlineUsers.end()) {
+            m_onlineUsers.insert(name, 1);
+        } else {
+            ++it.value();
+            return;
+        }
+    } else {
+        if (it == m_onlineUsers.end())
+            return;
+        if (--it.value() > 0)
+            return;
+        m_onlineUsers.erase(it);
+    }
+
+    // 同一个用户可能有多个会话, 只在第一个会话开始和最后一个会话结束时更新
+    if (User *user = m_nameUsers.value(name))
+        user->setOnline(online);
+}
+
 #ifdef DCC_ENABLE_ADDOMAIN
 void AccountsWorker::checkADUser()
 {
     // AD User is not in native user list, but session list have it.
     bool isADUser = false;
 
-    QStringList userList;
-
-    for (User *user : m_userModel->userList()) {
-        userList << user->name();
-    }
-
-    for (const QString &u : m_onlineUsers) {
-        if (!userList.contains(u)) {
+    for (auto it = m_onlineUsers.cbegin(); it != m_onlineUsers.cend(); ++it) {
+        if (!m_nameUsers.contains(it.key())) {
             isADUser = true;
             break;
         }
@@ -31,7 +31,6 @@
 #include <com_deepin_daemon_accounts.h>
 #include <com_deepin_daemon_accounts_user.h>
 #include <org_freedesktop_displaymanager.h>
-#include <org_freedesktop_displaymanager_session.h>
 #include <com_deepin_daemon_authenticate_fingerprint.h>
 
 #ifdef DCC_ENABLE_ADDOMAIN
@@ -47,7 +46,6 @@ using CreationResult = dcc::accounts::CreationResult;
 using Fingerprint = com::deepin::daemon::authenticate::Fingerprint;
 
 using DisplayManager = org::freedesktop::DisplayManager;
-using Session = org::freedesktop::displaymanager::Session;
 
 #ifdef DCC_ENABLE_ADDOMAIN
 using Notifications = org::freedesktop::Notifications;
@@ -57,6 +55,7 @@ namespace dcc {
 namespace accounts {
 
 class User;
+class UserPropertyLoader;
 
 class AccountsWorker : public QObject
 {
@@ -87,7 +86,6 @@ public Q_SLOTS:
     void deleteUserIcon(User *user, const QString &iconPath);
     void setNopasswdLogin(User *user, const bool nopasswdLogin);
     void setMaxPasswordAge(User *user, const int maxAge);
-    void loadUserList();
 
 #ifdef DCC_ENABLE_ADDOMAIN
     void refreshADDomain();
@@ -98,6 +96,8 @@ public Q_SLOTS:
     void setGroups(User *user, const QStringList &usrGroups);
 private Q_SLOTS:
     void updateUserOnlineStatus(const QList<QDBusObjectPath> &paths);
+    void onUsersLoaded(const QList<QPair<QString, QVariantMap>> &users);
+    void onUserPropertiesChanged(const QDBusMessage &msg);
     void getAllGroups();
     void getAllGroupsResult(QDBusPendingCallWatcher *watch);
     void getPresetGroups();
@@ -108,7 +108,10 @@ private Q_SLOTS:
 #endif
 
 private:
-    AccountsUser *userInter(const QString &userName) const;
+    AccountsUser *userInter(User *user);
+    void updateUser(User *user, const QVariantMap &properties);
+    void requestSessionUser(const QString &sessionPath);
+    void setUserOnline(const QString &name, bool online);
     CreationResult *createAccountInternal(const User *user);
     QString cryptUserPassword(const QString &password);
 
@@ -119,11 +122,20 @@ private:
     Notifications *m_notifyInter;
 #endif
     QSet<QString> m_userSet;
+    // 按需创建的用户 DBus 对象
     QMap<User *, AccountsUser *> m_userInters;
+    QHash<QString, User *> m_pathUsers;
+    QHash<User *, QString> m_userPaths;
     QString m_currentUserName;
     DisplayManager *m_dmInter;
-    QStringList m_onlineUsers;
+    // 会话路径 -> 用户名, 只在会话增加时查询一次
+    QHash<QString, QString> m_sessionUsers;
+    QSet<QString> m_pendingSessions;
+    // 在线的用户名 -> 会话数量
+    QHash<QString, int> m_onlineUsers;
+    QHash<QString, User *> m_nameUsers;
     UserModel *m_userModel;
+    UserPropertyLoader *m_userLoader;
 };
 
 }   // namespace accounts
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2016 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "userpropertyloader.h"
+
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QTimer>
+#include <QDebug>
+
+using namespace dcc::accounts;
+
+namespace {
+// 大约是一屏用户列表的数量
+const int DefaultMaxPending = 16;
+}
+
+UserPropertyLoader::UserPropertyLoader(const QString &service, const QString &interface,
+                                       const QDBusConnection &connection, QObject *parent)
+    : QObject(parent)
+    , m_service(service)
+    , m_interface(interface)
+    , m_connection(connection)
+    , m_maxPending(DefaultMaxPending)
+    , m_pending(0)
+    , m_flushScheduled(false)
+{
+}
+
+void UserPropertyLoader::load(const QStringList &paths)
+{
+    for (const QString &path : paths) {
+        // 取消后又重新加入的用户, 使用正在进行的请求的结果
+        if (m_cancelled.remove(path)) {
+            m_loading.insert(path);
+            continue;
+        }
+
+        if (m_loading.contains(path))
+            continue;
+
+        m_loading.insert(path);
+        m_queue << path;
+    }
+
+    sendNext();
+}
+
+void UserPropertyLoader::cancel(const QString &path)
+{
+    if (m_queue.removeAll(path) == 0 && m_loading.contains(path))
+        m_cancelled.insert(path);
+    m_loading.remove(path);
+
+    for (auto it = m_results.begin(); it != m_results.end();) {
+        if (it->first == path) {
+            it = m_results.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UserPropertyLoader::sendNext()
+{
+    while (m_pending < m_maxPending && !m_queue.isEmpty()) {
+        const QString path = m_queue.takeFirst();
+
+        QDBusMessage msg = QDBusMessage::createMethodCall(m_service, path, "org.freedesktop.DBus.Properties", "GetAll");
+        msg << m_interface;
+
+        ++m_pending;
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_connection.asyncCall(msg), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path](QDBusPendingCallWatcher *w) {
+            QDBusPendingReply<QVariantMap> reply = *w;
+            w->deleteLater();
+
+            --m_pending;
+
+            if (m_cancelled.remove(path)) {
+                // 用户已被删除, 丢弃结果
+            } else if (reply.isError()) {
+                m_loading.remove(path);
+                qDebug() << "get properties of" << path << "failed:" << reply.error().message();
+            } else {
+                m_loading.remove(path);
+                m_results << qMakePair(path, reply.value());
+            }
+
+            // 前一个请求返回后立即发出下一个, 保持总是有 maxPending 个请求在进行
+            sendNext();
+
+            if (!m_flushScheduled) {
+                m_flushScheduled = true;
+                QTimer::singleShot(0, this, &UserPropertyLoader::flush);
+            }
+        });
+    }
+}
+
+void UserPropertyLoader::flush()
+{
+    m_flushScheduled = false;
+    if (m_results.isEmpty())
+        return;
+
+    QList<QPair<QString, QVariantMap>> results;
+    results.swap(m_results);
+    Q_EMIT loaded(results);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2016 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef USERPROPERTYLOADER_H
+#define USERPROPERTYLOADER_H
+
+#include <QObject>
+#include <QDBusConnection>
+#include <QStringList>
+#include <QVariantMap>
+#include <QSet>
+#include <QPair>
+
+namespace dcc {
+namespace accounts {
+
+/**
+ * @brief The UserPropertyLoader class 批量获取用户对象的属性
+ * 每个用户只调用一次 org.freedesktop.DBus.Properties.GetAll, 同时最多有 maxPending 个请求在进行,
+ * 返回的结果在每次事件循环中合并成一批发出, 界面不需要为每个用户单独刷新
+ */
+class UserPropertyLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit UserPropertyLoader(const QString &service, const QString &interface,
+                                const QDBusConnection &connection, QObject *parent = nullptr);
+
+    void setMaxPending(int maxPending) { m_maxPending = qMax(1, maxPending); }
+    int maxPending() const { return m_maxPending; }
+
+    // 已经在等待中的路径不会重复请求
+    void load(const QStringList &paths);
+    bool isLoading(const QString &path) const { return m_loading.contains(path); }
+    // 用户被删除后调用, 丢弃还没有返回或还没有发出的结果
+    void cancel(const QString &path);
+
+Q_SIGNALS:
+    // 获取失败的用户不会出现在结果中
+    void loaded(const QList<QPair<QString, QVariantMap>> &users);
+
+private:
+    void sendNext();
+    void flush();
+
+private:
+    QString m_service;
+    QString m_interface;
+    QDBusConnection m_connection;
+    int m_maxPending;
+    int m_pending;
+    QStringList m_queue;
+    QSet<QString> m_loading;
+    // 请求已经发出后被取消的路径, 返回时丢弃结果
+    QSet<QString> m_cancelled;
+    QList<QPair<QString, QVariantMap>> m_results;
+    bool m_flushScheduled;
+};
+
+}   // namespace accounts
+}   // namespace dcc
+
+#endif // USERPROPERTYLOADER_H
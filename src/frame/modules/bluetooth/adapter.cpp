@@ -101,7 +101,7 @@ QList<QString> Adapter::devicesId() const
 
 const Device *Adapter::deviceById(const QString &id) const
 {
-    return m_devices.keys().contains(id) ? m_devices[id] : nullptr;
+    return m_devices.value(id, nullptr);
 }
 
 void Adapter::setId(const QString &id)
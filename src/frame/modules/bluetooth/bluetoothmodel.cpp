@@ -68,7 +68,7 @@ QMap<QString, const Adapter *> BluetoothModel::adapters() const
 
 const Adapter *BluetoothModel::adapterById(const QString &id)
 {
-    return m_adapters.keys().contains(id) ? m_adapters[id] : nullptr;
+    return m_adapters.value(id, nullptr);
 }
 
 /**
@@ -28,16 +28,32 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QSet>
 #include <QTimer>
 
 namespace dcc {
 namespace bluetooth {
 
+const QString BluetoothService("com.deepin.daemon.Bluetooth");
+
+QStringList BluetoothWorker::sessionServices()
+{
+    return { BluetoothService };
+}
+
 BluetoothWorker::BluetoothWorker(BluetoothModel *model, bool sync) :
     QObject(),
-    m_bluetoothInter(new DBusBluetooth("com.deepin.daemon.Bluetooth", "/com/deepin/daemon/Bluetooth", QDBusConnection::sessionBus(), this)),
-    m_model(model)
+    m_bluetoothInter(new DBusBluetooth(BluetoothService, "/com/deepin/daemon/Bluetooth", QDBusConnection::sessionBus(), this)),
+    m_model(model),
+    m_syncTimer(new QTimer(this)),
+    m_deviceTable(new DeviceTable(this))
 {
+    connect(m_deviceTable, &DeviceTable::devicePropertiesChanged, this, &BluetoothWorker::applyDeviceProperties);
+
+    // 设备列表依靠增删信号维护,定时与后端完整核对一次,防止信号丢失导致不一致
+    m_syncTimer->setInterval(60 * 1000);
+    connect(m_syncTimer, &QTimer::timeout, this, &BluetoothWorker::syncAllDevices);
+
     connect(m_bluetoothInter, &DBusBluetooth::AdapterAdded, this, &BluetoothWorker::addAdapter);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterRemoved, this, &BluetoothWorker::removeAdapter);
     connect(m_bluetoothInter, &DBusBluetooth::AdapterPropertiesChanged, this, &BluetoothWorker::onAdapterPropertiesChanged);
@@ -125,10 +141,12 @@ void BluetoothWorker::activate()
     m_bluetoothInter->ClearUnpairedDevice();
 
     refresh();
+    m_syncTimer->start();
 }
 
 void BluetoothWorker::deactivate()
 {
+    m_syncTimer->stop();
     blockDBusSignals(true);
 }
 
@@ -240,45 +258,49 @@ void BluetoothWorker::inflateAdapter(Adapter *adapter, const QJsonObject &adapte
     adapter->setPowered(powered, discovering);
 
     Q_EMIT deviceEnableChanged();
+}
 
+void BluetoothWorker::syncDevices(Adapter *adapter)
+{
     QPointer<Adapter> adapterPointer(adapter);
 
-    QDBusObjectPath dPath(path);
+    QDBusObjectPath dPath(adapter->id());
     QDBusPendingCall call = m_bluetoothInter->GetDevices(dPath);
     QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
-    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, adapterPointer, call] {
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, adapterPointer, call, watcher] {
+        watcher->deleteLater();
+
         if (!adapterPointer)
             return;
 
         Adapter *adapter = adapterPointer.data();
 
         if (!call.isError())  {
-            QStringList tmpList;
+            QSet<QString> ids;
 
             QDBusReply<QString> reply = call.reply();
             const QString replyStr = reply.value();
             QJsonDocument doc = QJsonDocument::fromJson(replyStr.toUtf8());
             QJsonArray arr = doc.array();
             for (QJsonValue val : arr) {
-                const QString id = val.toObject()["Path"].toString();
-                const QString name = val.toObject()["Name"].toString();
+                const QJsonObject obj = val.toObject();
+                const QString id = obj["Path"].toString();
 
-                const Device *result = adapter->deviceById(id);
-                Device *device = const_cast<Device*>(result);
+                Device *device = m_deviceTable->device(id);
                 if (!device) {
                     device = new Device(adapter);
+                    inflateDevice(device, obj);
+                    addDeviceToAdapter(adapter, device);
                 } else {
-                    if (device->name() != name) adapter->removeDevice(device->id());
+                    applyDeviceProperties(device, obj);
                 }
-                inflateDevice(device, val.toObject());
-                adapter->addDevice(device);
 
-                tmpList << id;
+                ids.insert(id);
             }
 
             for (const Device *device : adapter->devices()) {
-                if (!tmpList.contains(device->id())) {
-                    adapter->removeDevice(device->id());
+                if (!ids.contains(device->id())) {
+                    removeDeviceFromAdapter(adapter, device->id());
 
                     Device *target = const_cast<Device*>(device);
                     if (target) target->deleteLater();
@@ -290,6 +312,12 @@ void BluetoothWorker::inflateAdapter(Adapter *adapter, const QJsonObject &adapte
     });
 }
 
+void BluetoothWorker::syncAllDevices()
+{
+    for (const Adapter *adapter : m_model->adapters())
+        syncDevices(const_cast<Adapter*>(adapter));
+}
+
 void BluetoothWorker::inflateDevice(Device *device, const QJsonObject &deviceObj)
 {
     const QString id = deviceObj["Path"].toString();
@@ -316,6 +344,7 @@ void BluetoothWorker::onAdapterPropertiesChanged(const QString &json)
     const QJsonObject obj = doc.object();
     const QString id = obj["Path"].toString();
 
+    // 只更新适配器自身的属性,设备列表的变化由 DeviceAdded/DeviceRemoved 通知
     Adapter *adapter = const_cast<Adapter*>(m_model->adapterById(id));
     if (adapter) inflateAdapter(adapter, obj);
 }
@@ -323,24 +352,43 @@ void BluetoothWorker::onAdapterPropertiesChanged(const QString &json)
 void BluetoothWorker::onDevicePropertiesChanged(const QString &json)
 {
     const QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
-    const QJsonObject obj = doc.object();
-    const QString id = obj["Path"].toString();
-    const QString name = obj["Name"].toString();
-    for (const Adapter *adapter : m_model->adapters()) {
-        Adapter *adapterPointer = const_cast<Adapter*>(adapter);
-        Device *device = const_cast<Device*>(adapter->deviceById(id));
-        if (device) {
-            if (device->name() == name) {
-                inflateDevice(device, obj);
-            } else {
-                if (!adapterPointer)
-                    return;
-                adapterPointer->removeDevice(device->id());
-                inflateDevice(device, obj);
-                adapterPointer->addDevice(device);
-            }
-        }
+
+    // 扫描时 RSSI 和状态变化非常频繁,合并到下一帧统一更新
+    m_deviceTable->enqueue(doc.object());
+}
+
+void BluetoothWorker::applyDeviceProperties(Device *device, const QJsonObject &properties)
+{
+    const QString name = properties["Name"].toString();
+
+    // 列表按设备有没有名称过滤,只有名称在有无之间变化时才需要重新添加,
+    // 其他情况在原位置更新,不重置界面上的条目
+    if (device->name().isEmpty() == name.isEmpty()) {
+        inflateDevice(device, properties);
+        return;
+    }
+
+    Adapter *adapter = qobject_cast<Adapter *>(device->parent());
+    if (!adapter) {
+        inflateDevice(device, properties);
+        return;
     }
+
+    adapter->removeDevice(device->id());
+    inflateDevice(device, properties);
+    adapter->addDevice(device);
+}
+
+void BluetoothWorker::addDeviceToAdapter(Adapter *adapter, Device *device)
+{
+    m_deviceTable->insert(device);
+    adapter->addDevice(device);
+}
+
+void BluetoothWorker::removeDeviceFromAdapter(Adapter *adapter, const QString &id)
+{
+    m_deviceTable->remove(id);
+    adapter->removeDevice(id);
 }
 
 void BluetoothWorker::addAdapter(const QString &json)
@@ -348,9 +396,17 @@ void BluetoothWorker::addAdapter(const QString &json)
     QJsonDocument doc = QJsonDocument::fromJson(json.toUtf8());
     QJsonObject obj = doc.object();
 
-    Adapter *adapter = new Adapter(m_model);
-    inflateAdapter(adapter, obj);
-    m_model->addAdapter(adapter);
+    const Adapter *result = m_model->adapterById(obj["Path"].toString());
+    Adapter *adapter = const_cast<Adapter*>(result);
+    if (adapter) {
+        inflateAdapter(adapter, obj);
+    } else {
+        adapter = new Adapter(m_model);
+        inflateAdapter(adapter, obj);
+        m_model->addAdapter(adapter);
+    }
+
+    syncDevices(adapter);
 }
 
 void BluetoothWorker::removeAdapter(const QString &json)
@@ -362,6 +418,9 @@ void BluetoothWorker::removeAdapter(const QString &json)
     const Adapter *result = m_model->removeAdapater(id);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
+        for (const QString &deviceId : adapter->devicesId())
+            m_deviceTable->remove(deviceId);
+
         adapter->deleteLater();
     }
 }
@@ -376,11 +435,10 @@ void BluetoothWorker::addDevice(const QString &json)
     const Adapter *result = m_model->adapterById(adapterId);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
-        const Device *result1 = adapter->deviceById(id);
-        Device *device = const_cast<Device*>(result1);
+        Device *device = m_deviceTable->device(id);
         if (!device) device = new Device(adapter);
         inflateDevice(device, obj);
-        adapter->addDevice(device);
+        addDeviceToAdapter(adapter, device);
     }
 }
 
@@ -394,7 +452,7 @@ void BluetoothWorker::removeDevice(const QString &json)
     const Adapter *result = m_model->adapterById(adapterId);
     Adapter *adapter = const_cast<Adapter*>(result);
     if (adapter) {
-        adapter->removeDevice(id);
+        removeDeviceFromAdapter(adapter, id);
     }
 }
 
@@ -407,15 +465,25 @@ void BluetoothWorker::refresh(bool beFirst)
         QJsonDocument doc = QJsonDocument::fromJson(replyStr.toUtf8());
         QJsonArray arr = doc.array();
         for (QJsonValue val : arr) {
-            Adapter *adapter = new Adapter(m_model);
-            inflateAdapter(adapter, val.toObject());
+            const QJsonObject obj = val.toObject();
+
+            // 已有的适配器在原对象上更新,保持界面上的设备不变
+            const Adapter *result = m_model->adapterById(obj["Path"].toString());
+            Adapter *adapter = const_cast<Adapter*>(result);
+            if (adapter) {
+                inflateAdapter(adapter, obj);
+            } else {
+                adapter = new Adapter(m_model);
+                inflateAdapter(adapter, obj);
+                m_model->addAdapter(adapter);
+            }
 
-            m_model->addAdapter(adapter);
+            syncDevices(adapter);
         }
     };
 
     if (beFirst) {
-        QDBusInterface *inter = new QDBusInterface("com.deepin.daemon.Bluetooth",
+        QDBusInterface *inter = new QDBusInterface(BluetoothService,
                                                    "/com/deepin/daemon/Bluetooth",
                                                    "com.deepin.daemon.Bluetooth",
                                                    QDBusConnection::sessionBus());
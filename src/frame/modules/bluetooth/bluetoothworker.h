@@ -27,11 +27,13 @@
 #define DCC_BLUETOOTH_BLUETOOTHWORKER_H
 
 #include <QObject>
+#include <QTimer>
 
 #include <com_deepin_daemon_bluetooth.h>
 
 #include "modules/moduleworker.h"
 #include "bluetoothmodel.h"
+#include "devicetable.h"
 #include "pincodedialog.h"
 
 using  DBusBluetooth = com::deepin::daemon::Bluetooth;
@@ -44,6 +46,8 @@ class BluetoothWorker : public QObject, public ModuleWorker
     Q_OBJECT
 public:
     static BluetoothWorker &Instance(bool sync = false);
+    // 构造时访问的会话总线服务
+    static QStringList sessionServices();
 
     BluetoothModel *model() { return m_model; }
 
@@ -73,10 +77,14 @@ public Q_SLOTS:
 private:
     void inflateAdapter(Adapter *adapter, const QJsonObject &adapterObj);
     void inflateDevice(Device *device, const QJsonObject &deviceObj);
+    void syncDevices(Adapter *adapter);
+    void addDeviceToAdapter(Adapter *adapter, Device *device);
+    void removeDeviceFromAdapter(Adapter *adapter, const QString &id);
 
 private Q_SLOTS:
     void onAdapterPropertiesChanged(const QString &json);
     void onDevicePropertiesChanged(const QString &json);
+    void applyDeviceProperties(Device *device, const QJsonObject &properties);
 
     void addAdapter(const QString &json);
     void removeAdapter(const QString &json);
@@ -85,6 +93,7 @@ private Q_SLOTS:
     void removeDevice(const QString &json);
 
     void refresh(bool beFirst = false);
+    void syncAllDevices();
 
 private:
     explicit BluetoothWorker(BluetoothModel *model, bool sync = false);
@@ -95,6 +104,9 @@ private:
     DBusBluetooth *m_bluetoothInter;
     BluetoothModel *m_model;
     QMap<QDBusObjectPath, PinCodeDialog*> m_dialogs;
+    QTimer *m_syncTimer;
+    // 所有适配器的设备按路径索引,设备属性的变化按帧合并
+    DeviceTable *m_deviceTable;
 };
 
 } // namespace bluetooth
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "devicetable.h"
+#include "device.h"
+
+#include <QTimer>
+
+namespace dcc {
+namespace bluetooth {
+
+DeviceTable::DeviceTable(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    m_timer->setSingleShot(true);
+    m_timer->setInterval(16);
+
+    connect(m_timer, &QTimer::timeout, this, &DeviceTable::flush);
+}
+
+void DeviceTable::insert(Device *device)
+{
+    m_devices.insert(device->id(), device);
+    // 新加入的设备已经是最新的属性,丢弃之前排队的变化
+    m_pending.remove(device->id());
+}
+
+void DeviceTable::remove(const QString &id)
+{
+    m_devices.remove(id);
+    m_pending.remove(id);
+}
+
+void DeviceTable::clear()
+{
+    m_devices.clear();
+    m_pending.clear();
+    m_pendingOrder.clear();
+    m_timer->stop();
+}
+
+int DeviceTable::interval() const
+{
+    return m_timer->interval();
+}
+
+void DeviceTable::setInterval(int msec)
+{
+    m_timer->setInterval(msec);
+}
+
+void DeviceTable::enqueue(const QJsonObject &properties)
+{
+    const QString id = properties["Path"].toString();
+    if (!m_devices.contains(id))
+        return;
+
+    // 后端每次发送的都是设备的全部属性,后到的直接覆盖
+    auto it = m_pending.find(id);
+    if (it == m_pending.end()) {
+        m_pending.insert(id, properties);
+        m_pendingOrder << id;
+    } else {
+        it.value() = properties;
+    }
+
+    if (!m_timer->isActive())
+        m_timer->start();
+}
+
+void DeviceTable::flush()
+{
+    m_timer->stop();
+
+    QList<QString> order;
+    order.swap(m_pendingOrder);
+    QHash<QString, QJsonObject> pending;
+    pending.swap(m_pending);
+
+    for (const QString &id : order) {
+        // 排队后被移除又重新排队的设备在 order 中出现两次,只通知一次
+        if (!pending.contains(id))
+            continue;
+
+        const QJsonObject properties = pending.take(id);
+        // 通知过程中设备可能已被移除
+        Device *target = m_devices.value(id, nullptr);
+        if (target)
+            Q_EMIT devicePropertiesChanged(target, properties);
+    }
+}
+
+} // namespace bluetooth
+} // namespace dcc
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2016 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DCC_BLUETOOTH_DEVICETABLE_H
+#define DCC_BLUETOOTH_DEVICETABLE_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QJsonObject>
+
+class QTimer;
+
+namespace dcc {
+namespace bluetooth {
+
+class Device;
+
+// 所有适配器的设备按路径索引,并把设备属性的变化按帧合并:
+// 一帧内同一设备的多次变化只保留最后一次,到时统一通知一次
+class DeviceTable : public QObject
+{
+    Q_OBJECT
+public:
+    explicit DeviceTable(QObject *parent = nullptr);
+
+    Device *device(const QString &id) const { return m_devices.value(id, nullptr); }
+    int count() const { return m_devices.size(); }
+
+    void insert(Device *device);
+    void remove(const QString &id);
+    void clear();
+
+    // 合并的时间间隔,默认为一帧
+    int interval() const;
+    void setInterval(int msec);
+
+    void enqueue(const QJsonObject &properties);
+    int pendingCount() const { return m_pending.size(); }
+
+public Q_SLOTS:
+    void flush();
+
+Q_SIGNALS:
+    void devicePropertiesChanged(Device *device, const QJsonObject &properties) const;
+
+private:
+    QHash<QString, Device *> m_devices;
+    // 按到达顺序通知,同一设备只占一个位置
+    QList<QString> m_pendingOrder;
+    QHash<QString, QJsonObject> m_pending;
+    QTimer *m_timer;
+};
+
+} // namespace bluetooth
+} // namespace dcc
+
+#endif // DCC_BLUETOOTH_DEVICETABLE_H
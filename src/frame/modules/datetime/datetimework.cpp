@@ -24,6 +24,7 @@
  */
 
 #include "datetimework.h"
+#include "timezone_dialog/timezone.h"
 #include <QDebug>
 
 #include <QtConcurrent>
@@ -99,6 +100,13 @@ void DatetimeWork::activate()
 #ifndef DCC_DISABLE_TIMEZONE
     m_model->setSystemTimeZoneId(m_timedateInter->timezone());
     onTimezoneListChanged(m_timedateInter->userTimezones());
+
+    // 提前在后台读取时区数据库并生成本地化的时区名,显示时区列表和时区选择框时直接查表
+    const QString locale = QLocale::system().name();
+    QtConcurrent::run([locale] {
+        installer::GetZoneDatabase();
+        installer::GetLocalTimezoneNames(locale);
+    });
 #endif
 }
 
@@ -36,7 +36,12 @@
 #include <libintl.h>
 #include <locale.h>
 #include <time.h>
+#include <QDateTime>
 #include <QDebug>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QTimeZone>
 
 #include "consts.h"
 #include "file_util.h"
@@ -75,23 +80,48 @@ double ConvertPos(const QString& pos, int digits) {
   }
 }
 
-}  // namespace
+// Translate |timezone| with the locale of current thread.
+QString TranslateTimezone(const QString& timezone) {
+  const QString local_name(QString::fromUtf8(
+      dgettext(kTimezoneDomain, timezone.toUtf8().constData())));
+  int index = local_name.lastIndexOf('/');
+  if (index == -1) {
+    // Some translations of locale name contains non-standard char.
+    index = local_name.lastIndexOf("∕");
+  }
 
-bool ZoneInfoDistanceComp(const ZoneInfo& a, const ZoneInfo& b) {
-  return a.distance < b.distance;
+  return (index > -1) ? local_name.mid(index + 1) : local_name;
 }
 
-QDebug& operator<<(QDebug& debug, const ZoneInfo& info) {
-  debug << "ZoneInfo {"
-        << "cc:" << info.country
-        << "tz:" << info.timezone
-        << "lat:" << info.latitude
-        << "lng:" << info.longitude
-        << "}";
-  return debug;
+// Translate all of |timezones| in |locale|.
+TimezoneNameMap BuildTimezoneNames(const QList<QByteArray>& timezones,
+                                   const QString& locale) {
+  // Translations are always returned in UTF-8, whatever the process locale is.
+  (void) bind_textdomain_codeset(kTimezoneDomain, "UTF-8");
+
+  // Switch locale of current thread only, instead of calling setlocale(),
+  // which changes locale of the whole process.
+  const locale_t new_locale = newlocale(LC_ALL_MASK,
+      QString(locale + ".UTF-8").toLatin1().constData(), static_cast<locale_t>(0));
+  const locale_t old_locale = new_locale ? uselocale(new_locale) : static_cast<locale_t>(0);
+
+  TimezoneNameMap names;
+  names.reserve(timezones.size());
+  for (const QByteArray& timezone : timezones) {
+    const QString name = QString::fromLatin1(timezone);
+    names.insert(name, TranslateTimezone(name));
+  }
+
+  if (new_locale) {
+    (void) uselocale(old_locale);
+    freelocale(new_locale);
+  }
+
+  return names;
 }
 
-ZoneInfoList GetZoneInfoList() {
+// Parse zone.tab file.
+ZoneInfoList ReadZoneInfoList() {
   ZoneInfoList list;
   const QString content(ReadFile(kZoneTabFile));
   for (const QString& line : content.split('\n')) {
@@ -116,6 +146,74 @@ ZoneInfoList GetZoneInfoList() {
   return list;
 }
 
+// Parse timezone alias file.
+TimezoneAliasMap ReadTimezoneAliasMap() {
+  TimezoneAliasMap map;
+
+  const QString content = ReadFile(kTimezoneAliasFile);
+  for (const QString& line : content.split('\n')) {
+    if (!line.isEmpty()) {
+      const QStringList parts = line.split(':');
+      Q_ASSERT(parts.length() == 2);
+      if (parts.length() == 2) {
+        map.insert(parts.at(0), parts.at(1));
+      }
+    }
+  }
+
+  return map;
+}
+
+// Modification time of |filepath|, or invalid time if it does not exist.
+QDateTime GetModifiedTime(const QString& filepath) {
+  return QFileInfo(filepath).lastModified();
+}
+
+ZoneDatabasePtr LoadZoneDatabase() {
+  QSharedPointer<ZoneDatabase> database(new ZoneDatabase);
+  database->zones = ReadZoneInfoList();
+  database->aliases = ReadTimezoneAliasMap();
+
+  database->zone_indexes.reserve(database->zones.length());
+  for (int index = 0; index < database->zones.length(); index++) {
+    const ZoneInfo& zone = database->zones.at(index);
+    database->zone_indexes.insert(zone.timezone, index);
+    if (!database->country_indexes.contains(zone.country)) {
+      database->country_indexes.insert(zone.country, index);
+    }
+  }
+
+  return database;
+}
+
+QMutex g_catalogue_mutex;
+QHash<QString, TimezoneNameMap> g_catalogues;
+
+QMutex g_database_mutex;
+ZoneDatabasePtr g_database;
+QDateTime g_zone_tab_modified;
+QDateTime g_alias_modified;
+
+}  // namespace
+
+bool ZoneInfoDistanceComp(const ZoneInfo& a, const ZoneInfo& b) {
+  return a.distance < b.distance;
+}
+
+QDebug& operator<<(QDebug& debug, const ZoneInfo& info) {
+  debug << "ZoneInfo {"
+        << "cc:" << info.country
+        << "tz:" << info.timezone
+        << "lat:" << info.latitude
+        << "lng:" << info.longitude
+        << "}";
+  return debug;
+}
+
+ZoneInfoList GetZoneInfoList() {
+  return GetZoneDatabase()->zones;
+}
+
 int GetZoneInfoByCountry(const ZoneInfoList& list,
                          const QString& country) {
   int index = -1;
@@ -150,37 +248,43 @@ QString GetTimezoneName(const QString& timezone) {
 }
 
 QString GetLocalTimezoneName(const QString& timezone, const QString& locale) {
-  // Set locale first.
-  (void) setlocale(LC_ALL, QString(locale + ".UTF-8").toStdString().c_str());
-  const QString local_name(dgettext(kTimezoneDomain,
-                                    timezone.toStdString().c_str()));
-  int index = local_name.lastIndexOf('/');
-  if (index == -1) {
-    // Some translations of locale name contains non-standard char.
-    index = local_name.lastIndexOf("∕");
+  const TimezoneNameMap names = GetLocalTimezoneNames(locale);
+  const auto it = names.constFind(timezone);
+  if (it != names.cend()) {
+    return it.value();
   }
 
-  // Reset locale.
-  (void) setlocale(LC_ALL, kDefaultLocale);
+  // Not in the catalogue, like an alias removed from tzdata.
+  return BuildTimezoneNames({timezone.toLatin1()}, locale).value(timezone);
+}
 
-  return (index > -1) ? local_name.mid(index + 1) : local_name;
+TimezoneNameMap GetLocalTimezoneNames(const QString& locale) {
+  QMutexLocker locker(&g_catalogue_mutex);
+  auto it = g_catalogues.constFind(locale);
+  if (it == g_catalogues.cend()) {
+    it = g_catalogues.insert(locale, BuildTimezoneNames(
+        QTimeZone::availableTimeZoneIds(), locale));
+  }
+  return it.value();
 }
 
 TimezoneAliasMap GetTimezoneAliasMap() {
-  TimezoneAliasMap map;
+  return GetZoneDatabase()->aliases;
+}
 
-  const QString content = ReadFile(kTimezoneAliasFile);
-  for (const QString& line : content.split('\n')) {
-    if (!line.isEmpty()) {
-      const QStringList parts = line.split(':');
-      Q_ASSERT(parts.length() == 2);
-      if (parts.length() == 2) {
-        map.insert(parts.at(0), parts.at(1));
-      }
-    }
+ZoneDatabasePtr GetZoneDatabase() {
+  const QDateTime zone_tab_modified = GetModifiedTime(kZoneTabFile);
+  const QDateTime alias_modified = GetModifiedTime(kTimezoneAliasFile);
+
+  QMutexLocker locker(&g_database_mutex);
+  if (!g_database || zone_tab_modified != g_zone_tab_modified ||
+      alias_modified != g_alias_modified) {
+    // tzdata is updated, or read for the first time.
+    g_database = LoadZoneDatabase();
+    g_zone_tab_modified = zone_tab_modified;
+    g_alias_modified = alias_modified;
   }
-
-  return map;
+  return g_database;
 }
 
 bool IsValidTimezone(const QString& timezone) {
@@ -32,6 +32,7 @@
 
 #include <QList>
 #include <QHash>
+#include <QSharedPointer>
 
 namespace installer {
 
@@ -52,10 +53,12 @@ QDebug& operator<<(QDebug& debug, const ZoneInfo& info);
 typedef QList<ZoneInfo> ZoneInfoList;
 
 // Read available timezone info in zone.tab file.
+// Same as zones of GetZoneDatabase().
 ZoneInfoList GetZoneInfoList();
 
 // Find ZoneInfo based on |country| or |timezone|.
 // Returns -1 if not found.
+// These are linear scans, use indexes of ZoneDatabase if possible.
 int GetZoneInfoByCountry(const ZoneInfoList& list, const QString& country);
 int GetZoneInfoByZone(const ZoneInfoList& list, const QString& timezone);
 
@@ -67,13 +70,42 @@ QString GetTimezoneName(const QString& timezone);
 
 // Returns local name of timezone, excluding continent name.
 // |locale| is desired locale name.
+// Names are looked up in the catalogue of |locale|, see GetLocalTimezoneNames().
 QString GetLocalTimezoneName(const QString& timezone, const QString& locale);
 
+// A map between timezone and its local name, excluding continent name.
+typedef QHash<QString, QString> TimezoneNameMap;
+
+// Returns local names of all available timezones in |locale|.
+// The catalogue is built once per locale with a thread-local locale and then
+// shared, so it is safe to call from any thread.
+TimezoneNameMap GetLocalTimezoneNames(const QString& locale);
+
 // A map between old name of timezone and current name.
 // e.g. Asia/Chongqing -> Asia/Shanghai
 typedef QHash<QString, QString> TimezoneAliasMap;
 TimezoneAliasMap GetTimezoneAliasMap();
 
+// Zone info and timezone aliases parsed from tzdata.
+struct ZoneDatabase {
+  // Same order as zone.tab file.
+  ZoneInfoList zones;
+
+  // Index in |zones| of each timezone.
+  QHash<QString, int> zone_indexes;
+
+  // Index in |zones| of the first timezone of each country.
+  QHash<QString, int> country_indexes;
+
+  TimezoneAliasMap aliases;
+};
+typedef QSharedPointer<const ZoneDatabase> ZoneDatabasePtr;
+
+// Returns zone database shared across the process. It is loaded on first
+// call, and loaded again only if zone.tab or alias file is modified.
+// It is safe to call from any thread.
+ZoneDatabasePtr GetZoneDatabase();
+
 // Validate |timezone|.
 bool IsValidTimezone(const QString& timezone);
 
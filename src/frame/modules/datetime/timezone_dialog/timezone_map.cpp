@@ -67,7 +67,9 @@ QPoint ZoneInfoToPosition(const ZoneInfo& zone, int map_width, int map_height) {
 TimezoneMap::TimezoneMap(QWidget* parent)
     : QFrame(parent),
       current_zone_(),
-      total_zones_(GetZoneInfoList()),
+      database_(GetZoneDatabase()),
+      total_zones_(database_->zones),
+      zone_index_(total_zones_),
       nearest_zones_() {
   this->setObjectName("timezone_map");
 
@@ -89,7 +91,7 @@ const QString TimezoneMap::getTimezone() const {
 bool TimezoneMap::setTimezone(const QString &timezone)
 {
     nearest_zones_.clear();
-    const int index = GetZoneInfoByZone(total_zones_, timezone);
+    const int index = database_->zone_indexes.value(timezone, -1);
     if (index > -1) {
         // 找到时区并标记到地图上
         current_zone_ = total_zones_.at(index);
@@ -107,10 +109,13 @@ bool TimezoneMap::setTimezone(const QString &timezone)
 void TimezoneMap::mousePressEvent(QMouseEvent* event) {
   if (event->button() == Qt::LeftButton) {
     // Get nearest zones around mouse.
-    nearest_zones_ = GetNearestZones(total_zones_, kDistanceThreshold,
-                                     event->x(), event->y(),
-                                     this->width(), this->height());
+    zone_index_.resize(this->width(), this->height());
+    nearest_zones_ = zone_index_.nearestZones(kDistanceThreshold,
+                                              event->x(), event->y());
     qDebug() << nearest_zones_;
+    if (nearest_zones_.isEmpty()) {
+      return;
+    }
     current_zone_ = nearest_zones_.first();
     if (nearest_zones_.length() == 1) {
         // 单个时区
@@ -136,6 +141,8 @@ void TimezoneMap::resizeEvent(QResizeEvent* event) {
       background_label->setPixmap(timezone_pixmap.scaled(event->size() * devicePixelRatioF(), Qt::KeepAspectRatio, Qt::FastTransformation));
   }
 
+  zone_index_.resize(event->size().width(), event->size().height());
+
   QWidget::resizeEvent(event);
 }
 
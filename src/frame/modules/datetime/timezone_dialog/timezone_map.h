@@ -37,6 +37,7 @@ class QResizeEvent;
 class QStringListModel;
 
 #include "timezone.h"
+#include "timezone_map_util.h"
 
 namespace installer {
 
@@ -80,9 +81,15 @@ class TimezoneMap : public QFrame {
   // Currently selected/marked timezone.
   ZoneInfo current_zone_;
 
+  // Zone info and indexes found in system.
+  const ZoneDatabasePtr database_;
+
   // A list of zone info found in system.
   const ZoneInfoList total_zones_;
 
+  // Positions of |total_zones_| on current map, to find zones near cursor.
+  ZoneIndex zone_index_;
+
   // A list of zone info which are near enough to current cursor position.
   ZoneInfoList nearest_zones_;
 
@@ -30,6 +30,8 @@
 #include "timezone_map_util.h"
 
 #include <math.h>
+#include <limits>
+#include <algorithm>
 
 namespace installer {
 
@@ -40,6 +42,9 @@ double radians(double degrees) {
   return (degrees / 360.0) * M_PI * 2;
 }
 
+// Width and height of cells in ZoneIndex, in pixels.
+const double kCellSize = 16.0;
+
 }  // namespace
 
 double ConvertLatitudeToY(double latitude) {
@@ -92,4 +97,188 @@ ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
   return zones;
 }
 
+ZoneIndex::ZoneIndex(const ZoneInfoList& zones)
+    : zones_(zones),
+      projections_(),
+      positions_(),
+      cell_starts_(),
+      cell_zones_(),
+      origin_() {
+  // Projection of zones does not depend on size of map, so do it only once.
+  projections_.reserve(zones_.length());
+  for (const ZoneInfo& zone : zones_) {
+    projections_.append(QPointF(ConvertLongitudeToX(zone.longitude),
+                                ConvertLatitudeToY(zone.latitude)));
+  }
+}
+
+void ZoneIndex::resize(int map_width, int map_height) {
+  if (map_width == map_width_ && map_height == map_height_) {
+    return;
+  }
+  map_width_ = map_width;
+  map_height_ = map_height;
+
+  positions_.resize(projections_.length());
+  cell_starts_.clear();
+  cell_zones_.clear();
+  columns_ = 0;
+  rows_ = 0;
+  if (projections_.isEmpty()) {
+    return;
+  }
+
+  double left = std::numeric_limits<double>::max();
+  double top = std::numeric_limits<double>::max();
+  double right = -std::numeric_limits<double>::max();
+  double bottom = -std::numeric_limits<double>::max();
+  for (int index = 0; index < projections_.length(); index++) {
+    const QPointF& projection = projections_.at(index);
+    const QPointF point(projection.x() * map_width,
+                        projection.y() * map_height);
+    positions_[index] = point;
+    left = qMin(left, point.x());
+    top = qMin(top, point.y());
+    right = qMax(right, point.x());
+    bottom = qMax(bottom, point.y());
+  }
+
+  // Cells only cover bounding rect of zones, points out of it are clamped
+  // to the border cells.
+  origin_ = QPointF(left, top);
+  columns_ = int((right - left) / kCellSize) + 1;
+  rows_ = int((bottom - top) / kCellSize) + 1;
+
+  // Counting sort zones into cells.
+  QVector<int> cells(positions_.length());
+  cell_starts_.fill(0, columns_ * rows_ + 1);
+  for (int index = 0; index < positions_.length(); index++) {
+    const QPointF& point = positions_.at(index);
+    cells[index] = cellOf(point.y(), origin_.y(), rows_) * columns_ +
+                   cellOf(point.x(), origin_.x(), columns_);
+    cell_starts_[cells.at(index) + 1]++;
+  }
+  for (int cell = 0; cell < columns_ * rows_; cell++) {
+    cell_starts_[cell + 1] += cell_starts_.at(cell);
+  }
+  QVector<int> offsets(cell_starts_);
+  cell_zones_.resize(positions_.length());
+  for (int index = 0; index < positions_.length(); index++) {
+    cell_zones_[offsets[cells.at(index)]++] = index;
+  }
+}
+
+ZoneInfoList ZoneIndex::nearestZones(double threshold, int x, int y) const {
+  ZoneInfoList zones;
+  if (positions_.isEmpty()) {
+    return zones;
+  }
+
+  // |threshold| is compared with squared distance.
+  const double radius = sqrt(qMax(threshold, 0.0));
+  QVector<int> candidates;
+  collect(cellOf(x - radius, origin_.x(), columns_),
+          cellOf(y - radius, origin_.y(), rows_),
+          cellOf(x + radius, origin_.x(), columns_),
+          cellOf(y + radius, origin_.y(), rows_),
+          candidates);
+
+  // Keep the same order as |zones_|.
+  std::sort(candidates.begin(), candidates.end());
+  for (int index : candidates) {
+    const double dx = positions_.at(index).x() - x;
+    const double dy = positions_.at(index).y() - y;
+    if (dx * dx + dy * dy <= threshold) {
+      zones.append(zones_.at(index));
+    }
+  }
+
+  // Get the nearest zone.
+  if (zones.isEmpty()) {
+    zones.append(zones_.at(this->nearestZone(x, y)));
+  }
+
+  return zones;
+}
+
+int ZoneIndex::nearestZone(int x, int y) const {
+  if (positions_.isEmpty()) {
+    return -1;
+  }
+
+  const int column = cellOf(x, origin_.x(), columns_);
+  const int row = cellOf(y, origin_.y(), rows_);
+  int nearest_zone_index = -1;
+  double minimum_distance = std::numeric_limits<double>::max();
+
+  // Search rings of cells around (x, y) from inside to outside.
+  QVector<int> candidates;
+  for (int ring = 0; ; ring++) {
+    const int left = column - ring;
+    const int top = row - ring;
+    const int right = column + ring;
+    const int bottom = row + ring;
+
+    candidates.clear();
+    collect(left, top, right, top, candidates);
+    if (bottom != top) {
+      collect(left, bottom, right, bottom, candidates);
+    }
+    if (bottom - top > 1) {
+      collect(left, top + 1, left, bottom - 1, candidates);
+      if (right != left) {
+        collect(right, top + 1, right, bottom - 1, candidates);
+      }
+    }
+
+    for (int index : candidates) {
+      const double dx = positions_.at(index).x() - x;
+      const double dy = positions_.at(index).y() - y;
+      const double distance = dx * dx + dy * dy;
+      if (distance < minimum_distance ||
+          (distance == minimum_distance && index < nearest_zone_index)) {
+        minimum_distance = distance;
+        nearest_zone_index = index;
+      }
+    }
+
+    // All cells are searched.
+    if (left <= 0 && top <= 0 && right >= columns_ - 1 && bottom >= rows_ - 1) {
+      break;
+    }
+
+    // Zones in outer rings are at least |ring| cells away.
+    const double bound = ring * kCellSize;
+    if (nearest_zone_index > -1 && bound * bound > minimum_distance) {
+      break;
+    }
+  }
+
+  return nearest_zone_index;
+}
+
+int ZoneIndex::cellOf(double value, double origin, int count) const {
+  const double cell = floor((value - origin) / kCellSize);
+  if (cell < 0) {
+    return 0;
+  }
+  return (cell < count) ? int(cell) : count - 1;
+}
+
+void ZoneIndex::collect(int left, int top, int right, int bottom,
+                        QVector<int>& result) const {
+  left = qMax(left, 0);
+  top = qMax(top, 0);
+  right = qMin(right, columns_ - 1);
+  bottom = qMin(bottom, rows_ - 1);
+  for (int row = top; row <= bottom; row++) {
+    for (int column = left; column <= right; column++) {
+      const int cell = row * columns_ + column;
+      for (int i = cell_starts_.at(cell); i < cell_starts_.at(cell + 1); i++) {
+        result.append(cell_zones_.at(i));
+      }
+    }
+  }
+}
+
 }  // namespace installer
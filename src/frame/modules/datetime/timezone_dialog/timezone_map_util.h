@@ -30,6 +30,9 @@
 #ifndef INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
 #define INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
 
+#include <QPointF>
+#include <QVector>
+
 #include "timezone.h"
 
 namespace installer {
@@ -43,6 +46,53 @@ double ConvertLongitudeToX(double longitude);
 ZoneInfoList GetNearestZones(const ZoneInfoList& total_zones, double threshold,
                              int x, int y, int map_width, int map_height);
 
+// A grid index of zone positions on a world map, to find zones near to a
+// point without projecting all of the zones again on each query.
+class ZoneIndex {
+ public:
+  explicit ZoneIndex(const ZoneInfoList& zones);
+
+  // Update zone positions for a world map with size (map_width, map_height).
+  // Nothing is done if size of map is not changed.
+  void resize(int map_width, int map_height);
+
+  // Same as GetNearestZones(), |zones| is the list passed to constructor.
+  ZoneInfoList nearestZones(double threshold, int x, int y) const;
+
+  // Returns index of zone nearest to (x, y), or -1 if there is no zone.
+  int nearestZone(int x, int y) const;
+
+  // Returns position of zone at |index| on current map.
+  QPointF position(int index) const { return positions_.at(index); }
+
+ private:
+  // Returns index of cell which contains |value|, in range [0, count).
+  int cellOf(double value, double origin, int count) const;
+
+  // Append indexes of zones in cells of [left, right] x [top, bottom].
+  void collect(int left, int top, int right, int bottom,
+               QVector<int>& result) const;
+
+  ZoneInfoList zones_;
+
+  // Position of zones relative to map size, in range [0, 1] mostly.
+  QVector<QPointF> projections_;
+
+  // Position of zones on current map.
+  QVector<QPointF> positions_;
+
+  int map_width_ = -1;
+  int map_height_ = -1;
+
+  // Zones of cell i are cell_zones_[cell_starts_[i], cell_starts_[i + 1]),
+  // cells are laid out row by row over bounding rect of all zones.
+  QVector<int> cell_starts_;
+  QVector<int> cell_zones_;
+  QPointF origin_;
+  int columns_ = 0;
+  int rows_ = 0;
+};
+
 }  // namespace installer
 
 #endif  // INSTALLER_DELEGATES_TIMEZONE_MAP_UTIL_H
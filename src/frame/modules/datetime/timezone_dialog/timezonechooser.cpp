@@ -36,7 +36,6 @@
 #include <QComboBox>
 #include <QLineEdit>
 #include <QTimeZone>
-#include <QTimer>
 #include <QCompleter>
 #include <QKeyEvent>
 #include <QDebug>
@@ -46,6 +45,8 @@
 #include <QLabel>
 #include <QStyleFactory>
 #include <QAbstractItemView>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 
 DWIDGET_USE_NAMESPACE
 
@@ -55,6 +56,7 @@ using namespace dcc::datetime;
 TimeZoneChooser::TimeZoneChooser()
     : QFrame()
     , m_blurEffect(new DBlurEffectWidget(this))
+    , m_popup(nullptr)
     , m_map(new installer::TimezoneMap(this))
     , m_searchInput(new SearchInput)
     , m_title(new QLabel)
@@ -63,6 +65,7 @@ TimeZoneChooser::TimeZoneChooser()
     , m_currLangSelector(new LangSelector("com.deepin.daemon.LangSelector",
                                           "/com/deepin/daemon/LangSelector",
                                           QDBusConnection::sessionBus(), this))
+    , m_completer(nullptr)
 {
     setWindowFlags(Qt::Dialog);
     setAttribute(Qt::WA_TranslucentBackground);
@@ -146,15 +149,20 @@ TimeZoneChooser::TimeZoneChooser()
         m_confirmBtn->setEnabled(true);
     });
 
-    QTimer::singleShot(0, [this] {
+    // 本地化的时区名在后台线程中一次性生成,完成后再创建补全列表
+    QFutureWatcher<installer::TimezoneNameMap> *watcher = new QFutureWatcher<installer::TimezoneNameMap>(this);
+    connect(watcher, &QFutureWatcher<installer::TimezoneNameMap>::finished, this, [this, watcher] {
+        const installer::TimezoneNameMap names = watcher->result();
+        watcher->deleteLater();
+
         QStringList completions;
         QStringList completions_filter;
-        for (QString timezone : QTimeZone::availableTimeZoneIds()) {
+        for (const QByteArray &id : QTimeZone::availableTimeZoneIds()) {
+            const QString timezone = QString::fromLatin1(id);
             completions << timezone; // timezone as completion candidate.
 
             // localized timezone as completion candidate.
-            const QString locale = QLocale::system().name();
-            QString localizedTimezone = installer::GetLocalTimezoneName(timezone, locale);
+            const QString localizedTimezone = names.value(timezone, installer::GetTimezoneName(timezone));
             completions << localizedTimezone;
 
             m_completionCache[localizedTimezone] = timezone;
@@ -194,7 +202,12 @@ TimeZoneChooser::TimeZoneChooser()
 
         blurEffect->lower();
     });
+    watcher->setFuture(QtConcurrent::run(installer::GetLocalTimezoneNames, QLocale::system().name()));
+
     connect(m_searchInput, &SearchInput::returnPressed, [this] {
+        if (!m_popup)
+            return;
+
         QModelIndex index = m_popup->model()->index(0, 0);
         if (index.isValid()) {
             m_searchInput->setText(index.data().toString());
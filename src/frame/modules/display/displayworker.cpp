@@ -29,6 +29,10 @@
 
 #include <DApplicationHelper>
 
+#include <QDBusMessage>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
 #include <QDebug>
 
 using namespace dcc;
@@ -39,19 +43,28 @@ using namespace dcc::display;
 #define GSETTINGS_BRIGHTNESS_ENABLE "brightness-enable"
 
 const QString DisplayInterface("com.deepin.daemon.Display");
+const QString AppearanceService("com.deepin.daemon.Appearance");
+const QString PowerService("com.deepin.daemon.Power");
+const QString MonitorInterface("com.deepin.daemon.Display.Monitor");
+const QString PropertiesInterface("org.freedesktop.DBus.Properties");
 
 Q_DECLARE_METATYPE(QList<QDBusObjectPath>)
 
+QStringList DisplayWorker::sessionServices()
+{
+    return { DisplayInterface, AppearanceService, PowerService };
+}
+
 DisplayWorker::DisplayWorker(DisplayModel *model, QObject *parent, bool isSync)
     : QObject(parent)
     , m_model(model)
     , m_displayInter(DisplayInterface, "/com/deepin/daemon/Display", QDBusConnection::sessionBus(), this)
     , m_dccSettings(new QGSettings("com.deepin.dde.control-center", QByteArray(), this))
-    , m_appearanceInter(new AppearanceInter("com.deepin.daemon.Appearance",
+    , m_appearanceInter(new AppearanceInter(AppearanceService,
                                             "/com/deepin/daemon/Appearance",
                                             QDBusConnection::sessionBus(), this))
     , m_updateScale(false)
-    , m_powerInter(new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
+    , m_powerInter(new PowerInter(PowerService, "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
 {
     m_displayInter.setSync(isSync);
     m_appearanceInter->setSync(isSync);
@@ -145,16 +158,94 @@ void DisplayWorker::onMonitorListChanged(const QList<QDBusObjectPath> &mons)
 
     qDebug() << mons.size();
     QList<QString> pathList;
+    QStringList addedList;
     for (const auto &op : mons) {
         const QString path = op.path();
         pathList << path;
-        if (!ops.contains(path))
-            monitorAdded(path);
+        if (!ops.contains(path) && !m_pendingMonitors.contains(path))
+            addedList << path;
     }
 
     for (const auto &op : ops)
         if (!pathList.contains(op))
             monitorRemoved(op);
+
+    // 属性还未返回就被移除的显示器,返回后不再添加
+    for (const QString &path : m_pendingMonitors.toList())
+        if (!pathList.contains(path))
+            m_pendingMonitors.remove(path);
+
+    // 第一次获取显示器列表时等待属性返回,界面创建时可以直接使用显示器;热插拔时异步添加,不阻塞界面
+    requestMonitors(addedList, m_monitors.isEmpty());
+}
+
+void DisplayWorker::requestMonitors(const QStringList &paths, bool wait)
+{
+    // 每个显示器的属性通过一次 GetAll 获取,所有显示器的请求同时发出
+    QList<QDBusPendingCall> calls;
+    for (const QString &path : paths) {
+        m_pendingMonitors.insert(path);
+
+        QDBusMessage msg = QDBusMessage::createMethodCall(DisplayInterface, path, PropertiesInterface, "GetAll");
+        msg << MonitorInterface;
+        calls << QDBusConnection::sessionBus().asyncCall(msg);
+    }
+
+    if (!wait) {
+        for (int i = 0; i < paths.size(); ++i) {
+            const QString path = paths.at(i);
+            QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(calls.at(i), this);
+            connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path](QDBusPendingCallWatcher *w) {
+                onMonitorPropertiesLoaded(path, *w);
+                w->deleteLater();
+            });
+        }
+        return;
+    }
+
+    // 亮度能否调节需要用显示器名称查询,同样在所有属性返回后一起发出
+    QList<QPair<QString, QVariantMap>> loaded;
+    QList<QDBusPendingCall> brightnessCalls;
+    for (int i = 0; i < paths.size(); ++i) {
+        QDBusPendingReply<QVariantMap> reply = calls.at(i);
+        reply.waitForFinished();
+        if (reply.isError()) {
+            qDebug() << "get properties of" << paths.at(i) << "failed:" << reply.error().message();
+            m_pendingMonitors.remove(paths.at(i));
+            continue;
+        }
+
+        loaded << qMakePair(paths.at(i), reply.value());
+        brightnessCalls << m_displayDBusInter->asyncCall("CanSetBrightness", reply.value().value("Name").toString());
+    }
+
+    for (int i = 0; i < loaded.size(); ++i) {
+        QDBusPendingReply<bool> reply = brightnessCalls.at(i);
+        reply.waitForFinished();
+        monitorAdded(loaded.at(i).first, loaded.at(i).second, reply.value());
+    }
+}
+
+void DisplayWorker::onMonitorPropertiesLoaded(const QString &path, const QDBusPendingCall &call)
+{
+    if (!m_pendingMonitors.contains(path))
+        return;
+
+    QDBusPendingReply<QVariantMap> reply = call;
+    if (reply.isError()) {
+        qDebug() << "get properties of" << path << "failed:" << reply.error().message();
+        m_pendingMonitors.remove(path);
+        return;
+    }
+
+    const QVariantMap properties = reply.value();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_displayDBusInter->asyncCall("CanSetBrightness", properties.value("Name").toString()), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, path, properties](QDBusPendingCallWatcher *w) {
+        QDBusPendingReply<bool> reply = *w;
+        if (m_pendingMonitors.contains(path))
+            monitorAdded(path, properties, reply.value());
+        w->deleteLater();
+    });
 }
 
 void DisplayWorker::onMonitorsBrightnessChanged(const BrightnessMap &brightness)
@@ -311,8 +402,10 @@ void DisplayWorker::setNightMode(const bool nightmode)
     process->start("bash", QStringList() << "-c" << QString("systemctl --user %1 redshift.service && systemctl --user %2 redshift.service").arg(serverCmd).arg(cmd));
 }
 
-void DisplayWorker::monitorAdded(const QString &path)
+void DisplayWorker::monitorAdded(const QString &path, const QVariantMap &properties, bool canBrightness)
 {
+    m_pendingMonitors.remove(path);
+
     MonitorInter *inter = new MonitorInter(DisplayInterface, path, QDBusConnection::sessionBus(), this);
     Monitor *mon = new Monitor(this);
 
@@ -347,23 +440,21 @@ void DisplayWorker::monitorAdded(const QString &path)
     connect(inter, &MonitorInter::EnabledChanged, mon, &Monitor::setMonitorEnable);
     connect(&m_displayInter, static_cast<void (DisplayInter::*)(const QString &) const>(&DisplayInter::PrimaryChanged), mon, &Monitor::setPrimary);
 
-    // NOTE: DO NOT using async dbus call. because we need to have a unique name to distinguish each monitor
-    Q_ASSERT(inter->isValid());
-    mon->setName(inter->name());
-    mon->setManufacturer(inter->manufacturer());
-    mon->setModel(inter->model());
-    QDBusReply<bool> reply = m_displayDBusInter->call("CanSetBrightness", inter->name());
-    mon->setCanBrightness(reply.value());
-    mon->setMonitorEnable(inter->enabled());
+    // 属性来自 GetAll 的结果,显示器由 path 区分,名称在添加前就已经确定
+    mon->setName(properties.value("Name").toString());
+    mon->setManufacturer(properties.value("Manufacturer").toString());
+    mon->setModel(properties.value("Model").toString());
+    mon->setCanBrightness(canBrightness);
+    mon->setMonitorEnable(properties.value("Enabled").toBool());
     mon->setPath(path);
-    mon->setX(inter->x());
-    mon->setY(inter->y());
-    mon->setW(inter->width());
-    mon->setH(inter->height());
-    mon->setRotate(inter->rotation());
-    mon->setCurrentMode(inter->currentMode());
-    mon->setBestMode(inter->bestMode());
-    mon->setModeList(inter->modes());
+    mon->setX(properties.value("X").toInt());
+    mon->setY(properties.value("Y").toInt());
+    mon->setW(properties.value("Width").toInt());
+    mon->setH(properties.value("Height").toInt());
+    mon->setRotate(static_cast<quint16>(properties.value("Rotation").toUInt()));
+    mon->setCurrentMode(qdbus_cast<Resolution>(properties.value("CurrentMode")));
+    mon->setBestMode(qdbus_cast<Resolution>(properties.value("BestMode")));
+    mon->setModeList(qdbus_cast<ResolutionList>(properties.value("Modes")));
     if (m_model->isRefreshRateEnable() == false) {
         for (auto resolutionModel : mon->modeList()) {
             if (qFuzzyCompare(resolutionModel.rate(), 0.0) == false) {
@@ -371,10 +462,10 @@ void DisplayWorker::monitorAdded(const QString &path)
             }
         }
     }
-    mon->setRotateList(inter->rotations());
+    mon->setRotateList(qdbus_cast<QList<quint16>>(properties.value("Rotations")));
     mon->setPrimary(m_displayInter.primary());
-    mon->setMmWidth(inter->mmWidth());
-    mon->setMmHeight(inter->mmHeight());
+    mon->setMmWidth(properties.value("MmWidth").toUInt());
+    mon->setMmHeight(properties.value("MmHeight").toUInt());
 
     if (!m_model->brightnessMap().isEmpty()) {
         mon->setBrightness(m_model->brightnessMap()[mon->name()]);
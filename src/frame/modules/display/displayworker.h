@@ -29,6 +29,7 @@
 #include "monitor.h"
 
 #include <QObject>
+#include <QSet>
 
 #include <com_deepin_daemon_display.h>
 #include <com_deepin_daemon_appearance.h>
@@ -51,6 +52,9 @@ class DisplayWorker : public QObject
 
 public:
     explicit DisplayWorker(DisplayModel *model, QObject *parent = 0, bool isSync = false);
+
+    // 构造时访问的会话总线服务
+    static QStringList sessionServices();
     ~DisplayWorker();
 
     void active();
@@ -84,7 +88,9 @@ private Q_SLOTS:
     void onGetScreenScalesFinished(QDBusPendingCallWatcher *w);
 
 private:
-    void monitorAdded(const QString &path);
+    void requestMonitors(const QStringList &paths, bool wait);
+    void onMonitorPropertiesLoaded(const QString &path, const QDBusPendingCall &call);
+    void monitorAdded(const QString &path, const QVariantMap &properties, bool canBrightness);
     void monitorRemoved(const QString &path);
 
 private:
@@ -94,6 +100,8 @@ private:
     QGSettings *m_dccSettings;
     AppearanceInter *m_appearanceInter;
     QMap<Monitor *, MonitorInter *> m_monitors;
+    // 正在获取属性的显示器路径,同一个显示器在属性返回前不会被重复添加
+    QSet<QString> m_pendingMonitors;
     double m_currentScale;
     bool m_updateScale;
 
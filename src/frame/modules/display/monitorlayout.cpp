@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "monitorlayout.h"
+
+#include <algorithm>
+#include <climits>
+#include <numeric>
+#include <tuple>
+
+using namespace dcc::display;
+
+namespace {
+// 默认的对齐距离,单位是屏幕像素
+const int DefaultSnapDistance = 64;
+
+inline int rightOf(const QRect &r) { return r.x() + r.width(); }
+inline int bottomOf(const QRect &r) { return r.y() + r.height(); }
+
+// 区间 [a0, a1) 和 [b0, b1) 是否有公共部分
+inline bool intersects(int a0, int a1, int b0, int b1) { return a0 < b1 && b0 < a1; }
+
+// 扩展模式下摆放屏幕时位置相同也算作重叠,只有后端返回的布局才把它当作复制模式
+inline bool isCovered(const QRect &r0, const QRect &r1)
+{
+    return r0 == r1 || MonitorLayout::isOverlapped(r0, r1);
+}
+
+struct Edge {
+    int pos;
+    int index;
+
+    bool operator<(const Edge &other) const { return pos < other.pos; }
+};
+
+// 在 [lo, hi] 中离 value 最近的位置,distance 以内有对齐的位置时使用对齐的位置
+int alignTo(int value, const QVector<int> &targets, int lo, int hi, int distance)
+{
+    value = qBound(lo, value, hi);
+
+    int result = value;
+    int min = distance + 1;
+    auto it = std::lower_bound(targets.cbegin(), targets.cend(), value);
+    if (it != targets.cend() && *it <= hi && *it - value < min) {
+        result = *it;
+        min = *it - value;
+    }
+    if (it != targets.cbegin() && *(it - 1) >= lo && value - *(it - 1) < min)
+        result = *(it - 1);
+
+    return result;
+}
+
+// 排序后的两组边中位置相同的边,check 为 true 时两个屏幕相邻
+template <typename Check>
+void matchEdges(QVector<Edge> &a, QVector<Edge> &b, Check check)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+
+    int j = 0;
+    for (int i = 0; i < a.size(); ++i) {
+        while (j < b.size() && b.at(j).pos < a.at(i).pos)
+            ++j;
+        for (int k = j; k < b.size() && b.at(k).pos == a.at(i).pos; ++k)
+            check(a.at(i).index, b.at(k).index);
+    }
+}
+
+// 连通分量的编号,返回分量的数量
+int components(const QVector<QVector<int>> &graph, QVector<int> &component)
+{
+    component.fill(-1, graph.size());
+
+    int count = 0;
+    for (int i = 0; i < graph.size(); ++i) {
+        if (component.at(i) != -1)
+            continue;
+
+        QVector<int> queue { i };
+        component[i] = count;
+        while (!queue.isEmpty()) {
+            const int current = queue.takeLast();
+            for (int next : graph.at(current)) {
+                if (component.at(next) == -1) {
+                    component[next] = count;
+                    queue << next;
+                }
+            }
+        }
+        ++count;
+    }
+
+    return count;
+}
+}
+
+MonitorLayout::MonitorLayout(const QList<QRect> &rects)
+    : m_rects(rects)
+    , m_snapDistance(DefaultSnapDistance)
+{
+}
+
+bool MonitorLayout::isOverlapped(const QRect &r0, const QRect &r1)
+{
+    if (r0 == r1)
+        return false;
+
+    return intersects(r0.x(), rightOf(r0), r1.x(), rightOf(r1))
+           && intersects(r0.y(), bottomOf(r0), r1.y(), bottomOf(r1));
+}
+
+bool MonitorLayout::isAdjacent(const QRect &r0, const QRect &r1)
+{
+    if (r0 == r1)
+        return true;
+
+    if ((rightOf(r0) == r1.x() || rightOf(r1) == r0.x())
+            && intersects(r0.y(), bottomOf(r0), r1.y(), bottomOf(r1)))
+        return true;
+
+    return (bottomOf(r0) == r1.y() || bottomOf(r1) == r0.y())
+           && intersects(r0.x(), rightOf(r0), r1.x(), rightOf(r1));
+}
+
+QVector<QVector<int>> MonitorLayout::adjacency() const
+{
+    QVector<QVector<int>> graph(count());
+    auto link = [&graph](int i, int j) {
+        if (i != j && !graph.at(i).contains(j)) {
+            graph[i] << j;
+            graph[j] << i;
+        }
+    };
+
+    QVector<Edge> lefts, rights, tops, bottoms;
+    for (int i = 0; i < count(); ++i) {
+        const QRect &r = m_rects.at(i);
+        lefts << Edge { r.x(), i };
+        rights << Edge { rightOf(r), i };
+        tops << Edge { r.y(), i };
+        bottoms << Edge { bottomOf(r), i };
+    }
+
+    // 右边和左边位置相同并且上下有公共部分的屏幕左右相邻
+    matchEdges(rights, lefts, [this, &link](int i, int j) {
+        const QRect &r0 = m_rects.at(i);
+        const QRect &r1 = m_rects.at(j);
+        if (intersects(r0.y(), bottomOf(r0), r1.y(), bottomOf(r1)))
+            link(i, j);
+    });
+    matchEdges(bottoms, tops, [this, &link](int i, int j) {
+        const QRect &r0 = m_rects.at(i);
+        const QRect &r1 = m_rects.at(j);
+        if (intersects(r0.x(), rightOf(r0), r1.x(), rightOf(r1)))
+            link(i, j);
+    });
+
+    // 位置相同的屏幕排序后是连续的
+    QVector<int> order(count());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int i, int j) {
+        const QRect &r0 = m_rects.at(i);
+        const QRect &r1 = m_rects.at(j);
+        return std::make_tuple(r0.x(), r0.y(), r0.width(), r0.height())
+               < std::make_tuple(r1.x(), r1.y(), r1.width(), r1.height());
+    });
+    for (int i = 1; i < order.size(); ++i) {
+        for (int j = i - 1; j >= 0 && m_rects.at(order.at(j)) == m_rects.at(order.at(i)); --j)
+            link(order.at(i), order.at(j));
+    }
+
+    for (QVector<int> &neighbors : graph)
+        std::sort(neighbors.begin(), neighbors.end());
+
+    return graph;
+}
+
+bool MonitorLayout::hasOverlap() const
+{
+    QVector<int> order(count());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int i, int j) {
+        return m_rects.at(i).x() < m_rects.at(j).x();
+    });
+
+    // 按左边从左到右扫描,只和还没有结束的屏幕比较
+    QVector<int> active;
+    for (int i : order) {
+        const QRect &r = m_rects.at(i);
+        active.erase(std::remove_if(active.begin(), active.end(), [this, &r](int j) {
+            return rightOf(m_rects.at(j)) <= r.x();
+        }), active.end());
+
+        for (int j : active) {
+            if (isOverlapped(r, m_rects.at(j)))
+                return true;
+        }
+        active << i;
+    }
+
+    return false;
+}
+
+bool MonitorLayout::isConnected() const
+{
+    QVector<int> component;
+    return components(adjacency(), component) <= 1;
+}
+
+bool MonitorLayout::isPerfect() const
+{
+    return !hasOverlap() && isConnected();
+}
+
+QPoint MonitorLayout::snap(int index, const QPoint &pos, bool *ok) const
+{
+    QList<QRect> others = m_rects;
+    others.removeAt(index);
+
+    return bestPosition(m_rects.at(index).size(), pos, others, ok);
+}
+
+QList<QRect> MonitorLayout::arranged() const
+{
+    QList<QRect> result = m_rects;
+    if (count() < 2)
+        return result;
+
+    // 从第一个屏幕开始,保留与它连成一片并且不重叠(位置也不相同)的屏幕
+    const QVector<QVector<int>> &graph = adjacency();
+    QVector<bool> placed(count(), false);
+    QList<QRect> placedRects;
+    QVector<int> queue { 0 };
+    placed[0] = true;
+    placedRects << result.first();
+    while (!queue.isEmpty()) {
+        const int current = queue.takeFirst();
+        for (int next : graph.at(current)) {
+            if (placed.at(next))
+                continue;
+
+            bool overlapped = false;
+            for (const QRect &r : placedRects) {
+                if (isCovered(r, result.at(next))) {
+                    overlapped = true;
+                    break;
+                }
+            }
+            if (overlapped)
+                continue;
+
+            placed[next] = true;
+            placedRects << result.at(next);
+            queue << next;
+        }
+    }
+
+    // 其余的屏幕每次选移动距离最短的一个贴到已经放好的屏幕上
+    while (placedRects.size() < count()) {
+        int bestIndex = -1;
+        QPoint bestPos;
+        int min = INT_MAX;
+        for (int i = 0; i < count(); ++i) {
+            if (placed.at(i))
+                continue;
+
+            bool ok = false;
+            const QPoint &pos = bestPosition(result.at(i).size(), result.at(i).topLeft(), placedRects, &ok);
+            const int m = (pos - result.at(i).topLeft()).manhattanLength();
+            if (ok && m < min) {
+                min = m;
+                bestIndex = i;
+                bestPos = pos;
+            }
+        }
+
+        // 已经放好的屏幕连成一片,外侧总有可以贴合的位置
+        Q_ASSERT(bestIndex != -1);
+        if (bestIndex == -1)
+            break;
+
+        result[bestIndex].moveTopLeft(bestPos);
+        placed[bestIndex] = true;
+        placedRects << result.at(bestIndex);
+    }
+
+    return result;
+}
+
+QList<QRect> MonitorLayout::normalized(const QList<QRect> &rects)
+{
+    int minX = INT_MAX;
+    int minY = INT_MAX;
+    for (const QRect &r : rects) {
+        minX = std::min(minX, r.x());
+        minY = std::min(minY, r.y());
+    }
+
+    QList<QRect> result;
+    for (const QRect &r : rects)
+        result << r.translated(-minX, -minY);
+
+    return result;
+}
+
+QPoint MonitorLayout::bestPosition(const QSize &size, const QPoint &pos, const QList<QRect> &others, bool *ok) const
+{
+    if (ok)
+        *ok = others.isEmpty();
+    if (others.isEmpty())
+        return pos;
+
+    // 其他屏幕可能不连通,新的位置需要与每个连通分量都相邻
+    QVector<int> component;
+    const int componentCount = components(MonitorLayout(others).adjacency(), component);
+
+    // 自由方向上对齐其他屏幕的左边或右边(上边或下边)
+    const int w = size.width();
+    const int h = size.height();
+    QVector<int> xTargets, yTargets;
+    for (const QRect &r : others) {
+        xTargets << r.x() << rightOf(r) << r.x() - w << rightOf(r) - w;
+        yTargets << r.y() << bottomOf(r) << r.y() - h << bottomOf(r) - h;
+    }
+    std::sort(xTargets.begin(), xTargets.end());
+    std::sort(yTargets.begin(), yTargets.end());
+
+    // 贴在每个屏幕四条边外侧的位置,公共的边至少有对齐距离那么长,避免只相交一两个像素
+    QVector<QPoint> candidates;
+    for (const QRect &r : others) {
+        const int shareH = qBound(1, m_snapDistance, std::min(h, r.height()));
+        const int y = alignTo(pos.y(), yTargets, r.y() - h + shareH, bottomOf(r) - shareH, m_snapDistance);
+        candidates << QPoint(rightOf(r), y) << QPoint(r.x() - w, y);
+
+        const int shareW = qBound(1, m_snapDistance, std::min(w, r.width()));
+        const int x = alignTo(pos.x(), xTargets, r.x() - w + shareW, rightOf(r) - shareW, m_snapDistance);
+        candidates << QPoint(x, bottomOf(r)) << QPoint(x, r.y() - h);
+    }
+
+    QPoint best = pos;
+    int min = INT_MAX;
+    QVector<bool> touched(componentCount);
+    for (const QPoint &candidate : candidates) {
+        const int m = (candidate - pos).manhattanLength();
+        if (m >= min)
+            continue;
+
+        const QRect rect(candidate, size);
+        bool valid = true;
+        int touchedCount = 0;
+        touched.fill(false);
+        for (int i = 0; i < others.size() && valid; ++i) {
+            if (isCovered(rect, others.at(i))) {
+                valid = false;
+            } else if (isAdjacent(rect, others.at(i)) && !touched.at(component.at(i))) {
+                touched[component.at(i)] = true;
+                ++touchedCount;
+            }
+        }
+
+        if (!valid || touchedCount < componentCount)
+            continue;
+
+        min = m;
+        best = candidate;
+        if (ok)
+            *ok = true;
+    }
+
+    return best;
+}
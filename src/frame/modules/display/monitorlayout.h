@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MONITORLAYOUT_H
+#define MONITORLAYOUT_H
+
+#include <QList>
+#include <QRect>
+#include <QVector>
+
+namespace dcc {
+
+namespace display {
+
+/**
+ * @brief The MonitorLayout class 多个屏幕在扩展模式下的布局
+ * 屏幕之间有公共的边(不只是角点)时相邻,所有屏幕不重叠并且通过相邻关系连成一片时布局是完整的;
+ * 位置完全相同的屏幕(复制模式)既不算重叠也算作相邻
+ */
+class MonitorLayout
+{
+public:
+    explicit MonitorLayout(const QList<QRect> &rects = QList<QRect>());
+
+    inline const QList<QRect> &rects() const { return m_rects; }
+    void setRects(const QList<QRect> &rects) { m_rects = rects; }
+    inline int count() const { return m_rects.size(); }
+
+    // 拖动时自由方向上与其他屏幕的边对齐的距离
+    inline int snapDistance() const { return m_snapDistance; }
+    void setSnapDistance(int distance) { m_snapDistance = qMax(0, distance); }
+
+    static bool isOverlapped(const QRect &r0, const QRect &r1);
+    static bool isAdjacent(const QRect &r0, const QRect &r1);
+
+    // 每个屏幕相邻的屏幕
+    QVector<QVector<int>> adjacency() const;
+    bool hasOverlap() const;
+    bool isConnected() const;
+    bool isPerfect() const;
+
+    // 把 index 的屏幕移到 pos 附近,与其他屏幕贴合、不重叠(也不与其他屏幕位置相同)并且布局仍然连成一片的位置;
+    // 找不到这样的位置时 ok 为 false
+    QPoint snap(int index, const QPoint &pos, bool *ok = nullptr) const;
+
+    // 与当前布局最接近的完整布局,已经连成一片的屏幕位置不变,位置相同的屏幕会被移开
+    QList<QRect> arranged() const;
+
+    // 平移所有屏幕,使最左和最上的边都为 0
+    static QList<QRect> normalized(const QList<QRect> &rects);
+
+private:
+    QPoint bestPosition(const QSize &size, const QPoint &pos, const QList<QRect> &others, bool *ok) const;
+
+private:
+    QList<QRect> m_rects;
+    int m_snapDistance;
+};
+
+} // namespace display
+
+} // namespace dcc
+
+#endif // MONITORLAYOUT_H
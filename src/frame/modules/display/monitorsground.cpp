@@ -26,6 +26,7 @@
 #include "monitorsground.h"
 #include "monitorproxywidget.h"
 #include "displaymodel.h"
+#include "monitorlayout.h"
 
 using namespace dcc::display;
 
@@ -33,6 +34,8 @@ const int MARGIN_W = 20;
 const int MARGIN_H = 10;
 const int VIEW_WIDTH = 400;
 const int VIEW_HEIGHT = 200;
+// 拖动时与其他屏幕的边对齐的距离,单位是界面上的像素
+const int SNAP_DISTANCE = 10;
 
 MonitorsGround::MonitorsGround(QWidget *parent)
     : QFrame(parent)
@@ -97,76 +100,46 @@ void MonitorsGround::resetMonitorsView()
     }
 
     // recheck settings
-    if (!isScreenPerfect()) {
-        monitorMoved(m_monitors.firstKey());
-    }
+    if (isScreenPerfect())
+        return;
+
+    // 只整理一次并重新摆放控件,不再重复检查;整理后仍不完整(或后端返回了不同的位置)时保持现状,
+    // 避免反复调用 applySettings
+    const QList<MonitorProxyWidget *> widgets = m_monitors.keys();
+    const QList<QRect> &rects = monitorRects(widgets);
+    const QList<QRect> &arranged = MonitorLayout(rects).arranged();
+    if (MonitorLayout::normalized(arranged) == MonitorLayout::normalized(rects))
+        return;
+
+    applyLayout(widgets, arranged);
+
+    reloadViewPortSize();
+    for (auto pw : widgets)
+        adjust(pw);
 }
 
 void MonitorsGround::monitorMoved(MonitorProxyWidget *pw)
 {
     qDebug() << Q_FUNC_INFO << pw->name();
-    const QPoint preTopLeft = QPoint(pw->x(), pw->y());
 
     const double scale = screenScale();
     const double offsetX = VIEW_WIDTH / 2 - (m_viewPortWidth * scale) / 2 + MARGIN_W;
     const double offsetY = VIEW_HEIGHT / 2 - (m_viewPortHeight * scale) / 2 + MARGIN_H;
-
-    pw->setMovedX(static_cast<int>((pw->pos().x() - offsetX) / scale));
-    pw->setMovedY(static_cast<int>((pw->pos().y() - offsetY) / scale));
-
-    // ensure screens is 贴合但不相交
-    ensureWidgetPerfect(pw);
-
-    // 移至斜对角时，还原显示器位置
-    const QPoint pwTopLeft = QPoint(pw->x(), pw->y());
-    const QPoint pwTopRight = QPoint(pw->x() + pw->w(), pw->y());
-    const QPoint pwBottomLeft = QPoint(pw->x(), pw->y() + pw->h());
-    const QPoint pwBottomRight = QPoint(pw->x() + pw->w(), pw->y() + pw->h());
-    QRect rpw(pwTopLeft, pwBottomRight);
-
-    MonitorProxyWidget *other = nullptr;
-    for (auto w : m_monitors.keys()) {
-        if (w != pw) {
-            other = w;
-            break;
-        }
-    }
-
-    const QPoint otTopLeft = QPoint(other->x(), other->y());
-    const QPoint otTopRight = QPoint(other->x() + other->w(), other->y());
-    const QPoint otBottomLeft = QPoint(other->x(), other->y() + other->h());
-    const QPoint otBottomRight = QPoint(other->x() + other->w(), other->y() + other->h());
-    QRect rot(otTopLeft, otBottomRight);
-
-    int cnt = 0;
-    cnt += rot.contains(pwTopLeft) ? 1 : 0;
-    cnt += rot.contains(pwTopRight) ? 1 : 0;
-    cnt += rot.contains(pwBottomLeft) ? 1 : 0;
-    cnt += rot.contains(pwBottomRight) ? 1 : 0;
-
-    int otCnt = 0;
-    otCnt += rpw.contains(otTopLeft) ? 1 : 0;
-    otCnt += rpw.contains(otTopRight) ? 1 : 0;
-    otCnt += rpw.contains(otBottomLeft) ? 1 : 0;
-    otCnt += rpw.contains(otBottomRight) ? 1 : 0;
-
-    if (cnt >= 2 || otCnt >= 2) {
-        // clear global offset
-        int minX = INT_MAX;
-        int minY = INT_MAX;
-        for (auto w : m_monitors.keys()) {
-            minX = std::min(minX, w->x());
-            minY = std::min(minY, w->y());
-        }
-        for (auto w : m_monitors.keys()) {
-            w->setMovedX(w->x() - minX);
-            w->setMovedY(w->y() - minY);
-        }
-
-        applySettings();
-    } else {
-        pw->setMovedX(preTopLeft.x());
-        pw->setMovedY(preTopLeft.y());
+    const QPoint movedPos(static_cast<int>((pw->pos().x() - offsetX) / scale),
+                          static_cast<int>((pw->pos().y() - offsetY) / scale));
+
+    // ensure screens is 贴合但不相交,并且所有屏幕连成一片;找不到这样的位置时(如移至斜对角)还原显示器位置
+    const QList<MonitorProxyWidget *> widgets = m_monitors.keys();
+    MonitorLayout layout(monitorRects(widgets));
+    layout.setSnapDistance(static_cast<int>(SNAP_DISTANCE / scale));
+
+    bool ok = false;
+    const int index = widgets.indexOf(pw);
+    const QPoint pos = layout.snap(index, movedPos, &ok);
+    if (ok) {
+        QList<QRect> rects = layout.rects();
+        rects[index].moveTopLeft(pos);
+        applyLayout(widgets, rects);
     }
 
     qApp->processEvents();
@@ -222,31 +195,6 @@ void MonitorsGround::adjustAll()
     }
 }
 
-void MonitorsGround::ensureWidgetPerfect(MonitorProxyWidget *pw)
-{
-    qDebug() << Q_FUNC_INFO << pw->name();
-
-    // TODO: only support 2 screens
-    if (m_monitors.size() != 2)
-        return;
-
-    MonitorProxyWidget *other = nullptr;
-    for (auto w : m_monitors.keys()) {
-        if (w != pw) {
-            other = w;
-            break;
-        }
-    }
-    Q_ASSERT(other);
-
-    const QPoint bestOffset = bestMoveOffset(pw, other);
-    const int x = pw->x() - bestOffset.x();
-    const int y = pw->y() - bestOffset.y();
-
-    pw->setMovedX(x);
-    pw->setMovedY(y);
-}
-
 void MonitorsGround::reloadViewPortSize()
 {
     int w = 0;
@@ -269,22 +217,10 @@ void MonitorsGround::applySettings()
 
 bool MonitorsGround::isScreenPerfect() const
 {
-    // only support 2 screens
-    if (m_monitors.size() != 2)
-        return true;
-
-    MonitorProxyWidget *p0 = m_monitors.firstKey();
-    MonitorProxyWidget *p1 = m_monitors.lastKey();
-
-    const QRect r0(p0->x(), p0->y(), p0->w(), p0->h());
-    const QRect r1(p1->x(), p1->y(), p1->w(), p1->h());
-
-    if (r0 == r1)
+    if (m_monitors.size() < 2)
         return true;
-    if (r0.intersects(r1))
-        return false;
 
-    return bestMoveOffset(p0, p1).isNull();
+    return MonitorLayout(monitorRects(m_monitors.keys())).isPerfect();
 }
 
 double MonitorsGround::screenScale() const
@@ -295,43 +231,23 @@ double MonitorsGround::screenScale() const
     return std::min(scaleW, scaleH);
 }
 
-const QPoint MonitorsGround::bestMoveOffset(MonitorProxyWidget *pw0, MonitorProxyWidget *pw1) const
+QList<QRect> MonitorsGround::monitorRects(const QList<MonitorProxyWidget *> &widgets) const
 {
-    const QPoint selfTopLeft = QPoint(pw0->x(), pw0->y());
-    QList<QPoint> selfPoints;
-    selfPoints.append(selfTopLeft);
-    selfPoints.append(QPoint(pw0->x() + pw0->w(), pw0->y()));
-    selfPoints.append(QPoint(pw0->x(), pw0->y() + pw0->h()));
-    selfPoints.append(QPoint(pw0->x() + pw0->w(), pw0->y() + pw0->h()));
-
-    const QPoint otherTopLeft = QPoint(pw1->x(), pw1->y());
-    const QRect r1(pw1->x(), pw1->y(), pw1->w(), pw1->h());
-    QList<QPoint> otherPoints;
-    otherPoints.append(otherTopLeft);
-    otherPoints.append(QPoint(pw1->x() + pw1->w(), pw1->y()));
-    otherPoints.append(QPoint(pw1->x(), pw1->y() + pw1->h()));
-    otherPoints.append(QPoint(pw1->x() + pw1->w(), pw1->y() + pw1->h()));
-
-    // TODO: check screen rect contains another screen and size not equal
-    QPoint bestOffset;
-    int min = INT_MAX;
-    for (auto p1 : selfPoints) {
-        for (auto p2 : otherPoints) {
-            const int m = (p2 - p1).manhattanLength();
-            if (m >= min)
-                continue;
-
-            const QPoint offset = p1 - p2;
-
-            // test intersect
-            const QRect r0(pw0->x() - offset.x(), pw0->y() - offset.y(), pw0->w(), pw0->h());
-            if (r0.intersects(r1))
-                continue;
-
-            min = m;
-            bestOffset = offset;
-        }
+    QList<QRect> rects;
+    for (auto pw : widgets)
+        rects << QRect(pw->x(), pw->y(), pw->w(), pw->h());
+
+    return rects;
+}
+
+void MonitorsGround::applyLayout(const QList<MonitorProxyWidget *> &widgets, const QList<QRect> &rects)
+{
+    // clear global offset
+    const QList<QRect> &normalized = MonitorLayout::normalized(rects);
+    for (int i = 0; i < widgets.size(); ++i) {
+        widgets.at(i)->setMovedX(normalized.at(i).x());
+        widgets.at(i)->setMovedY(normalized.at(i).y());
     }
 
-    return bestOffset;
+    applySettings();
 }
@@ -58,12 +58,12 @@ private Q_SLOTS:
     void adjustAll();
 
 private:
-    void ensureWidgetPerfect(MonitorProxyWidget *pw);
     void reloadViewPortSize();
     void applySettings();
     bool isScreenPerfect() const;
     double screenScale() const;
-    const QPoint bestMoveOffset(MonitorProxyWidget *pw0, MonitorProxyWidget *pw1) const;
+    QList<QRect> monitorRects(const QList<MonitorProxyWidget *> &widgets) const;
+    void applyLayout(const QList<MonitorProxyWidget *> &widgets, const QList<QRect> &rects);
 
 private:
     int m_viewPortWidth;
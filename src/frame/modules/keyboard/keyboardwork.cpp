@@ -53,6 +53,11 @@ KeyboardWorker::KeyboardWorker(KeyboardModel *model, QObject *parent)
                                           "/com/deepin/daemon/Keybinding",
                                           QDBusConnection::sessionBus(), this))
      , m_wm(new WM("com.deepin.wm", "/com/deepin/wm", QDBusConnection::sessionBus(), this))
+#ifndef DCC_DISABLE_KBLAYOUT
+     , m_layoutDescRequests(0)
+     , m_layoutListRequested(false)
+     , m_layoutListLoaded(false)
+#endif
 {
     connect(m_wm, &WM::compositingEnabledChanged, this, &KeyboardWorker::onGetWindowWM);
     connect(m_keybindInter, SIGNAL(Added(QString,int)), this,SLOT(onAdded(QString,int)));
@@ -211,8 +216,7 @@ void KeyboardWorker::onRefreshKBLayout()
 {
     m_model->setKbSwitch(static_cast<int>(m_keybindInter->shortcutSwitchLayout()));
 
-    QDBusPendingCallWatcher *layoutResult = new QDBusPendingCallWatcher(m_keyboardInter->LayoutList(), this);
-    connect(layoutResult, &QDBusPendingCallWatcher::finished, this, &KeyboardWorker::onLayoutListsFinished);
+    requestLayoutList();
 
     onCurrentLayout(m_keyboardInter->currentLayout());
     onUserLayout(m_keyboardInter->userLayoutList());
@@ -437,12 +441,32 @@ void KeyboardWorker::onAddedFinished(QDBusPendingCallWatcher *watch)
 }
 
 #ifndef DCC_DISABLE_KBLAYOUT
+void KeyboardWorker::requestLayoutList()
+{
+    // 布局列表在会话中不会变化,只需要获取一次
+    if (m_layoutListLoaded || m_layoutListRequested)
+        return;
+
+    m_layoutListRequested = true;
+    QDBusPendingCallWatcher *layoutResult = new QDBusPendingCallWatcher(m_keyboardInter->LayoutList(), this);
+    connect(layoutResult, &QDBusPendingCallWatcher::finished, this, &KeyboardWorker::onLayoutListsFinished);
+}
+
 void KeyboardWorker::onLayoutListsFinished(QDBusPendingCallWatcher *watch)
 {
     QDBusPendingReply<KeyboardLayoutList> reply = *watch;
 
-    KeyboardLayoutList tmp_map = reply.value();
-    m_model->setLayoutLists(tmp_map);
+    if (reply.isError()) {
+        qDebug() << "get layout list failed:" << reply.error();
+    } else {
+        KeyboardLayoutList tmp_map = reply.value();
+        m_model->setLayoutLists(tmp_map);
+    }
+
+    // 获取失败时所有 id 都会通过 GetLayoutDesc 查询
+    m_layoutListRequested = false;
+    m_layoutListLoaded = true;
+    resolveLayoutDescs();
 
     watch->deleteLater();
 }
@@ -486,26 +510,84 @@ void KeyboardWorker::onUserLayout(const QStringList &list)
     m_model->cleanUserLayout();
     m_model->getUserLayoutList() = list;
 
-    for (const QString &data : list) {
-        QDBusPendingCallWatcher *layoutResult = new QDBusPendingCallWatcher(m_keyboardInter->GetLayoutDesc(data), this);
-        layoutResult->setProperty("id", data);
-        connect(layoutResult, &QDBusPendingCallWatcher::finished, this, &KeyboardWorker::onUserLayoutFinished);
+    m_pendingUserLayouts = list;
+    resolveLayoutDescs();
+}
+
+void KeyboardWorker::onCurrentLayout(const QString &value)
+{
+    m_pendingCurrentLayout = value;
+    resolveLayoutDescs();
+}
+
+bool KeyboardWorker::layoutDesc(const QString &id, QString &desc) const
+{
+    const QMap<QString, QString> &layouts = m_model->kbLayout();
+    auto it = layouts.constFind(id);
+    if (it != layouts.cend()) {
+        desc = it.value();
+        return true;
+    }
+
+    auto extra = m_extraLayoutDescs.constFind(id);
+    if (extra != m_extraLayoutDescs.cend()) {
+        desc = extra.value();
+        return true;
     }
+
+    return false;
 }
 
-void KeyboardWorker::onUserLayoutFinished(QDBusPendingCallWatcher *watch)
+void KeyboardWorker::resolveLayoutDescs()
 {
-    QDBusPendingReply<QString> reply = *watch;
+    // 布局列表返回后再统一从本地查找
+    if (!m_layoutListLoaded) {
+        requestLayoutList();
+        return;
+    }
 
-    m_model->addUserLayout(watch->property("id").toString(), reply.value());
+    QStringList unknown;
+    QString desc;
 
-    watch->deleteLater();
+    for (const QString &id : m_pendingUserLayouts) {
+        if (layoutDesc(id, desc))
+            m_model->addUserLayout(id, desc);
+        else
+            unknown << id;
+    }
+    m_pendingUserLayouts = unknown;
+
+    if (!m_pendingCurrentLayout.isEmpty()) {
+        if (layoutDesc(m_pendingCurrentLayout, desc)) {
+            m_model->setLayout(desc);
+            m_pendingCurrentLayout.clear();
+        } else if (!unknown.contains(m_pendingCurrentLayout)) {
+            unknown << m_pendingCurrentLayout;
+        }
+    }
+
+    if (unknown.isEmpty() || m_layoutDescRequests > 0)
+        return;
+
+    // 列表中没有的 id 一起查询,全部返回后再统一更新
+    for (const QString &id : unknown) {
+        ++m_layoutDescRequests;
+        QDBusPendingCallWatcher *layoutResult = new QDBusPendingCallWatcher(m_keyboardInter->GetLayoutDesc(id), this);
+        layoutResult->setProperty("id", id);
+        connect(layoutResult, &QDBusPendingCallWatcher::finished, this, &KeyboardWorker::onLayoutDescFinished);
+    }
 }
 
-void KeyboardWorker::onCurrentLayout(const QString &value)
+void KeyboardWorker::onLayoutDescFinished(QDBusPendingCallWatcher *watch)
 {
-    QDBusPendingCallWatcher *layoutResult = new QDBusPendingCallWatcher(m_keyboardInter->GetLayoutDesc(value), this);
-    connect(layoutResult, &QDBusPendingCallWatcher::finished, this, &KeyboardWorker::onCurrentLayoutFinished);
+    QDBusPendingReply<QString> reply = *watch;
+
+    // 查询失败时也记录下来,避免重复查询
+    m_extraLayoutDescs.insert(watch->property("id").toString(), reply.value());
+    watch->deleteLater();
+
+    if (--m_layoutDescRequests == 0)
+        resolveLayoutDescs();
 }
 
 void KeyboardWorker::onSearchShortcuts(const QString &searchKey)
@@ -525,15 +607,6 @@ void KeyboardWorker::setModelLayoutScope(const int value)
     m_model->setLayoutScope(value);
 }
 
-void KeyboardWorker::onCurrentLayoutFinished(QDBusPendingCallWatcher *watch)
-{
-    QDBusPendingReply<QString> reply = *watch;
-
-    m_model->setLayout(reply.value());
-
-    watch->deleteLater();
-}
-
 void KeyboardWorker::onSearchFinished(QDBusPendingCallWatcher *watch)
 {
     QDBusPendingReply<QString> reply = *watch;
@@ -547,72 +620,21 @@ void KeyboardWorker::onSearchFinished(QDBusPendingCallWatcher *watch)
 
 void KeyboardWorker::onPinyin()
 {
-    m_letters.clear();
-    m_metaDatas.clear();
-    QDBusInterface dbus_pinyin("com.deepin.api.Pinyin", "/com/deepin/api/Pinyin",
-                               "com.deepin.api.Pinyin");
+    QList<LayoutIndexItem> items;
+    m_layoutIndex.build(m_model->kbLayout(), QLocale().language() == QLocale::Chinese, items, m_letters);
 
-    Q_FOREACH(const QString & str, m_model->kbLayout().keys()) {
-        MetaData md;
-        QString title = m_model->kbLayout()[str];
-        md.setText(title);
-        md.setKey(str);
-        QChar letterFirst = title[0];
-        QStringList letterFirstList;
-        if (letterFirst.isLower() || letterFirst.isUpper()) {
-            letterFirstList << QString(letterFirst);
-            md.setPinyin(title);
-        } else {
-            QDBusMessage message = dbus_pinyin.call("Query", title);
-            letterFirstList = message.arguments()[0].toStringList();
-            md.setPinyin(letterFirstList.at(0));
-        }
-
-        append(md);
-    }
-
-    QLocale locale;
-
-    if (locale.language() == QLocale::Chinese) {
-        QChar ch = '\0';
-        for (int i(0); i != m_metaDatas.size(); ++i)
-        {
-            const QChar flag = m_metaDatas[i].pinyin().at(0).toUpper();
-            if (flag == ch)
-                continue;
-            ch = flag;
-
-            m_letters.append(ch);
-            m_metaDatas.insert(i, MetaData(ch, true));
-        }
-    } else {
-        qSort(m_metaDatas.begin(), m_metaDatas.end(), caseInsensitiveLessThan);
+    m_metaDatas.clear();
+    m_metaDatas.reserve(items.size());
+    for (const LayoutIndexItem &item : items) {
+        MetaData md(item.text, item.section);
+        md.setKey(item.key);
+        md.setPinyin(item.pinyin);
+        m_metaDatas.append(md);
     }
 
     Q_EMIT onDatasChanged(m_metaDatas);
     Q_EMIT onLettersChanged(m_letters);
 }
-
-void KeyboardWorker::append(const MetaData &md)
-{
-    if(m_metaDatas.count() == 0)
-    {
-        m_metaDatas.append(md);
-        return;
-    }
-
-    int index = 0;
-    for (int i = 0; i != m_metaDatas.size(); ++i) {
-        if(m_metaDatas.at(i) > md)
-        {
-            m_metaDatas.insert(index,md);
-            return;
-        }
-        index++;
-    }
-
-    m_metaDatas.append(md);
-}
 #endif
 
 #ifndef DCC_DISABLE_LANGUAGE
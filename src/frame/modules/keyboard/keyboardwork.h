@@ -30,6 +30,7 @@
 #include "indexmodel.h"
 #include "shortcutmodel.h"
 #include "keyboardmodel.h"
+#include "layoutindex.h"
 #include <com_deepin_daemon_inputdevice_keyboard.h>
 #include <com_deepin_daemon_langselector.h>
 #include <com_deepin_daemon_keybinding.h>
@@ -125,13 +126,11 @@ public Q_SLOTS:
 #ifndef DCC_DISABLE_KBLAYOUT
     void onLayoutListsFinished(QDBusPendingCallWatcher *watch);
     void onUserLayout(const QStringList &list);
-    void onUserLayoutFinished(QDBusPendingCallWatcher *watch);
     void onCurrentLayout(const QString &value);
-    void onCurrentLayoutFinished(QDBusPendingCallWatcher *watch);
+    void onLayoutDescFinished(QDBusPendingCallWatcher *watch);
     void onPinyin();
     void onSearchShortcuts(const QString &searchKey);
     void onSearchFinished(QDBusPendingCallWatcher *watch);
-    void append(const MetaData& md);
 #endif
 
 #ifndef DCC_DISABLE_LANGUAGE
@@ -153,11 +152,17 @@ private:
     uint converToModelDelay(uint value);
     int converToDBusInterval(int value);
     uint converToModelInterval(uint value);
+#ifndef DCC_DISABLE_KBLAYOUT
+    bool layoutDesc(const QString &id, QString &desc) const;
+    void requestLayoutList();
+    void resolveLayoutDescs();
+#endif
 
 private:
     QList<MetaData> m_datas;
     QList<MetaData> m_metaDatas;
     QList<QString> m_letters;
+    LayoutIndex m_layoutIndex;
     int m_delayValue;
     int m_speedValue;
     KeyboardModel* m_model;
@@ -168,6 +173,16 @@ private:
     KeybingdingInter* m_keybindInter;
     ShortcutModel *m_shortcutModel;
     WM *m_wm;
+#ifndef DCC_DISABLE_KBLAYOUT
+    // 等待布局描述的用户布局和当前布局
+    QStringList m_pendingUserLayouts;
+    QString m_pendingCurrentLayout;
+    // 不在布局列表中的 id 通过 GetLayoutDesc 查询到的描述
+    QMap<QString, QString> m_extraLayoutDescs;
+    int m_layoutDescRequests;
+    bool m_layoutListRequested;
+    bool m_layoutListLoaded;
+#endif
 };
 }
 }
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "layoutindex.h"
+
+#include <DPinyin>
+
+#include <QCollator>
+#include <QVector>
+
+#include <algorithm>
+#include <vector>
+
+namespace dcc {
+namespace keyboard {
+
+QString LayoutIndex::pinyin(const QString &title)
+{
+    // 与原来的逻辑一致,字母开头的布局名直接用于排序
+    if (title.isEmpty() || title.at(0).isLower() || title.at(0).isUpper())
+        return title;
+
+    QString result;
+    result.reserve(title.size() * 3);
+    for (const QChar &ch : title) {
+        if (ch.script() != QChar::Script_Han) {
+            result.append(ch.toLower());
+            continue;
+        }
+
+        auto it = m_table.constFind(ch);
+        if (it == m_table.cend()) {
+            QString py;
+            for (const QChar &c : DTK_CORE_NAMESPACE::Chinese2Pinyin(QString(ch))) {
+                if (!c.isDigit())
+                    py.append(c);
+            }
+            it = m_table.insert(ch, py.toLower());
+        }
+        result.append(it.value());
+    }
+
+    return result;
+}
+
+void LayoutIndex::build(const QMap<QString, QString> &layouts, bool grouped,
+                        QList<LayoutIndexItem> &items, QList<QString> &letters)
+{
+    items.clear();
+    letters.clear();
+
+    QVector<LayoutIndexItem> sorted;
+    sorted.reserve(layouts.size());
+    for (auto it = layouts.cbegin(); it != layouts.cend(); ++it) {
+        LayoutIndexItem item;
+        item.key = it.key();
+        item.text = it.value();
+        item.pinyin = pinyin(it.value());
+        sorted.append(item);
+    }
+
+    if (!grouped) {
+        // 排序键只生成一次,避免每次比较都重新构造 QCollator
+        QCollator collator;
+        std::vector<std::pair<QCollatorSortKey, int>> keys;
+        keys.reserve(sorted.size());
+        for (int i = 0; i < sorted.size(); ++i)
+            keys.emplace_back(collator.sortKey(sorted.at(i).text), i);
+
+        std::stable_sort(keys.begin(), keys.end(), [](const std::pair<QCollatorSortKey, int> &a, const std::pair<QCollatorSortKey, int> &b) {
+            return a.first.compare(b.first) < 0;
+        });
+
+        items.reserve(sorted.size());
+        for (const auto &key : keys)
+            items.append(sorted.at(key.second));
+        return;
+    }
+
+    std::stable_sort(sorted.begin(), sorted.end(), [](const LayoutIndexItem &a, const LayoutIndexItem &b) {
+        return QString::compare(a.pinyin, b.pinyin, Qt::CaseInsensitive) < 0;
+    });
+
+    items.reserve(sorted.size() + 26);
+    QChar current;
+    for (const LayoutIndexItem &item : sorted) {
+        const QString &name = item.pinyin.isEmpty() ? item.text : item.pinyin;
+        const QChar flag = name.isEmpty() ? QChar('#') : name.at(0).toUpper();
+        if (flag != current) {
+            current = flag;
+            letters.append(flag);
+
+            LayoutIndexItem section;
+            section.text = flag;
+            section.section = true;
+            items.append(section);
+        }
+        items.append(item);
+    }
+}
+
+}
+}
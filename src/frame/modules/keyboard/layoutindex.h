@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LAYOUTINDEX_H
+#define LAYOUTINDEX_H
+
+#include <QString>
+#include <QList>
+#include <QMap>
+#include <QHash>
+
+namespace dcc {
+namespace keyboard {
+
+struct LayoutIndexItem
+{
+    QString key;
+    QString text;
+    QString pinyin;
+    bool section = false;
+};
+
+/**
+ * @brief The LayoutIndex class 键盘布局列表的排序与首字母分组
+ * 非拉丁字母开头的布局名通过 DTK 自带的拼音表在进程内转换,不再逐条调用 com.deepin.api.Pinyin;
+ * 排序和分组各只需要一次遍历
+ */
+class LayoutIndex
+{
+public:
+    // 返回不带声调的小写拼音,非汉字原样保留
+    QString pinyin(const QString &title);
+
+    // grouped 为 true 时按拼音排序并在每个首字母前插入分组项,否则按当前语言的排序规则排序
+    void build(const QMap<QString, QString> &layouts, bool grouped,
+               QList<LayoutIndexItem> &items, QList<QString> &letters);
+
+private:
+    // 汉字 -> 拼音,同一个字只查一次
+    QHash<QChar, QString> m_table;
+};
+
+}
+}
+
+#endif // LAYOUTINDEX_H
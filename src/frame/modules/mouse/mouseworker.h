@@ -48,6 +48,9 @@ class MouseWorker : public QObject
     Q_OBJECT
 public:
     explicit MouseWorker(MouseModel *model, QObject *parent = 0);
+
+    // 鼠标、触控板和指点杆都由 InputDevices 服务提供
+    static QStringList sessionServices();
     void active();
     void deactive();
     void init();
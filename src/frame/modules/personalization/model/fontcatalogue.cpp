@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "fontcatalogue.h"
+
+#include <QCollator>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <algorithm>
+#include <vector>
+
+using namespace dcc;
+using namespace dcc::personalization;
+
+QList<QJsonObject> FontCatalogue::parse(const QString &type, const QByteArray &json)
+{
+    const QJsonArray &array = QJsonDocument::fromJson(json).array();
+
+    QList<QJsonObject> list;
+    list.reserve(array.size());
+    for (const QJsonValue &value : array) {
+        QJsonObject object = value.toObject();
+        object.insert("type", QJsonValue(type));
+        list.append(object);
+    }
+
+    sortByName(list);
+    return list;
+}
+
+void FontCatalogue::sortByName(QList<QJsonObject> &list)
+{
+    QCollator collator;
+    std::vector<std::pair<QCollatorSortKey, int>> keys;
+    keys.reserve(static_cast<size_t>(list.size()));
+    for (int i = 0; i < list.size(); ++i)
+        keys.emplace_back(collator.sortKey(list.at(i)["Name"].toString()), i);
+
+    std::sort(keys.begin(), keys.end(), [](const std::pair<QCollatorSortKey, int> &a, const std::pair<QCollatorSortKey, int> &b) {
+        return a.first.compare(b.first) < 0;
+    });
+
+    QList<QJsonObject> sorted;
+    sorted.reserve(list.size());
+    for (const auto &key : keys)
+        sorted.append(list.at(key.second));
+    list.swap(sorted);
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FONTCATALOGUE_H
+#define FONTCATALOGUE_H
+
+#include <QList>
+#include <QJsonObject>
+
+namespace dcc
+{
+namespace personalization
+{
+/**
+ * @brief The FontCatalogue class 解析 Appearance 服务返回的字体信息
+ * 按显示名称排序时每个名称只生成一次 QCollatorSortKey, 安装了大量字体时排序不会成为瓶颈
+ */
+class FontCatalogue
+{
+public:
+    static QList<QJsonObject> parse(const QString &type, const QByteArray &json);
+    static void sortByName(QList<QJsonObject> &list);
+};
+}
+}
+
+#endif // FONTCATALOGUE_H
@@ -27,8 +27,11 @@
 #include "model/thememodel.h"
 #include "model/fontmodel.h"
 #include "model/fontsizemodel.h"
+#include "model/fontcatalogue.h"
 
 #include <QGuiApplication>
+#include <QFutureWatcher>
+#include <QtConcurrent>
 #include <QScreen>
 #include <QDebug>
 
@@ -147,17 +150,6 @@ void PersonalizationWork::deactive()
     m_wmSwitcher->blockSignals(true);
 }
 
-QList<QJsonObject> PersonalizationWork::converToList(const QString &type, const QJsonArray &array)
-{
-    QList<QJsonObject> list;
-    for (int i = 0; i != array.size(); i++) {
-        QJsonObject object = array.at(i).toObject();
-        object.insert("type", QJsonValue(type));
-        list.append(object);
-    }
-    return list;
-}
-
 void PersonalizationWork::addList(ThemeModel *model, const QString &type, const QJsonArray &array)
 {
     QList<QString> list;
@@ -208,12 +200,16 @@ void PersonalizationWork::onGetFontFinished(QDBusPendingCallWatcher *w)
 {
     QDBusPendingReply<QString> reply = *w;
 
-    if (!reply.isError()) {
-        const QString &category = w->property("category").toString();
+    const QString &category = w->property("category").toString();
+    const int generation = w->property("generation").toInt();
 
-        setFontList(m_fontModels[category], category, reply.value());
+    if (generation != m_fontGeneration.value(category)) {
+        // 获取过程中字体有变化,已经重新获取
+    } else if (!reply.isError()) {
+        setFontList(m_fontModels[category], category, reply.value(), generation);
     } else {
         qDebug() << reply.error();
+        finishFontLoad(category, generation);
     }
 
     w->deleteLater();
@@ -270,7 +266,11 @@ void PersonalizationWork::onRefreshedChanged(const QString &type)
         refreshThemeByType(type);
     }
 
-    if (m_fontModels.keys().contains(type)) {
+    if (m_fontModels.contains(type)) {
+        // 字体有变化时缓存的字体列表和正在获取的结果都失效
+        ++m_fontGeneration[type];
+        m_fontLoaded.remove(type);
+        m_fontLoading.remove(type);
         refreshFontByType(type);
     }
 }
@@ -305,9 +305,9 @@ void PersonalizationWork::onGetCurrentWMFinished(QDBusPendingCallWatcher *w)
     w->deleteLater();
 }
 
-void PersonalizationWork::setFontList(FontModel *model, const QString &type, const QString &list)
+void PersonalizationWork::setFontList(FontModel *model, const QString &type, const QString &list, int generation)
 {
-    QJsonArray array = QJsonDocument::fromJson(list.toLocal8Bit().data()).array();
+    QJsonArray array = QJsonDocument::fromJson(list.toUtf8()).array();
 
     QStringList l;
 
@@ -317,21 +317,25 @@ void PersonalizationWork::setFontList(FontModel *model, const QString &type, con
     QDBusPendingCallWatcher *watcher  = new QDBusPendingCallWatcher(m_dbus->Show(type, l), this);
 
     connect(watcher, &QDBusPendingCallWatcher::finished, this, [=] (QDBusPendingCallWatcher *w) {
-        if (!w->isError()) {
+        if (generation != m_fontGeneration.value(type)) {
+            // 已经过期,等待新的结果
+        } else if (!w->isError()) {
             QDBusPendingReply<QString> r = w->reply();
 
-            QJsonArray arrayValue = QJsonDocument::fromJson(r.value().toLocal8Bit().data()).array();
-
-            QList<QJsonObject> list = converToList(type, arrayValue);
-            // sort for display name
-            std::sort(list.begin(), list.end(), [=] (const QJsonObject &obj1, const QJsonObject &obj2) {
-                QCollator qc;
-                return qc.compare(obj1["Name"].toString(), obj2["Name"].toString()) < 0;
+            // 字体较多时解析和排序都比较耗时, 放到后台线程中
+            QFutureWatcher<QList<QJsonObject>> *parseWatcher = new QFutureWatcher<QList<QJsonObject>>(this);
+            connect(parseWatcher, &QFutureWatcher<QList<QJsonObject>>::finished, this, [=] {
+                if (generation == m_fontGeneration.value(type)) {
+                    model->setFontList(parseWatcher->result());
+                    m_fontLoaded.insert(type);
+                    finishFontLoad(type, generation);
+                }
+                parseWatcher->deleteLater();
             });
-
-            model->setFontList(list);
+            parseWatcher->setFuture(QtConcurrent::run(&FontCatalogue::parse, type, r.value().toUtf8()));
         } else {
             qDebug() << w->error();
+            finishFontLoad(type, generation);
         }
 
         watcher->deleteLater();
@@ -356,7 +360,9 @@ void PersonalizationWork::refreshThemeByType(const QString &type)
 void PersonalizationWork::refreshFont()
 {
     for (QMap<QString, FontModel *>::const_iterator it = m_fontModels.begin(); it != m_fontModels.end(); it++) {
-        refreshFontByType(it.key());
+        // 字体列表在收到 Refreshed 信号前一直有效, 再次进入页面时不需要重新获取
+        if (!m_fontLoaded.contains(it.key()))
+            refreshFontByType(it.key());
     }
 
     FontSizeChanged(m_dbus->fontSize());
@@ -364,12 +370,25 @@ void PersonalizationWork::refreshFont()
 
 void PersonalizationWork::refreshFontByType(const QString &type)
 {
+    // 同一种字体同时只获取一次
+    if (m_fontLoading.contains(type))
+        return;
+
+    m_fontLoading.insert(type);
     QDBusPendingReply<QString> font = m_dbus->List(type);
     QDBusPendingCallWatcher *fontWatcher = new QDBusPendingCallWatcher(font, this);
     fontWatcher->setProperty("category", type);
+    fontWatcher->setProperty("generation", m_fontGeneration.value(type));
     connect(fontWatcher, &QDBusPendingCallWatcher::finished, this, &PersonalizationWork::onGetFontFinished);
 }
 
+void PersonalizationWork::finishFontLoad(const QString &type, int generation)
+{
+    // 只有当前版本的获取结束后才允许再次获取
+    if (generation == m_fontGeneration.value(type))
+        m_fontLoading.remove(type);
+}
+
 void PersonalizationWork::refreshActiveColor(const QString &color)
 {
     m_model->setActiveColor(color);
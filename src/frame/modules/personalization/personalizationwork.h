@@ -31,6 +31,7 @@
 #include <QDebug>
 #include <QStringList>
 #include <QMap>
+#include <QSet>
 #include <QString>
 #include <QJsonObject>
 #include <QGSettings>
@@ -79,7 +80,7 @@ private Q_SLOTS:
     void onRefreshedChanged(const QString &type);
     void onToggleWM(const QString &wm);
     void onGetCurrentWMFinished(QDBusPendingCallWatcher *w);
-    void setFontList(FontModel* model, const QString &type, const QString &list);
+    void setFontList(FontModel* model, const QString &type, const QString &list, int generation);
     void onCompositingAllowSwitch(bool value);
     void onWindowWM(bool value);
 
@@ -87,11 +88,11 @@ private:
     int sizeToSliderValue(const double value) const;
     double sliderValueToSize(const int value) const;
     double sliderValutToOpacity(const int value) const;
-    QList<QJsonObject> converToList(const QString &type, const QJsonArray &array);
     void addList(ThemeModel *model, const QString &type, const QJsonArray &array);
     void refreshWMState();
     void refreshThemeByType(const QString &type);
     void refreshFontByType(const QString &type);
+    void finishFontLoad(const QString &type, int generation);
     void refreshOpacity(double opacity);
     void refreshActiveColor(const QString &color);
     bool allowSwitchWM();
@@ -107,6 +108,12 @@ private:
     Effects *m_effects;
     QMap<QString, ThemeModel*> m_themeModels;
     QMap<QString, FontModel*> m_fontModels;
+    // 已经获取到字体列表的类型
+    QSet<QString> m_fontLoaded;
+    // 正在获取字体列表的类型
+    QSet<QString> m_fontLoading;
+    // 每种字体的列表版本,收到 Refreshed 时加一,旧版本的异步结果直接丢弃
+    QMap<QString, int> m_fontGeneration;
     QGSettings *m_setting;
 };
 }
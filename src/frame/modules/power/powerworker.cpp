@@ -37,12 +37,26 @@
 using namespace dcc;
 using namespace dcc::power;
 
+const QString PowerService("com.deepin.daemon.Power");
+const QString SysPowerService("com.deepin.system.Power");
+const QString Login1Service("org.freedesktop.login1");
+
+QStringList PowerWorker::sessionServices()
+{
+    return { PowerService };
+}
+
+QStringList PowerWorker::systemServices()
+{
+    return { SysPowerService, Login1Service };
+}
+
 PowerWorker::PowerWorker(PowerModel *model, QObject *parent)
     : QObject(parent)
     , m_powerModel(model)
-    , m_powerInter(new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
-    , m_sysPowerInter(new SysPowerInter("com.deepin.system.Power", "/com/deepin/system/Power", QDBusConnection::systemBus(), this))
-    , m_login1ManagerInter(new Login1ManagerInter("org.freedesktop.login1", "/org/freedesktop/login1", QDBusConnection::systemBus(), this))
+    , m_powerInter(new PowerInter(PowerService, "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this))
+    , m_sysPowerInter(new SysPowerInter(SysPowerService, "/com/deepin/system/Power", QDBusConnection::systemBus(), this))
+    , m_login1ManagerInter(new Login1ManagerInter(Login1Service, "/org/freedesktop/login1", QDBusConnection::systemBus(), this))
 {
     m_powerInter->setSync(false);
     m_sysPowerInter->setSync(false);
@@ -45,6 +45,10 @@ class PowerWorker : public QObject
 public:
     explicit PowerWorker(PowerModel *model, QObject *parent = 0);
 
+    // 构造时访问的 DBus 服务
+    static QStringList sessionServices();
+    static QStringList systemServices();
+
     void active();
     void deactive();
 
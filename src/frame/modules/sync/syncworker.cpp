@@ -13,6 +13,17 @@ using namespace dcc;
 using namespace dcc::cloudsync;
 
 static QString SYNC_INTERFACE = "com.deepin.sync.Daemon";
+static QString LICENSE_SERVICE = "com.deepin.license";
+
+QStringList SyncWorker::sessionServices()
+{
+    return { SYNC_INTERFACE };
+}
+
+QStringList SyncWorker::systemServices()
+{
+    return { LICENSE_SERVICE };
+}
 
 SyncWorker::SyncWorker(SyncModel *model, QObject *parent)
     : QObject(parent)
@@ -30,7 +41,7 @@ SyncWorker::SyncWorker(SyncModel *model, QObject *parent)
                                           "sa{sv}as",
                                           this, SLOT(userInfoChanged(QDBusMessage)));
 
-    m_activeInfo = new QDBusInterface("com.deepin.license",
+    m_activeInfo = new QDBusInterface(LICENSE_SERVICE,
                                       "/com/deepin/license/Info",
                                       "com.deepin.license.Info",
                                       QDBusConnection::systemBus(),this);
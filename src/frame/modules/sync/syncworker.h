@@ -19,6 +19,10 @@ class SyncWorker : public QObject, public ModuleWorker
 public:
     explicit SyncWorker(SyncModel * model, QObject *parent = nullptr);
 
+    // 构造时访问的 DBus 服务
+    static QStringList sessionServices();
+    static QStringList systemServices();
+
     virtual void activate();
     virtual void deactivate();
 
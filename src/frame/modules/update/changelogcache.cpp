@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "changelogcache.h"
+
+#include <QtConcurrent>
+#include <QFileSystemWatcher>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDebug>
+
+namespace dcc {
+namespace update {
+
+ChangeLogCache::ChangeLogCache(const QString &path, QObject *parent)
+    : QObject(parent)
+    , m_path(path)
+    , m_size(-1)
+    , m_pending(false)
+    , m_fileWatcher(new QFileSystemWatcher(this))
+    , m_parseWatcher(new QFutureWatcher<ChangeLogData>(this))
+{
+    // 更新日志通常随软件包整体替换,同时监听所在目录,文件被重新创建后也能收到通知
+    const QFileInfo fileInfo(m_path);
+    if (fileInfo.dir().exists())
+        m_fileWatcher->addPath(fileInfo.absolutePath());
+    if (fileInfo.exists())
+        m_fileWatcher->addPath(m_path);
+
+    connect(m_fileWatcher, &QFileSystemWatcher::fileChanged, this, &ChangeLogCache::onFileChanged);
+    connect(m_fileWatcher, &QFileSystemWatcher::directoryChanged, this, &ChangeLogCache::onFileChanged);
+    connect(m_parseWatcher, &QFutureWatcher<ChangeLogData>::finished, this, [this] {
+        // 结果可能已经在 data() 中取走
+        if (m_pending) {
+            m_data = m_parseWatcher->result();
+            m_pending = false;
+        }
+        Q_EMIT changed();
+    });
+
+    reload();
+}
+
+ChangeLogData ChangeLogCache::parse(const QString &path)
+{
+    ChangeLogData data;
+
+    QFile logFile(path);
+    if (!logFile.open(QFile::ReadOnly)) {
+        qDebug() << "can not find update file:" << path;
+        return data;
+    }
+
+    const QJsonObject &object = QJsonDocument::fromJson(logFile.readAll()).object();
+
+    const QJsonObject &systemInfo = object.value("systemInfo").toObject();
+    for (auto it = systemInfo.begin(); it != systemInfo.end(); ++it) {
+        if (it.key() == "update_time") {
+            data.updateTime = it.value().toString();
+        } else {
+            data.systemInfo.insert(it.key(), it.value().toString());
+        }
+    }
+
+    const QJsonArray &apps = object.value("appInfo").toArray();
+    for (const QJsonValue &app : apps) {
+        const QJsonObject &appObject = app.toObject();
+        const QString &packageId = appObject.value("package_id").toString();
+
+        // 同一个包出现多次时以最后一条为准
+        QHash<QString, QString> &logs = data.appInfo[packageId];
+        logs.clear();
+        for (auto it = appObject.begin(); it != appObject.end(); ++it) {
+            if (it.value().isString())
+                logs.insert(it.key(), it.value().toString());
+        }
+    }
+
+    return data;
+}
+
+QString ChangeLogCache::changelog(const QString &packageId, const QString &language)
+{
+    return data().appInfo.value(packageId).value(language);
+}
+
+QString ChangeLogCache::systemChangelog(const QString &language)
+{
+    return data().systemInfo.value(language);
+}
+
+QString ChangeLogCache::systemUpdateTime()
+{
+    return data().updateTime;
+}
+
+void ChangeLogCache::reload()
+{
+    const QFileInfo fileInfo(m_path);
+    m_lastModified = fileInfo.lastModified();
+    m_size = fileInfo.exists() ? fileInfo.size() : -1;
+
+    m_pending = true;
+    m_parseWatcher->setFuture(QtConcurrent::run(&ChangeLogCache::parse, m_path));
+}
+
+void ChangeLogCache::onFileChanged()
+{
+    const QFileInfo fileInfo(m_path);
+    if (fileInfo.exists() && !m_fileWatcher->files().contains(m_path))
+        m_fileWatcher->addPath(m_path);
+
+    const qint64 size = fileInfo.exists() ? fileInfo.size() : -1;
+    if (size == m_size && fileInfo.lastModified() == m_lastModified)
+        return;
+
+    qDebug() << "update file changed, reload:" << m_path;
+    reload();
+}
+
+const ChangeLogData &ChangeLogCache::data()
+{
+    // 解析结果还没有取走时直接使用,解析没有完成则等待;
+    // 后台线程结束但 finished 信号还没有送达时也要在这里取结果
+    if (m_pending) {
+        m_parseWatcher->waitForFinished();
+        m_data = m_parseWatcher->result();
+        m_pending = false;
+    }
+
+    return m_data;
+}
+
+}
+}
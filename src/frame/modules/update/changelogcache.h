@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHANGELOGCACHE_H
+#define CHANGELOGCACHE_H
+
+#include <QObject>
+#include <QHash>
+#include <QDateTime>
+#include <QFutureWatcher>
+
+class QFileSystemWatcher;
+
+namespace dcc {
+namespace update {
+
+// 更新日志文件 UpdateInfo.json 的解析结果
+struct ChangeLogData {
+    QString updateTime;                                 // systemInfo 中的 update_time
+    QHash<QString, QString> systemInfo;                 // 语言 -> 系统更新日志
+    QHash<QString, QHash<QString, QString>> appInfo;    // package_id -> (语言 -> 应用更新日志)
+};
+
+/**
+ * @brief The ChangeLogCache class 更新日志缓存
+ * 在后台线程解析一次更新日志文件,按 package_id 和语言建立索引;
+ * 文件被修改或替换后自动重新解析
+ */
+class ChangeLogCache : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ChangeLogCache(const QString &path, QObject *parent = nullptr);
+
+    static ChangeLogData parse(const QString &path);
+
+    // 后台解析还没有完成时会等待解析结束
+    QString changelog(const QString &packageId, const QString &language);
+    QString systemChangelog(const QString &language);
+    QString systemUpdateTime();
+
+Q_SIGNALS:
+    void changed();
+
+private:
+    void reload();
+    void onFileChanged();
+    const ChangeLogData &data();
+
+private:
+    QString m_path;
+    QDateTime m_lastModified;
+    qint64 m_size;
+    // 有还没有取走的解析结果
+    bool m_pending;
+    QFileSystemWatcher *m_fileWatcher;
+    QFutureWatcher<ChangeLogData> *m_parseWatcher;
+    ChangeLogData m_data;
+};
+
+}
+}
+
+#endif // CHANGELOGCACHE_H
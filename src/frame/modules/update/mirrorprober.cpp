@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mirrorprober.h"
+
+#include <QNetworkAccessManager>
+#include <QNetworkRequest>
+#include <QNetworkReply>
+#include <QTimer>
+#include <QUrl>
+#include <QDebug>
+
+namespace dcc {
+namespace update {
+
+const int MirrorProber::TimeoutLatency;
+
+MirrorProber::MirrorProber(QObject *parent)
+    : QObject(parent)
+    , m_manager(new QNetworkAccessManager(this))
+    , m_maxConcurrency(8)
+    , m_timeout(5000)
+    , m_cacheTtl(10 * 60 * 1000)
+{
+    m_clock.start();
+}
+
+void MirrorProber::probe(const QList<QPair<QString, QString>> &mirrors)
+{
+    cancel();
+
+    const qint64 now = m_clock.elapsed();
+    for (const auto &mirror : mirrors) {
+        auto it = m_cache.constFind(mirror.second);
+        if (it != m_cache.cend() && now - it->time < m_cacheTtl) {
+            Q_EMIT resultReady(mirror.first, it->latency);
+            continue;
+        }
+
+        m_queue << mirror;
+    }
+
+    if (!isRunning()) {
+        Q_EMIT finished();
+        return;
+    }
+
+    while (!m_queue.isEmpty() && m_replies.size() < m_maxConcurrency)
+        startNext();
+}
+
+void MirrorProber::cancel()
+{
+    m_queue.clear();
+
+    // abort 会同步触发 finished,先取出所有请求再逐个终止
+    const QList<QNetworkReply *> replies = m_replies.keys();
+    m_replies.clear();
+    for (QNetworkReply *reply : replies) {
+        reply->disconnect(this);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+void MirrorProber::startNext()
+{
+    const QPair<QString, QString> mirror = m_queue.takeFirst();
+
+    QNetworkRequest request(QUrl(mirror.second));
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    QNetworkReply *reply = m_manager->head(request);
+    m_replies.insert(reply, Request { mirror.first, mirror.second, m_clock.elapsed() });
+
+    connect(reply, &QNetworkReply::finished, this, [this, reply] {
+        onReplyFinished(reply);
+    });
+    QTimer::singleShot(m_timeout, reply, &QNetworkReply::abort);
+}
+
+void MirrorProber::onReplyFinished(QNetworkReply *reply)
+{
+    reply->deleteLater();
+    if (!m_replies.contains(reply))
+        return;
+
+    const Request request = m_replies.take(reply);
+
+    // 收到了 HTTP 响应(包括 404、重定向等)即认为镜像源可以访问
+    int latency = TimeoutLatency;
+    if (reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid())
+        latency = qMin(static_cast<int>(m_clock.elapsed() - request.start), TimeoutLatency - 1);
+
+    qDebug() << "speed of url" << request.url << "is" << latency;
+
+    // 失败可能只是网络的短暂波动,不缓存,重新测速时再试一次
+    if (latency < TimeoutLatency)
+        m_cache.insert(request.url, CacheEntry { latency, m_clock.elapsed() });
+    else
+        m_cache.remove(request.url);
+    Q_EMIT resultReady(request.id, latency);
+
+    if (!m_queue.isEmpty()) {
+        startNext();
+    } else if (m_replies.isEmpty()) {
+        Q_EMIT finished();
+    }
+}
+
+}
+}
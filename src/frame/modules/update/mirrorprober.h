@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIRRORPROBER_H
+#define MIRRORPROBER_H
+
+#include <QObject>
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QElapsedTimer>
+
+class QNetworkAccessManager;
+class QNetworkReply;
+
+namespace dcc {
+namespace update {
+
+/**
+ * @brief The MirrorProber class 镜像源测速
+ * 对每个镜像源发送 HEAD 请求,以收到响应的耗时作为延迟;同时进行的请求数有上限,
+ * 每个请求单独超时,成功的测速结果在有效期内缓存,重新测速时直接使用
+ */
+class MirrorProber : public QObject
+{
+    Q_OBJECT
+public:
+    // 超时或无法连接时的结果,与界面中"超时"的判断保持一致
+    static const int TimeoutLatency = 10000;
+
+    explicit MirrorProber(QObject *parent = nullptr);
+
+    void setMaxConcurrency(int count) { m_maxConcurrency = qMax(1, count); }
+    void setTimeout(int msec) { m_timeout = msec; }
+    void setCacheTtl(int msec) { m_cacheTtl = msec; }
+
+    // mirrors 为 (id, url),会取消上一次未完成的测速
+    void probe(const QList<QPair<QString, QString>> &mirrors);
+    void cancel();
+    bool isRunning() const { return !m_queue.isEmpty() || !m_replies.isEmpty(); }
+
+Q_SIGNALS:
+    void resultReady(const QString &id, int latency);
+    void finished();
+
+private:
+    struct Request {
+        QString id;
+        QString url;
+        qint64 start;
+    };
+
+    struct CacheEntry {
+        int latency;
+        qint64 time;
+    };
+
+    void startNext();
+    void onReplyFinished(QNetworkReply *reply);
+
+private:
+    QNetworkAccessManager *m_manager;
+    QList<QPair<QString, QString>> m_queue;
+    QHash<QNetworkReply *, Request> m_replies;
+    QHash<QString, CacheEntry> m_cache;    // url -> 测速结果
+    QElapsedTimer m_clock;
+    int m_maxConcurrency;
+    int m_timeout;
+    int m_cacheTtl;
+};
+
+}
+}
+
+#endif // MIRRORPROBER_H
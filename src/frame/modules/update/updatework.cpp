@@ -24,6 +24,8 @@
  */
 
 #include "updatework.h"
+#include "changelogcache.h"
+#include "mirrorprober.h"
 #include "window/utils.h"
 #include "widgets/utils.h"
 #include <QtConcurrent>
@@ -41,47 +43,24 @@ const QString ChangeLogFile = "/usr/share/deepin/release-note/UpdateInfo.json";
 // 系统补丁标识
 const QString DDEId = "dde";
 
+const QString SessionHelperService("com.deepin.LastoreSessionHelper");
+const QString LastoreService("com.deepin.lastore");
+const QString SmartMirrorService("com.deepin.lastore.Smartmirror");
+const QString RecoveryService("com.deepin.ABRecovery");
+const QString PowerService("com.deepin.daemon.Power");
+const QString NetworkService("com.deepin.daemon.Network");
+const QString AppearanceService("com.deepin.daemon.Appearance");
+
 namespace dcc {
 namespace update {
-static int TestMirrorSpeedInternal(const QString &url, QPointer<QObject> baseObject)
+QStringList UpdateWorker::sessionServices()
 {
-    if (!baseObject || QCoreApplication::closingDown()) {
-        return -1;
-    }
-
-    QStringList args;
-    args << url << "-s" << "1";
-
-    QProcess process;
-    process.start("netselect", args);
-
-    if (!process.waitForStarted()) {
-        return 10000;
-    }
-
-    do {
-        if (!baseObject || QCoreApplication::closingDown()) {
-            process.kill();
-            process.terminate();
-            process.waitForFinished(1000);
-
-            return -1;
-        }
-
-        if (process.waitForFinished(500))
-            break;
-    } while (process.state() == QProcess::Running);
-
-    const QString output = process.readAllStandardOutput().trimmed();
-    const QStringList result = output.split(' ');
-
-    qDebug() << "speed of url" << url << "is" << result.first();
-
-    if (!result.first().isEmpty()) {
-        return result.first().toInt();
-    }
+    return { SessionHelperService, PowerService, NetworkService, AppearanceService };
+}
 
-    return 10000;
+QStringList UpdateWorker::systemServices()
+{
+    return { LastoreService, SmartMirrorService, RecoveryService };
 }
 
 UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
@@ -102,6 +81,8 @@ UpdateWorker::UpdateWorker(UpdateModel *model, QObject *parent)
     , m_downloadSize(0)
     , m_iconThemeState("")
     , m_beginUpdatesJob(false)
+    , m_changeLogCache(nullptr)
+    , m_mirrorProber(nullptr)
 {
 
 }
@@ -115,15 +96,17 @@ void UpdateWorker::init() {
     qRegisterMetaType<UpdatesStatus>("UpdatesStatus");
     qRegisterMetaType<UiActiveState>("UiActiveState");
 
-    m_lastoresessionHelper = new LastoressionHelper("com.deepin.LastoreSessionHelper", "/com/deepin/LastoreSessionHelper", QDBusConnection::sessionBus(), this);
-    m_updateInter = new UpdateInter("com.deepin.lastore", "/com/deepin/lastore", QDBusConnection::systemBus(), this);
-    m_managerInter = new ManagerInter("com.deepin.lastore", "/com/deepin/lastore", QDBusConnection::systemBus(), this);
-    m_powerInter = new PowerInter("com.deepin.daemon.Power", "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this);
+    m_lastoresessionHelper = new LastoressionHelper(SessionHelperService, "/com/deepin/LastoreSessionHelper", QDBusConnection::sessionBus(), this);
+    m_updateInter = new UpdateInter(LastoreService, "/com/deepin/lastore", QDBusConnection::systemBus(), this);
+    m_managerInter = new ManagerInter(LastoreService, "/com/deepin/lastore", QDBusConnection::systemBus(), this);
+    m_powerInter = new PowerInter(PowerService, "/com/deepin/daemon/Power", QDBusConnection::sessionBus(), this);
     m_powerSystemInter = new PowerSystemInter("com.deepin.system.Power", "/com/deepin/system/Power", QDBusConnection::sessionBus(), this);
-    m_networkInter = new Network("com.deepin.daemon.Network", "/com/deepin/daemon/Network", QDBusConnection::sessionBus(), this);
-    m_smartMirrorInter = new SmartMirrorInter("com.deepin.lastore.Smartmirror", "/com/deepin/lastore/Smartmirror", QDBusConnection::systemBus(), this);
-    m_abRecoveryInter = new RecoveryInter("com.deepin.ABRecovery", "/com/deepin/ABRecovery", QDBusConnection::systemBus(), this);
-    m_iconTheme = new Appearance("com.deepin.daemon.Appearance", "/com/deepin/daemon/Appearance", QDBusConnection::sessionBus(), this);
+    m_networkInter = new Network(NetworkService, "/com/deepin/daemon/Network", QDBusConnection::sessionBus(), this);
+    m_smartMirrorInter = new SmartMirrorInter(SmartMirrorService, "/com/deepin/lastore/Smartmirror", QDBusConnection::systemBus(), this);
+    m_abRecoveryInter = new RecoveryInter(RecoveryService, "/com/deepin/ABRecovery", QDBusConnection::systemBus(), this);
+    m_iconTheme = new Appearance(AppearanceService, "/com/deepin/daemon/Appearance", QDBusConnection::sessionBus(), this);
+    // 提前在后台解析更新日志,检查更新完成时直接从缓存中读取
+    m_changeLogCache = new ChangeLogCache(ChangeLogFile, this);
 
     m_managerInter->setSync(false);
     m_updateInter->setSync(false);
@@ -704,55 +687,30 @@ void UpdateWorker::setSourceCheck(bool enable)
 
 void UpdateWorker::testMirrorSpeed()
 {
-    QList<MirrorInfo> mirrors = m_model->mirrorInfos();
+    if (!m_mirrorProber) {
+        m_mirrorProber = new MirrorProber(this);
+        connect(m_mirrorProber, &MirrorProber::resultReady, this, [this](const QString &id, int latency) {
+            QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
+            speedInfo[id] = latency;
+            m_model->setMirrorSpeedInfo(speedInfo);
+        });
+    }
 
-    QStringList urlList;
-    for (MirrorInfo &info : mirrors) {
-        urlList << info.m_url;
+    QList<QPair<QString, QString>> mirrors;
+    for (const MirrorInfo &info : m_model->mirrorInfos()) {
+        mirrors << qMakePair(info.m_id, info.m_url);
     }
 
     // reset the data;
     m_model->setMirrorSpeedInfo(QMap<QString, int>());
 
-    QFutureWatcher<int> *watcher = new QFutureWatcher<int>();
-    connect(watcher, &QFutureWatcher<int>::resultReadyAt, [this, urlList, watcher, mirrors](int index) {
-        QMap<QString, int> speedInfo = m_model->mirrorSpeedInfo();
-
-        int result = watcher->resultAt(index);
-        QString mirrorId = mirrors.at(index).m_id;
-        speedInfo[mirrorId] = result;
-
-        m_model->setMirrorSpeedInfo(speedInfo);
-    });
-
-    QPointer<QObject> guest(this);
-    QFuture<int> future = QtConcurrent::mapped(urlList, std::bind(TestMirrorSpeedInternal, std::placeholders::_1, guest));
-    watcher->setFuture(future);
+    m_mirrorProber->probe(mirrors);
 }
 
 void UpdateWorker::checkNetselect()
 {
-    QProcess *process = new QProcess;
-    process->start("netselect", QStringList() << "127.0.0.1");
-    connect(process, &QProcess::errorOccurred, this, [this, process](QProcess::ProcessError error) {
-        if ((error == QProcess::FailedToStart) || (error == QProcess::Crashed)) {
-            m_model->setNetselectExist(false);
-            process->deleteLater();
-        }
-    });
-    connect(process, static_cast<void (QProcess::*)(int)>(&QProcess::finished), this, [this, process](int result) {
-        bool isNetselectExist = false;
-        if (result == 0) {
-            isNetselectExist = true;
-        } else {
-            isNetselectExist = false;
-        }
-        if (!isNetselectExist) {
-            qDebug() << "[wubw UpdateWorker] netselect 127.0.0.1 : " << isNetselectExist;
-        }
-        m_model->setNetselectExist(isNetselectExist);
-        process->deleteLater();
-    });
+    // 测速由 MirrorProber 在进程内完成,不再依赖 netselect
+    m_model->setNetselectExist(true);
 }
 
 void UpdateWorker::setSmartMirror(bool enable)
@@ -1124,24 +1082,11 @@ AppUpdateInfo UpdateWorker::getInfo(const AppUpdateInfo &packageInfo, const QStr
     info.m_icon = m_iconThemeState;
 
     const QString &language = QLocale::system().name();
-    QFile logFile(ChangeLogFile);
-    if (!logFile.open(QFile::ReadOnly)) {
-        qDebug() << "can not find update file:" << ChangeLogFile;
-        return info;
-    }
-
-    const QJsonObject &object = QJsonDocument::fromJson(logFile.readAll()).object();
-
     if (info.m_packageId == DDEId) {
-        info.m_changelog = object.value("systemInfo").toObject().value(language).toString();
-        info.m_avilableVersion = object.value("systemInfo").toObject().value("update_time").toString();
+        info.m_changelog = m_changeLogCache->systemChangelog(language);
+        info.m_avilableVersion = m_changeLogCache->systemUpdateTime();
     } else {
-        const QJsonArray &apps = object.value("appInfo").toArray();
-        for (auto itApp = apps.begin(); itApp != apps.end(); ++itApp) {
-            if (itApp->toObject().value("package_id").toString() == info.m_packageId) {
-                info.m_changelog = itApp->toObject().value(language).toString();
-            }
-        }
+        info.m_changelog = m_changeLogCache->changelog(info.m_packageId, language);
     }
 
     return info;
@@ -54,6 +54,8 @@ using RecoveryInter = com::deepin::ABRecovery;
 using Appearance = com::deepin::daemon::Appearance;
 namespace dcc{
 namespace update{
+class ChangeLogCache;
+class MirrorProber;
 
 struct CheckUpdateJobRet {
     QString status;
@@ -66,6 +68,10 @@ class UpdateWorker : public QObject
     Q_OBJECT
 public:
     explicit UpdateWorker(UpdateModel *model, QObject *parent = nullptr);
+
+    // init 时访问的 DBus 服务
+    static QStringList sessionServices();
+    static QStringList systemServices();
     ~UpdateWorker();
     void activate();
     void deactivate();
@@ -163,6 +169,8 @@ private:
     qulonglong m_downloadSize;
     QString m_iconThemeState;
     bool m_beginUpdatesJob;
+    ChangeLogCache *m_changeLogCache;
+    MirrorProber *m_mirrorProber;
 };
 }
 }
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "accesspointtable.h"
+
+#include <algorithm>
+
+AccessPoint AccessPoint::fromJson(const QJsonObject &info)
+{
+    AccessPoint ap;
+    ap.ssid = info.value("Ssid").toString();
+    ap.path = info.value("Path").toString();
+    ap.strength = info.value("Strength").toInt();
+    ap.secured = info.value("Secured").toBool();
+    if (info.value("SecuredInEap").toBool())
+        ap.flags |= SecuredInEap;
+
+    return ap;
+}
+
+void AccessPointTable::setDevices(const QList<const QObject *> &devices)
+{
+    QHash<const QObject *, Section> sections;
+    for (const QObject *device : devices)
+        sections.insert(device, m_sections.value(device));
+
+    m_devices = devices;
+    m_sections.swap(sections);
+    m_rowsValid = false;
+}
+
+int AccessPointTable::count(const QObject *device) const
+{
+    const Section *s = section(device);
+    return s ? s->aps.size() : 0;
+}
+
+const AccessPoint *AccessPointTable::accessPoint(const QObject *device, int index) const
+{
+    const Section *s = section(device);
+    if (!s || index < 0 || index >= s->aps.size())
+        return nullptr;
+
+    return &s->aps.at(index);
+}
+
+int AccessPointTable::indexOfPath(const QObject *device, const QString &path) const
+{
+    const Section *s = section(device);
+    if (!s)
+        return -1;
+
+    index(*s);
+    return s->paths.value(path, -1);
+}
+
+int AccessPointTable::indexOfSsid(const QObject *device, const QString &ssid) const
+{
+    const Section *s = section(device);
+    if (!s)
+        return -1;
+
+    index(*s);
+    return s->ssids.value(ssid, -1);
+}
+
+void AccessPointTable::append(const QObject *device, const AccessPoint &ap)
+{
+    auto it = m_sections.find(device);
+    if (it == m_sections.end())
+        return;
+
+    it->aps.append(ap);
+    invalidate(*it);
+}
+
+void AccessPointTable::prepend(const QObject *device, const AccessPoint &ap)
+{
+    auto it = m_sections.find(device);
+    if (it == m_sections.end())
+        return;
+
+    it->aps.prepend(ap);
+    invalidate(*it);
+}
+
+void AccessPointTable::replace(const QObject *device, int index, const AccessPoint &ap)
+{
+    auto it = m_sections.find(device);
+    if (it == m_sections.end() || index < 0 || index >= it->aps.size())
+        return;
+
+    AccessPoint &old = it->aps[index];
+    // rows stay where they are, only the lookup tables may change
+    if (old.path != ap.path || old.ssid != ap.ssid)
+        it->indexed = false;
+    old = ap;
+}
+
+void AccessPointTable::remove(const QObject *device, int index)
+{
+    auto it = m_sections.find(device);
+    if (it == m_sections.end() || index < 0 || index >= it->aps.size())
+        return;
+
+    it->aps.remove(index);
+    invalidate(*it);
+}
+
+void AccessPointTable::sort(const QObject *device, const QString &activeSsid)
+{
+    auto it = m_sections.find(device);
+    if (it == m_sections.end())
+        return;
+
+    std::stable_sort(it->aps.begin(), it->aps.end(), [&](const AccessPoint &a, const AccessPoint &b) {
+        // make sure active ap is the first one of ap list
+        const bool aIsActive = a.ssid == activeSsid;
+        if (aIsActive || b.ssid == activeSsid)
+            return aIsActive && b.ssid != activeSsid;
+        return a.strength > b.strength;
+    });
+    it->indexed = false;
+}
+
+int AccessPointTable::rowCount() const
+{
+    buildRows();
+    return m_rows.size();
+}
+
+AccessPointTable::Row AccessPointTable::row(int row) const
+{
+    buildRows();
+    return m_rows.value(row);
+}
+
+int AccessPointTable::rowOf(const QObject *device, int index) const
+{
+    buildRows();
+    auto it = m_offsets.constFind(device);
+    if (it == m_offsets.cend())
+        return -1;
+
+    return it.value() + index + 1;
+}
+
+const AccessPointTable::Section *AccessPointTable::section(const QObject *device) const
+{
+    auto it = m_sections.constFind(device);
+    return it == m_sections.cend() ? nullptr : &it.value();
+}
+
+void AccessPointTable::index(const Section &section) const
+{
+    if (section.indexed)
+        return;
+
+    section.paths.clear();
+    section.ssids.clear();
+    section.paths.reserve(section.aps.size());
+    section.ssids.reserve(section.aps.size());
+    for (int i = 0; i < section.aps.size(); ++i) {
+        const AccessPoint &ap = section.aps.at(i);
+        section.paths.insert(ap.path, i);
+        // keep the first one when several aps share the same ssid
+        if (!section.ssids.contains(ap.ssid))
+            section.ssids.insert(ap.ssid, i);
+    }
+    section.indexed = true;
+}
+
+void AccessPointTable::invalidate(Section &section)
+{
+    section.indexed = false;
+    m_rowsValid = false;
+}
+
+void AccessPointTable::buildRows() const
+{
+    if (m_rowsValid)
+        return;
+
+    m_rows.clear();
+    m_offsets.clear();
+    for (const QObject *device : m_devices) {
+        const Section *s = section(device);
+        m_offsets.insert(device, m_rows.size());
+
+        Row header;
+        header.device = device;
+        m_rows.append(header);
+
+        for (int i = 0; i < s->aps.size(); ++i) {
+            Row row;
+            row.device = device;
+            row.ap = i;
+            m_rows.append(row);
+        }
+    }
+
+    // "connect to hidden network"
+    m_rows.append(Row());
+    m_rowsValid = true;
+}
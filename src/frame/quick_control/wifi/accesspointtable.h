@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACCESSPOINTTABLE_H
+#define ACCESSPOINTTABLE_H
+
+#include <QString>
+#include <QVector>
+#include <QList>
+#include <QHash>
+#include <QJsonObject>
+
+class QObject;
+
+struct AccessPoint
+{
+    enum Flag {
+        SecuredInEap = 0x1,
+    };
+
+    QString ssid;
+    QString path;
+    int strength = 0;
+    bool secured = false;
+    uint flags = 0;
+
+    static AccessPoint fromJson(const QJsonObject &info);
+};
+
+// Access points of all wireless devices, flattened into list rows:
+// a header row for each device followed by its access points, and a
+// trailing "connect to hidden network" row. The row table is rebuilt
+// lazily, only after a structural change.
+class AccessPointTable
+{
+public:
+    struct Row
+    {
+        // nullptr for the hidden network row
+        const QObject *device = nullptr;
+        // -1 for the device header row
+        int ap = -1;
+    };
+
+    // keeps the access points of devices which are still in the list
+    void setDevices(const QList<const QObject *> &devices);
+    const QList<const QObject *> &devices() const { return m_devices; }
+    bool contains(const QObject *device) const { return m_sections.contains(device); }
+
+    int count(const QObject *device) const;
+    const AccessPoint *accessPoint(const QObject *device, int index) const;
+    int indexOfPath(const QObject *device, const QString &path) const;
+    int indexOfSsid(const QObject *device, const QString &ssid) const;
+
+    void append(const QObject *device, const AccessPoint &ap);
+    void prepend(const QObject *device, const AccessPoint &ap);
+    void replace(const QObject *device, int index, const AccessPoint &ap);
+    void remove(const QObject *device, int index);
+    // active ap first, then by strength
+    void sort(const QObject *device, const QString &activeSsid);
+
+    int rowCount() const;
+    Row row(int row) const;
+    // row of the device header when index is -1
+    int rowOf(const QObject *device, int index = -1) const;
+
+private:
+    struct Section
+    {
+        QVector<AccessPoint> aps;
+        mutable QHash<QString, int> paths;
+        mutable QHash<QString, int> ssids;
+        mutable bool indexed = false;
+    };
+
+    const Section *section(const QObject *device) const;
+    void index(const Section &section) const;
+    void invalidate(Section &section);
+    void buildRows() const;
+
+private:
+    QList<const QObject *> m_devices;
+    QHash<const QObject *, Section> m_sections;
+
+    mutable QVector<Row> m_rows;
+    mutable QHash<const QObject *, int> m_offsets;
+    mutable bool m_rowsValid = false;
+};
+
+#endif // ACCESSPOINTTABLE_H
@@ -29,7 +29,6 @@
 
 #include <QPainter>
 #include <QDebug>
-#include <QJsonObject>
 #include <QDateTime>
 
 WifiListDelegate::WifiListDelegate(QObject *parent)
@@ -86,9 +85,8 @@ void WifiListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &opti
 
     if (!isHeader && !isTips)
     {
-        const QJsonObject info = index.data(WifiListModel::ItemInfoRole).value<QJsonObject>();
-        const bool isSecured = info.value("Secured").toBool();
-        const int strength = info.value("Strength").toInt();
+        const bool isSecured = index.data(WifiListModel::ItemSecuredRole).toBool();
+        const int strength = index.data(WifiListModel::ItemStrengthRole).toInt();
 
         // draw signal icon
         const int iconIndex = (strength / 10) & ~0x1;
@@ -58,16 +58,8 @@ int WifiListModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
 
-    int count = 0;
-    for (auto it(m_apInfoList.cbegin()); it != m_apInfoList.cend(); ++it)
-    {
-        if (!it.key()->enabled())
-            continue;
-        count += it.value().size() + 1;
-    }
-
-    // +1 for "connect to hidden network"
-    return count + 1;
+    // device headers, aps, and +1 for "connect to hidden network"
+    return m_aps.rowCount();
 }
 
 QVariant WifiListModel::data(const QModelIndex &index, int role) const
@@ -75,52 +67,57 @@ QVariant WifiListModel::data(const QModelIndex &index, int role) const
     if (!index.isValid())
         return QVariant();
 
-    const ItemInfo info = indexInfo(index.row());
+    const AccessPointTable::Row row = m_aps.row(index.row());
+    const WirelessDevice *dev = static_cast<const WirelessDevice *>(row.device);
+    const AccessPoint *ap = m_aps.accessPoint(row.device, row.ap);
+    const bool powerOff = m_aps.rowCount() == 1;
 
     switch (role) {
     case Qt::DisplayRole:
     {
-        if (rowCount(QModelIndex()) == 1)
+        if (powerOff)
             return tr("Click icon to enable WLAN");
 
-        if (!info.info && info.device)
-            return deviceName(info.device);
-        else if (!info.device)
+        if (!ap && dev)
+            return deviceName(dev);
+        else if (!dev)
             return tr("Connect to hidden network");
         else
-            return info.info->value("Ssid");
+            return ap->ssid;
     }
     case Qt::SizeHintRole:
-        if (rowCount(QModelIndex()) == 1)
+        if (powerOff)
             return QSize(0, 36);
-        if (!info.info)
+        if (!ap)
             return QSize(0, 24);
         else
             return QSize(0, 36);
-    case ItemInfoRole:
-        return info.info ? *info.info : QVariant();
+    case ItemStrengthRole:
+        return ap ? ap->strength : QVariant();
+    case ItemSecuredRole:
+        return ap ? ap->secured : QVariant();
     case ItemHoveredRole:
         return index == m_currentIndex;
     case ItemIsHeaderRole:
-        return !info.info && info.device;
+        return !ap && dev;
     case ItemIsActiveRole:
-        return info.info && static_cast<const WirelessDevice *>(info.device)->activeConnName() == info.info->value("Ssid").toString();
+        return ap && dev->activeConnName() == ap->ssid;
     case ItemIsActivatingRole:
-        return m_refreshTimer->isActive() && info.info && m_activatingSsid == info.info->value("Ssid").toString();
+        return m_refreshTimer->isActive() && ap && m_activatingSsid == ap->ssid;
     case ItemDevicePathRole:
-        return info.device->path();
+        return dev ? dev->path() : QVariant();
     case ItemApPathRole:
-        return info.info ? info.info->value("Path") : QVariant();
+        return ap ? ap->path : QVariant();
     case ItemUuidRole:
-        return info.info ? m_networkModel->connectionUuidByApInfo(static_cast<const WirelessDevice *>(info.device), info.info->value("Ssid").toString()) : QVariant();
+        return ap ? m_networkModel->connectionUuidByApInfo(dev, ap->ssid) : QVariant();
     case ItemIsHiddenTipsRole:
-        return !info.info && !info.device;
+        return !dev;
     case ItemNextRole:
         return m_currentIndex.row() + 1 == index.row();
     case ItemIsPowerOffRole:
-        return rowCount(QModelIndex()) == 1;
+        return powerOff;
     case ItemCountRole:
-        return m_apInfoList.keys().count();
+        return m_aps.devices().size();
     default:;
     }
 
@@ -139,9 +136,10 @@ void WifiListModel::setCurrentActivating(const QModelIndex &index)
     const QModelIndex oldIndex = m_activatingIndex;
 
     m_activatingIndex = index;
-    const ItemInfo &info = indexInfo(index.row());
-    if (info.info) {
-        m_activatingSsid = info.info->value("Ssid").toString();
+    const AccessPointTable::Row row = m_aps.row(index.row());
+    const AccessPoint *ap = m_aps.accessPoint(row.device, row.ap);
+    if (ap) {
+        m_activatingSsid = ap->ssid;
     } else {
         m_activatingSsid = QString();
     }
@@ -149,56 +147,16 @@ void WifiListModel::setCurrentActivating(const QModelIndex &index)
     emit dataChanged(oldIndex, oldIndex);
 }
 
-int WifiListModel::indexOf(dde::network::WirelessDevice * const dev) const
+void WifiListModel::updateDevices(const QList<NetworkDevice *> &devices)
 {
-    int pos = 0;
-    for (auto *d : m_networkModel->devices())
+    QList<const QObject *> list;
+    for (auto *dev : devices)
     {
-        if (d->type() != NetworkDevice::Wireless || !d->enabled())
-            continue;
-
-        pos += m_apInfoList[static_cast<WirelessDevice *>(d)].size() + 1;
-
-        if (d == dev)
-            break;
+        if (dev->type() == NetworkDevice::Wireless && dev->enabled())
+            list << dev;
     }
 
-    return pos;
-}
-
-const ItemInfo WifiListModel::indexInfo(const int index) const
-{
-    ItemInfo info;
-    int r = index;
-    for (auto *dev : m_networkModel->devices())
-    {
-        if (dev->type() != NetworkDevice::Wireless || !dev->enabled())
-            continue;
-
-        WirelessDevice *d = static_cast<WirelessDevice *>(dev);
-        if (!m_apInfoList.contains(d))
-            continue;
-
-        info.device = dev;
-
-        if (!r)
-            return info;
-        else
-            --r;
-
-        const int s = m_apInfoList[d].size();
-        if (r < s)
-        {
-            info.info = &m_apInfoList[d][r];
-            return info;
-        } else {
-            r -= s;
-        }
-    }
-
-    info.device = nullptr;
-
-    return info;
+    m_aps.setDevices(list);
 }
 
 const QString WifiListModel::deviceName(const NetworkDevice *wirelessDevice) const
@@ -228,7 +186,7 @@ void WifiListModel::onDeviceListChanged(const QList<NetworkDevice *> &devices)
 
         WirelessDevice *d = static_cast<WirelessDevice *>(dev);
 
-        if (m_apInfoList.contains(d))
+        if (m_aps.contains(d))
             continue;
 
         connect(d, &WirelessDevice::enableChanged, this, &WifiListModel::onDeviceEnableChanged, Qt::UniqueConnection);
@@ -242,17 +200,10 @@ void WifiListModel::onDeviceListChanged(const QList<NetworkDevice *> &devices)
         emit requestDeviceApList(d->path());
     }
 
-    // removed devices
-    QList<WirelessDevice *> removedDeviceList;
-    for (auto it(m_apInfoList.cbegin()); it != m_apInfoList.cend(); ++it)
-        if (!devices.contains(it.key()))
-            removedDeviceList.append(it.key());
-    for (auto *d : removedDeviceList)
-        m_apInfoList.remove(d);
-
-    sortApList();
-
-    emit layoutChanged();
+    // aps of removed devices are dropped
+    beginResetModel();
+    updateDevices(devices);
+    endResetModel();
 }
 
 void WifiListModel::onDeviceApAdded(const QJsonObject &info)
@@ -260,43 +211,40 @@ void WifiListModel::onDeviceApAdded(const QJsonObject &info)
     WirelessDevice *dev = static_cast<WirelessDevice *>(sender());
     Q_ASSERT(dev);
 
-    if (!dev->enabled())
+    if (!dev->enabled() || !m_aps.contains(dev))
         return;
 
-    const auto &path = info.value("Path").toString();
-    const auto &ssid = info.value("Ssid").toString();
-    const auto &strength = info.value("Strength").toInt();
-
-    // test if ap already exist.
-    int row = indexOf(dev);
-    auto &list = m_apInfoList[dev];
-    for (int i(0); i != list.size(); ++i) {
-        const auto &mAp = list.at(i);
-        // same Path means same ap, return
-        if (mAp.value("Path").toString() == path)
-            return;
-        // different Path but use the same Ssid, then compare Theirs Strength
-        else if (mAp.value("Ssid").toString() == ssid) {
-            if (mAp.value("Strength").toInt() < strength) {
-                row += i + 1;
-                list.replace(i, info);
-                auto changedIndex = index(row);
-                Q_EMIT dataChanged(changedIndex, changedIndex);
-            }
-            return;
+    const AccessPoint ap = AccessPoint::fromJson(info);
+
+    // same Path means same ap, return
+    if (m_aps.indexOfPath(dev, ap.path) != -1)
+        return;
+
+    // different Path but use the same Ssid, then compare Theirs Strength
+    const int same = m_aps.indexOfSsid(dev, ap.ssid);
+    if (same != -1) {
+        if (m_aps.accessPoint(dev, same)->strength < ap.strength) {
+            m_aps.replace(dev, same, ap);
+            auto changedIndex = index(m_aps.rowOf(dev, same));
+            Q_EMIT dataChanged(changedIndex, changedIndex);
         }
+        return;
     }
 
     // reach here means it is a new ap need to add
+    const int row = m_aps.rowOf(dev, m_aps.count(dev));
     beginInsertRows(QModelIndex(), row, row);
-    if (info.value("Ssid").toString() == dev->activeConnName()) {
+    if (ap.ssid == dev->activeConnName()) {
         m_activeConnNameMap.insert(dev, dev->activeConnName());
-        m_apInfoList[dev].insert(0, info);
+        m_aps.prepend(dev, ap);
     } else {
-        m_apInfoList[dev].append(info);
+        m_aps.append(dev, ap);
     }
-    sortApList();
+    m_aps.sort(dev, m_activeConnNameMap.value(dev));
     endInsertRows();
+
+    // the new ap is sorted into place, rows after it moved down
+    Q_EMIT dataChanged(index(m_aps.rowOf(dev, 0)), index(m_aps.rowOf(dev, m_aps.count(dev) - 1)));
 }
 
 void WifiListModel::onDeviceApInfoChanged(const QJsonObject &info)
@@ -307,18 +255,14 @@ void WifiListModel::onDeviceApInfoChanged(const QJsonObject &info)
     if (!dev->enabled())
         return;
 
-    int row = indexOf(dev);
-    auto &list = m_apInfoList[dev];
-    for (int i(0); i != list.size(); ++i)
+    const AccessPoint ap = AccessPoint::fromJson(info);
+    const int i = m_aps.indexOfPath(dev, ap.path);
+    if (i != -1)
     {
-        if (list[i].value("Path").toString() == info.value("Path").toString())
-        {
-            row += i + 1;
-            list.replace(i, info);
-            auto changedIndex = index(row);
-            Q_EMIT dataChanged(changedIndex, changedIndex);
-            return;
-        }
+        m_aps.replace(dev, i, ap);
+        auto changedIndex = index(m_aps.rowOf(dev, i));
+        Q_EMIT dataChanged(changedIndex, changedIndex);
+        return;
     }
 
     // reach here means it is a new ap need to add
@@ -327,20 +271,14 @@ void WifiListModel::onDeviceApInfoChanged(const QJsonObject &info)
 
 void WifiListModel::onDeviceApRemoved(dde::network::WirelessDevice *dev, const QJsonObject &apInfo)
 {
-    int row = indexOf(dev);
+    const int i = m_aps.indexOfPath(dev, apInfo.value("Path").toString());
+    if (i == -1)
+        return;
 
-    const auto list = m_apInfoList[dev];
-    for (int i(0); i != list.size(); ++i)
-    {
-        if (list[i].value("Path").toString() == apInfo.value("Path").toString())
-        {
-            row += i + 1;
-            beginRemoveRows(QModelIndex(), row, row);
-            m_apInfoList[dev].removeAt(i);
-            endRemoveRows();
-            return;
-        }
-    }
+    const int row = m_aps.rowOf(dev, i);
+    beginRemoveRows(QModelIndex(), row, row);
+    m_aps.remove(dev, i);
+    endRemoveRows();
 }
 
 void WifiListModel::onDeviceStateChanged(const NetworkDevice::DeviceStatus &stat)
@@ -362,28 +300,15 @@ void WifiListModel::onDeviceActiveApChanged(const QJsonObject &oldApInfo, const
     Q_ASSERT(dev);
 
     const QString &activeConnName = newApInfo["ConnectionName"].toString();
-    const auto list = m_apInfoList[dev];
-    for (int i(0); i != list.size(); ++i)
-    {
-        if (list[i].value("Ssid").toString() == activeConnName)
-        {
-            m_activeConnNameMap.insert(dev, activeConnName);
-
-            // pass if already first line
-            if (i)
-            {
-                const auto info = m_apInfoList[dev][i];
-//                beginMoveRows(QModelIndex(), i, i, QModelIndex(), 0);
-                m_apInfoList[dev].removeOne(info);
-                m_apInfoList[dev].insert(0, info);
-//                endMoveRows();
-            }
-
-            sortApList();
-            emit layoutChanged();
-            return;
-        }
-    }
+    if (m_aps.indexOfSsid(dev, activeConnName) == -1)
+        return;
+
+    m_activeConnNameMap.insert(dev, activeConnName);
+
+    // active ap is sorted to the first line
+    emit layoutAboutToBeChanged();
+    m_aps.sort(dev, activeConnName);
+    emit layoutChanged();
 }
 
 void WifiListModel::refershActivatingIndex()
@@ -391,45 +316,15 @@ void WifiListModel::refershActivatingIndex()
     emit dataChanged(m_activatingIndex, m_activatingIndex);
 }
 
-void WifiListModel::sortApList()
-{
-    QString *activeSsid = new QString();
-
-    auto cmpFunc = [=](const QJsonObject &a, const QJsonObject &b) {
-        // make sure active ap is the first one of ap list
-        bool aIsActive = (a.value("Ssid").toString() == *activeSsid);
-        if (aIsActive || b.value("Ssid").toString() == *activeSsid) {
-            return aIsActive;
-        }
-        return a.value("Strength").toInt() > b.value("Strength").toInt();
-    };
-
-    for (auto dev : m_apInfoList.keys()) {
-        *activeSsid = m_activeConnNameMap.value(dev);
-        QList<QJsonObject> list = m_apInfoList.value(dev);
-        std::sort(list.begin(), list.end(), cmpFunc);
-        m_apInfoList.insert(dev, list);
-    }
-
-    delete activeSsid;
-}
-
 void WifiListModel::onDeviceEnableChanged(const bool enable)
 {
     WirelessDevice *d = static_cast<WirelessDevice*>(sender());
     Q_ASSERT(d);
 
-    if (enable) {
-        const int pos = rowCount(QModelIndex());
-        beginInsertRows(QModelIndex(), pos, pos);
-        m_apInfoList.insert(d, QList<QJsonObject>());
-        endInsertRows();
+    beginResetModel();
+    updateDevices(m_networkModel->devices());
+    endResetModel();
 
+    if (enable)
         emit requestDeviceApList(d->path());
-    } else {
-        const int pos = indexOf(d);
-        beginRemoveRows(QModelIndex(), pos, pos + m_apInfoList[d].length());
-        m_apInfoList.remove(d);
-        endRemoveRows();
-    }
 }
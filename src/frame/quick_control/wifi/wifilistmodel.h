@@ -26,6 +26,8 @@
 #ifndef WIFILISTMODEL_H
 #define WIFILISTMODEL_H
 
+#include "accesspointtable.h"
+
 #include <QAbstractListModel>
 #include <QTimer>
 
@@ -38,12 +40,6 @@ class WirelessDevice;
 }
 }
 
-struct ItemInfo
-{
-    const dde::network::NetworkDevice *device = nullptr;
-    const QJsonObject *info = nullptr;
-};
-
 class WifiListModel : public QAbstractListModel
 {
     Q_OBJECT
@@ -54,7 +50,8 @@ public:
         UnusedRole = Qt::UserRole,
         ItemHoveredRole,
         ItemIsHeaderRole,
-        ItemInfoRole,
+        ItemStrengthRole,
+        ItemSecuredRole,
         ItemIsActiveRole,
         ItemIsActivatingRole,
         ItemApPathRole,
@@ -79,8 +76,7 @@ signals:
     void requestDeviceApList(const QString &devPath) const;
 
 private:
-    int indexOf(dde::network::WirelessDevice * const dev) const;
-    const ItemInfo indexInfo(const int index) const;
+    void updateDevices(const QList<dde::network::NetworkDevice *> &devices);
     const QString deviceName(const dde::network::NetworkDevice *wirelessDevice) const;
 
     void onDeviceListChanged(const QList<dde::network::NetworkDevice *> &devices);
@@ -91,7 +87,6 @@ private:
     void onDeviceActiveApChanged(const QJsonObject &oldApInfo, const QJsonObject &newApInfo);
 
     void refershActivatingIndex();
-    void sortApList();
 
 private:
     void onDeviceEnableChanged(const bool enable);
@@ -105,7 +100,7 @@ private:
 
     QTimer *m_refreshTimer;
 
-    QMap<dde::network::WirelessDevice *, QList<QJsonObject>> m_apInfoList;
+    AccessPointTable m_aps;
     QMap<dde::network::WirelessDevice *, QString> m_activeConnNameMap;
 };
 
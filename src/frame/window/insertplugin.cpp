@@ -21,17 +21,70 @@
 #include "insertplugin.h"
 
 #include <QGSettings>
+#include <QStandardPaths>
+#include <QFile>
+#include <QJsonDocument>
+#include <QDateTime>
 
 #include <DStandardItem>
 
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
+// 插件元数据缓存,以插件文件的修改时间和大小判断是否过期
+const QString PluginCacheFile = "plugins.json";
+const int PluginCacheVersion = 1;
 
 using namespace DCC_NAMESPACE;
 DWIDGET_USE_NAMESPACE
 
 QPointer<InsertPlugin> InsertPlugin::INSTANCE = nullptr;
 
+namespace {
+QString pluginCachePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/" + PluginCacheFile;
+}
+
+QJsonObject loadPluginCache()
+{
+    QFile file(pluginCachePath());
+    if (!file.open(QIODevice::ReadOnly))
+        return QJsonObject();
+
+    const QJsonObject &cache = QJsonDocument::fromJson(file.readAll()).object();
+    if (cache.value("version").toInt() != PluginCacheVersion)
+        return QJsonObject();
+
+    return cache.value("plugins").toObject();
+}
+
+void savePluginCache(const QJsonObject &plugins)
+{
+    const QString &path = pluginCachePath();
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "can not write plugin cache" << path;
+        return;
+    }
+
+    QJsonObject cache;
+    cache.insert("version", PluginCacheVersion);
+    cache.insert("plugins", plugins);
+    file.write(QJsonDocument(cache).toJson(QJsonDocument::Compact));
+}
+
+bool isCacheValid(const QJsonObject &record, const QFileInfo &fileInfo)
+{
+    return !record.isEmpty()
+           && record.value("mtime").toVariant().toLongLong() == fileInfo.lastModified().toMSecsSinceEpoch()
+           && record.value("size").toVariant().toLongLong() == fileInfo.size();
+}
+}
+
 InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
+    : m_parent(obj)
+    , m_frameProxy(frameProxy)
 {
     QDir moduleDir(ModuleDirectory);
     if (!moduleDir.exists()) {
@@ -39,6 +92,9 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         return;
     }
 
+    const QJsonObject &cache = loadPluginCache();
+    QJsonObject plugins;
+
     auto moduleList = moduleDir.entryInfoList();
     for (auto i : moduleList) {
         QString path = i.absoluteFilePath();
@@ -46,47 +102,109 @@ InsertPlugin::InsertPlugin(QObject *obj, FrameProxyInterface *frameProxy)
         if (!QLibrary::isLibrary(path))
             continue;
 
-        qDebug() << "loading module: " << i;
+        PluginInfo info;
+        info.file = path;
 
-        QPluginLoader loader(path);
-        const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
-        if (!compareVersion(meta.value("api").toString(), "1.0.0")) {
-            qDebug() << "plugin's version is too low";
-            continue;
+        QJsonObject record = cache.value(path).toObject();
+        if (!isCacheValid(record, i)) {
+            qDebug() << "reading module metadata: " << i;
+            record = readMetaData(i, info);
+            // 加载失败的插件不缓存,下次启动时重试
+            if (record.isEmpty())
+                continue;
         }
+        plugins.insert(path, record);
 
-        QObject *instance = loader.instance();
-        if (!instance) {
-            qDebug() << loader.errorString();
+        if (!compareVersion(record.value("api").toString(), "1.0.0")) {
+            qDebug() << "plugin's version is too low";
             continue;
         }
 
-        instance->setParent(obj);
+        info.name = record.value("name").toString();
+        info.plugin.path = record.value("path").toString();
+        info.plugin.follow = record.value("follow").toString();
+        info.plugin.enabled = record.value("enabled").toBool();
 
-        auto *module = qobject_cast<ModuleInterface *>(instance);
-        if (!module) {
-            return;
-        }
-        qDebug() << "load plugin Name;" << module->name() << module->displayName();
-        module->setFrameProxy(frameProxy);
+        m_allModules.push_back(info);
+    }
+
+    if (plugins != cache)
+        savePluginCache(plugins);
+}
+
+QJsonObject InsertPlugin::readMetaData(const QFileInfo &fileInfo, PluginInfo &info)
+{
+    // metaData() 只读取插件文件中的 json,不会 dlopen 插件
+    QPluginLoader loader(fileInfo.absoluteFilePath());
+    const QJsonObject &meta = loader.metaData().value("MetaData").toObject();
+
+    QJsonObject record;
+    record.insert("mtime", fileInfo.lastModified().toMSecsSinceEpoch());
+    record.insert("size", fileInfo.size());
+    record.insert("api", meta.value("api").toString());
+
+    if (!compareVersion(meta.value("api").toString(), "1.0.0"))
+        return record;
+
+    if (meta.contains("name") && meta.contains("path") && meta.contains("follow") && meta.contains("enabled")) {
+        record.insert("name", meta.value("name").toString());
+        record.insert("path", meta.value("path").toString());
+        record.insert("follow", meta.value("follow").toVariant().toString());
+        record.insert("enabled", meta.value("enabled").toBool());
+        return record;
+    }
+
+    auto *module = loadInstance(info);
+    if (!module)
+        return QJsonObject();
+
+    record.insert("name", module->name());
+    record.insert("path", module->path());
+    record.insert("follow", module->follow());
+    record.insert("enabled", module->enabled());
+    return record;
+}
 
-        Plugin plugin;
-        plugin.path = module->path();
-        plugin.follow = module->follow();
-        plugin.enabled = module->enabled();
+ModuleInterface *InsertPlugin::loadInstance(PluginInfo &info)
+{
+    if (info.instance)
+        return qobject_cast<ModuleInterface *>(info.instance);
+
+    qDebug() << "loading module: " << info.file;
+
+    QPluginLoader loader(info.file);
+    QObject *instance = loader.instance();
+    if (!instance) {
+        qDebug() << loader.errorString();
+        return nullptr;
+    }
+
+    instance->setParent(m_parent);
 
-        m_allModules.push_back({plugin, {instance, module->name()}});
+    auto *module = qobject_cast<ModuleInterface *>(instance);
+    if (!module) {
+        return nullptr;
     }
+    qDebug() << "load plugin Name;" << module->name() << module->displayName();
+    module->setFrameProxy(m_frameProxy);
+
+    info.instance = instance;
+    return module;
 }
 
 bool InsertPlugin::needPushPlugin(QString moduleName)
 {
     m_currentPlugins.clear();
 
-    for (auto pluginSetting : m_allModules) {
-        if (pluginSetting.first.path == moduleName) {
-            m_currentPlugins << pluginSetting;
-        }
+    for (PluginInfo &info : m_allModules) {
+        if (info.plugin.path != moduleName)
+            continue;
+
+        // 页面需要插入插件时才加载插件,未启用的插件不会被插入,也不需要加载
+        if (!info.plugin.enabled || !loadInstance(info))
+            continue;
+
+        m_currentPlugins << qMakePair(info.plugin, qMakePair(info.instance, info.name));
     }
 
     return !m_currentPlugins.isEmpty();
@@ -102,9 +220,9 @@ InsertPlugin *InsertPlugin::instance(QObject *obj, FrameProxyInterface *FramePro
 
 /**
  * @brief dccV20::InsertPlugin::pushPlugin 加载一级菜单插件
- * @param modules 一级菜单所有模块，将插件添加到其中
+ * @param registry 一级菜单所有模块，将插件添加到其中
  */
-void dccV20::InsertPlugin::pushPlugin(QList<QPair<dccV20::ModuleInterface *, QString>> &modules)
+void dccV20::InsertPlugin::pushPlugin(dccV20::ModuleRegistry *registry)
 {
     // 一级菜单插件配置mainwindow
     for (int i = 0; i < m_currentPlugins.size(); i++) {
@@ -122,25 +240,23 @@ void dccV20::InsertPlugin::pushPlugin(QList<QPair<dccV20::ModuleInterface *, QSt
         if (!ok) {
             // 字符串为空时，默认置底
             if (m_currentPlugins.at(i).first.follow.isEmpty()) {
-                modules.append({module, module->displayName()});
+                registry->insert(registry->count(), module);
                 return;
             }
 
             // 遍历modules查找插入位置
-            auto res = std::find_if(modules.begin(), modules.end(), [=](const QPair<ModuleInterface *, QString> &data) -> bool {
-                return data.first->name() == m_currentPlugins.at(i).first.follow;
-            });
+            const int res = registry->indexOf(m_currentPlugins.at(i).first.follow);
 
             // 若未找到则不添加插件
-            if (res != modules.end()) {
-                modules.insert(modules.indexOf(*res) + 1, {module, module->displayName()});
+            if (res != -1) {
+                registry->insert(res + 1, module);
             } else {
                 qWarning() << "insert module failed, no module named " << module->follow();
-                modules.append({module, module->displayName()});
+                registry->insert(registry->count(), module);
             }
         } else {
             // 为数字时直接插入到指定位置
-            modules.insert(index, {module, module->displayName()});
+            registry->insert(index, module);
         }
     }
 }
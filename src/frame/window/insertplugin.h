@@ -27,9 +27,11 @@
 #include <QPluginLoader>
 #include <QStandardItemModel>
 #include <QJsonObject>
+#include <QFileInfo>
 
 #include "interface/moduleinterface.h"
 #include "window/utils.h"
+#include "window/moduleregistry.h"
 
 namespace DCC_NAMESPACE {
 
@@ -47,16 +49,31 @@ public:
     // 查询改模块是否需要加载插件
     bool needPushPlugin(QString moduleName);
     // 一级菜单插入插件
-    void pushPlugin(QList<QPair<ModuleInterface *, QString>> &modules);
+    void pushPlugin(ModuleRegistry *registry);
     // 二级菜单插入插件
     void pushPlugin(QStandardItemModel *Model, QList<ListSubItem> &itemList);
     // 获取单例
     static InsertPlugin *instance(QObject *obj = nullptr, FrameProxyInterface *interface = nullptr);
 
+private:
+    // 插件的元数据,instance 在插件第一次被需要时才加载
+    struct PluginInfo {
+        Plugin plugin;
+        QString file;
+        QString name;
+        QObject *instance{nullptr};
+    };
+
+    // 读取插件的元数据,json 中没有 path/follow/enabled 的旧插件需要加载一次后从接口获取
+    QJsonObject readMetaData(const QFileInfo &fileInfo, PluginInfo &info);
+    ModuleInterface *loadInstance(PluginInfo &info);
+
 private:
     static QPointer<InsertPlugin> INSTANCE;
-    // 保存加载的所有插件
-    QList<QPair<Plugin, QPair<QObject *, QString>>> m_allModules;
+    QObject *m_parent;
+    FrameProxyInterface *m_frameProxy;
+    // 保存所有插件的元数据
+    QList<PluginInfo> m_allModules;
     // 保存插入到某个模块的所有插件
     QList<QPair<Plugin, QPair<QObject *, QString>>> m_currentPlugins;
 };
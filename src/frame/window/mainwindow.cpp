@@ -38,9 +38,17 @@
 #include "modules/network/networkmodule.h"
 #include "modules/defapp/defaultappsmodule.h"
 #include "modules/update/mirrorswidget.h"
+#include "modules/sync/syncworker.h"
+#include "modules/display/displayworker.h"
+#include "modules/bluetooth/bluetoothworker.h"
+#include "modules/power/powerworker.h"
+#include "modules/mouse/mouseworker.h"
+#include "window/modules/wacom/wacomworker.h"
+#include "window/modules/commoninfo/commoninfowork.h"
 #include "widgets/multiselectlistview.h"
 #include "mainwindow.h"
 #include "insertplugin.h"
+#include "startupscheduler.h"
 #include "constant.h"
 #include "search/searchwidget.h"
 #include "dtitlebar.h"
@@ -65,6 +73,8 @@
 #include <QScreen>
 #include <QMouseEvent>
 #include <QResizeEvent>
+#include <QJsonDocument>
+#include <QFile>
 
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::search;
@@ -76,6 +86,8 @@ const QByteArray ControlCenterGSettings = "com.deepin.dde.control-center";
 const QString GSettinsWindowWidth = "window-width";
 const QString GSettinsWindowHeight = "window-height";
 const QString ModuleDirectory = "/usr/lib/dde-control-center/modules";
+// 设置该环境变量为文件路径时,启动完成后将 Chrome trace 格式的启动时间线写入该文件
+const char *StartupTraceEnv = "DCC_STARTUP_TRACE";
 
 static int WidgetMinimumWidth = 820;
 static int WidgetMinimumHeight = 634;
@@ -101,6 +113,8 @@ MainWindow::MainWindow(QWidget *parent)
     , m_navView(nullptr)
     , m_rightView(nullptr)
     , m_navModel(nullptr)
+    , m_modules(new ModuleRegistry)
+    , m_scheduler(new StartupScheduler(m_modules, this))
     , m_bIsFinalWidget(false)
     , m_bIsFromSecondAddWidget(false)
     , m_topWidget(nullptr)
@@ -168,6 +182,12 @@ MainWindow::MainWindow(QWidget *parent)
     titlebar->addWidget(m_searchWidget, Qt::AlignCenter);
     connect(m_searchWidget, &SearchWidget::notifyModuleSearch, this, &MainWindow::onEnterSearchWidget);
 
+    connect(m_scheduler, &StartupScheduler::moduleLoaded, this, [this](int index) {
+        ModuleInterface *inter = m_modules->instance(index);
+        setModuleVisible(inter, inter->isAvailable());
+    });
+    connect(m_scheduler, &StartupScheduler::finished, this, &MainWindow::exportStartupReport);
+
     auto menu = titlebar->menu();
     if (!menu) {
         qDebug() << "menu is nullptr, create menu!";
@@ -227,11 +247,7 @@ MainWindow::~MainWindow()
     gs.set(GSettinsWindowHeight, height());
 
     qDebug() << "~MainWindow";
-    for (auto m : m_modules) {
-        if (m.first) {
-            delete m.first;
-        }
-    }
+    delete m_modules;
 
     QScroller *scroller = QScroller::scroller(m_navView->viewport());
     if (scroller) {
@@ -331,29 +347,47 @@ void MainWindow::initAllModule(const QString &m)
     if (DSysInfo::isCommunityEdition())
         idType = "Deepin ID";
 
-    m_modules = {
-        { new AccountsModule(this), tr("Accounts")},
+    // probe 为 true 的模块在启动时通过 preInitialize 探测设备/服务是否存在并更新导航和搜索数据,
+    // 其余模块在第一次进入或搜索时再创建
+    const QList<ModuleMetadata> modules = {
+        { "accounts", tr("Accounts"), {}, {}, false, [this] { return new AccountsModule(this); } },
         // 原union ID 暂时隐藏
-        // { new UnionidModule(this), "Union ID"},
+        // { "unionid", "Union ID", {}, {}, true, [this] { return new UnionidModule(this); } },
         //~ contents_path /cloudsync/Cloud Sync
-        { new SyncModule(this), idType},
-        { new DisplayModule(this), tr("Display")},
-        { new DefaultAppsModule(this), tr("Default Applications")},
-        { new PersonalizationModule(this), tr("Personalization")},
-        { new NetworkModule(this), tr("Network")},
-        { new NotificationModule(this), tr("Notification")},
-        { new SoundModule(this), tr("Sound")},
-        { new BluetoothModule(this), tr("Bluetooth")},
-        { new DatetimeModule(this), tr("Date and Time")},
-        { new PowerModule(this), tr("Power")},
-        { new MouseModule(this), tr("Mouse")},
-        { new WacomModule(this), tr("Drawing Tablet")},
-        { new KeyboardModule(this), tr("Keyboard and Language")},
-        { new UpdateModule(this), tr("Updates")},
-        { new SystemInfoModule(this), tr("System Info")},
-        { new CommonInfoModule(this), tr("General Settings")},
+        { "cloudsync", idType, {}, {}, true, [this] { return new SyncModule(this); },
+          dcc::cloudsync::SyncWorker::sessionServices(), dcc::cloudsync::SyncWorker::systemServices() },
+        { "display", tr("Display"), {}, {}, false, [this] { return new DisplayModule(this); },
+          dcc::display::DisplayWorker::sessionServices(), {} },
+        { "defapp", tr("Default Applications"), {}, {}, false, [this] { return new DefaultAppsModule(this); } },
+        { "personalization", tr("Personalization"), {}, {}, false, [this] { return new PersonalizationModule(this); } },
+        { "network", tr("Network"), {}, {}, true, [this] { return new NetworkModule(this); },
+          NetworkModule::sessionServices(), {} },
+        { "notification", tr("Notification"), {}, {}, false, [this] { return new NotificationModule(this); } },
+        { "sound", tr("Sound"), {}, {}, false, [this] { return new SoundModule(this); } },
+        { "bluetooth", tr("Bluetooth"), {}, {}, true, [this] { return new BluetoothModule(this); },
+          dcc::bluetooth::BluetoothWorker::sessionServices(), {} },
+        { "datetime", tr("Date and Time"), {}, {}, false, [this] { return new DatetimeModule(this); } },
+        { "power", tr("Power"), {}, {}, true, [this] { return new PowerModule(this); },
+          dcc::power::PowerWorker::sessionServices(), dcc::power::PowerWorker::systemServices() },
+        { "mouse", tr("Mouse"), {}, {}, true, [this] { return new MouseModule(this); },
+          dcc::mouse::MouseWorker::sessionServices(), {} },
+        { "wacom", tr("Drawing Tablet"), {}, {}, true, [this] { return new WacomModule(this); },
+          WacomWorker::sessionServices(), {} },
+        { "keyboard", tr("Keyboard and Language"), {}, {}, false, [this] { return new KeyboardModule(this); } },
+        { "update", tr("Updates"), {}, {}, true, [this] { return new UpdateModule(this); },
+          dcc::update::UpdateWorker::sessionServices(), dcc::update::UpdateWorker::systemServices() },
+        { "systeminfo", tr("System Info"), {}, {}, false, [this] { return new SystemInfoModule(this); } },
+        { "commoninfo", tr("General Settings"), {}, {}, true, [this] { return new CommonInfoModule(this); },
+          CommonInfoWork::sessionServices(), CommonInfoWork::systemServices() },
     };
 
+    for (ModuleMetadata meta : modules) {
+        // 与 ModuleInterface::icon()/translationPath() 的默认实现保持一致
+        meta.icon = QIcon::fromTheme(QString("dcc_nav_%1").arg(meta.name));
+        meta.translationPath = QString(":/translations/dde-control-center_%1.ts");
+        m_modules->append(meta);
+    }
+
     //读取加载一级菜单的插件
     if (InsertPlugin::instance(this, this)->needPushPlugin("mainwindow"))
         InsertPlugin::instance()->pushPlugin(m_modules);
@@ -373,30 +407,31 @@ void MainWindow::initAllModule(const QString &m)
     if (QGSettings::isSchemaInstalled("com.deepin.dde.control-versiontype")) {
         m_versionType  = new QGSettings("com.deepin.dde.control-versiontype", QByteArray(), this);
         auto versionTypeList =  m_versionType->get(GSETTINGS_HIDE_VERSIONTYPR).toStringList();
-        for (auto i : m_modules) {
-            if (versionTypeList.contains((i.first->name()))) {
-                setModuleVisible(i.first, false);
+        for (int i = 0; i < m_modules->count(); ++i) {
+            if (versionTypeList.contains(m_modules->metadata(i).name)) {
+                setNavItemVisible(i, false);
             }
         }
     }
 
     bool isIcon = m_contentStack.empty();
 
-    for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it) {
+    for (int i = 0; i < m_modules->count(); ++i) {
+        const ModuleMetadata &meta = m_modules->metadata(i);
         DStandardItem *item = new DStandardItem;
-        item->setIcon(it->first->icon());
-        item->setText(it->second);
-        if (it->first->name() == "systeminfo" && DSysInfo::DeepinDesktop == DSysInfo::deepinType())
+        item->setIcon(meta.icon);
+        item->setText(meta.displayName);
+        if (meta.name == "systeminfo" && DSysInfo::DeepinDesktop == DSysInfo::deepinType())
             item->setIcon(QIcon::fromTheme(QString("dcc_nav_deepin_systeminfo")));
-        if (it->first->name() == "commoninfo") {
+        if (meta.name == "commoninfo") {
             item->setAccessibleText("SECOND_MENU_COMMON");
         } else {
-            item->setAccessibleText(it->second);
+            item->setAccessibleText(meta.displayName);
         }
 
         //目前只有"update"模块需要使用右上角的角标，其他模块还是使用旧的位置数据设置
         //若其他地方需要使用右上角的角标，可在下面if处使用“||”添加对应模块的name()值
-        if (it->first->name() == "update" && m_updateVisibale) {
+        if (meta.name == "update" && m_updateVisibale) {
             auto action1 = new DViewItemAction(Qt::AlignTop | Qt::AlignRight, QSize(ActionIconSize, ActionIconSize), QSize(ActionIconSize, ActionIconSize), false);
             action1->setIcon(QIcon(":/icons/deepin/builtin/icons/dcc_common_subscript.svg"));
             action1->setVisible(false);
@@ -405,7 +440,7 @@ void MainWindow::initAllModule(const QString &m)
             action2->setVisible(false);
             item->setActionList(Qt::Edge::RightEdge, {action1, action2});
             CornerItemGroup group;
-            group.m_name = it->first->name();
+            group.m_name = meta.name;
             group.m_action.first = action1;
             group.m_action.second = action2;
             group.m_index = m_navModel->rowCount();
@@ -417,7 +452,13 @@ void MainWindow::initAllModule(const QString &m)
         }
 
         m_navModel->appendRow(item);
-        m_searchWidget->addModulesName(it->first->name(), it->second, it->first->icon(), it->first->translationPath());
+        m_searchWidget->addModulesName(meta.name, meta.displayName, meta.icon, meta.translationPath);
+    }
+
+    // 行在上面才添加到导航列表,之前设置的隐藏状态需要重新同步一次
+    for (int i = 0; i < m_modules->count(); ++i) {
+        if (!m_modules->isAvailable(i))
+            setNavItemVisible(i, false);
     }
 
     resetNavList(isIcon);
@@ -427,11 +468,10 @@ void MainWindow::initAllModule(const QString &m)
     m_searchWidget->setRemoveableDeviceStatus(tr("Touchpad"), getRemoveableDeviceStatus(tr("Touchpad")));
     m_searchWidget->setRemoveableDeviceStatus(tr("TrackPoint"), getRemoveableDeviceStatus(tr("TrackPoint")));
 
-    QElapsedTimer et;
-    et.start();
+    const qint64 begin = m_modules->now();
     //after initAllModule to load ts data
     m_searchWidget->setLanguage(QLocale::system().name());
-    qDebug() << QString("load search info with %1ms").arg(et.elapsed());
+    m_modules->addStage("load search data", begin, m_modules->now() - begin);
 }
 
 void MainWindow::updateWinsize()
@@ -446,27 +486,63 @@ void MainWindow::updateWinsize()
 void MainWindow::updateModuleVisible()
 {
     m_hideModuleNames = m_moduleSettings->get(GSETTINGS_HIDE_MODULE).toStringList();
-    for (auto i : m_modules) {
-        if (m_hideModuleNames.contains((i.first->name()))) {
-            setModuleVisible(i.first, false);
+    for (int i = 0; i < m_modules->count(); ++i) {
+        if (m_hideModuleNames.contains(m_modules->metadata(i).name)) {
+            setNavItemVisible(i, false);
         } else {
-            setModuleVisible(i.first, true);
+            setNavItemVisible(i, true);
         }
     }
 }
 
 void MainWindow::modulePreInitialize(const QString &m)
 {
-    for (auto it = m_modules.cbegin(); it != m_modules.cend(); ++it) {
-        QElapsedTimer et;
-        et.start();
-        it->first->preInitialize(m == it->first->name());
-        qDebug() << QString("initialize %1 module using time: %2ms")
-                 .arg(it->first->name())
-                 .arg(et.elapsed());
-
-        setModuleVisible(it->first, it->first->isAvailable());
+    // 只加载需要探测可用性的模块和启动参数指定的模块,由 m_scheduler 在之后的事件循环中依次完成
+    for (int i = 0; i < m_modules->count(); ++i) {
+        const ModuleMetadata &meta = m_modules->metadata(i);
+        if (!meta.probe && meta.name != m)
+            continue;
+
+        m_scheduler->schedule(i, m == meta.name);
     }
+
+    m_scheduler->start();
+}
+
+ModuleInterface *MainWindow::loadModule(int index, ModuleRegistry::LoadReason reason)
+{
+    if (m_scheduler->isPending(index))
+        m_scheduler->join(index);
+
+    if (m_modules->isLoaded(index))
+        return m_modules->instance(index);
+
+    // 马上就要显示该模块的页面,同步获取数据
+    ModuleInterface *inter = m_modules->load(index, reason, true);
+    setModuleVisible(inter, inter->isAvailable());
+    return inter;
+}
+
+void MainWindow::exportStartupReport()
+{
+    // 模块全部加载并且首次绘制完成后只输出一次
+    if (m_startupReported || !m_firstPaintRecorded || !m_scheduler->isFinished())
+        return;
+    m_startupReported = true;
+
+    qInfo().noquote() << "startup report:" << QJsonDocument(m_modules->report()).toJson(QJsonDocument::Compact);
+
+    const QString &tracePath = QString::fromLocal8Bit(qgetenv(StartupTraceEnv));
+    if (tracePath.isEmpty())
+        return;
+
+    QFile file(tracePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "can not write startup trace to" << tracePath;
+        return;
+    }
+
+    file.write(QJsonDocument(m_modules->trace()).toJson(QJsonDocument::Compact));
 }
 
 void MainWindow::popWidget()
@@ -524,6 +600,11 @@ void MainWindow::showModulePage(const QString &module, const QString &page, bool
 {
     Q_UNUSED(animation)
 //    qDebug() << Q_FUNC_INFO;
+    const int index = m_modules->indexOf(module);
+    // 模块的可用状态在 preInitialize 后才能确定,还在等待调度时先完成它
+    if (index != -1 && m_scheduler->isPending(index))
+        m_scheduler->join(index);
+
     if (!isModuleAvailable(module) && !module.isEmpty()) {
         qDebug() << QString("get error module name %1!").arg(module);
         if (calledFromDBus()) {
@@ -538,20 +619,8 @@ void MainWindow::showModulePage(const QString &module, const QString &page, bool
         return;
     }
 
-    auto findModule = [this](const QString & str)->ModuleInterface * {
-        auto res = std::find_if(m_modules.begin(), m_modules.end(), [ = ](const QPair<ModuleInterface *, QString> &data)->bool{
-            return data.first->name() == str;
-        });
-
-        if (res != m_modules.end()) {
-            return (*res).first;
-        }
-
-        return nullptr;
-    };
-
-    auto pm = findModule(module);
-    Q_ASSERT(pm);
+    Q_ASSERT(index != -1);
+    auto pm = loadModule(index, ModuleRegistry::Search);
 
     qDebug() << page;
     QStringList pages = page.split(",");
@@ -616,12 +685,9 @@ void MainWindow::setModuleSubscriptVisible(const QString &module, bool bIsDispla
 
 bool MainWindow::isModuleAvailable(const QString &m)
 {
-    auto res = std::find_if(m_modules.begin(), m_modules.end(), [ = ](const QPair<ModuleInterface *, QString> &data)->bool{
-        return data.first->name() == m;
-    });
-
-    if (res != m_modules.end()) {
-        return (*res).first->isAvailable();
+    const int index = m_modules->indexOf(m);
+    if (index != -1) {
+        return m_modules->isAvailable(index);
     }
 
     qDebug() << QString("can not fine module named %1!").arg(m);
@@ -668,6 +734,17 @@ void MainWindow::keyPressEvent(QKeyEvent *event)
 
 bool MainWindow::eventFilter(QObject *watched, QEvent *event)
 {
+    // 顶层窗口在处理 UpdateRequest 时完成绘制,第一次绘制结束后记录到启动时间线
+    if (watched == this && !m_bFirstPainted && QEvent::UpdateRequest == event->type() && isVisible()) {
+        m_bFirstPainted = true;
+        const qint64 begin = m_modules->now();
+        QTimer::singleShot(0, this, [this, begin] {
+            m_modules->addStage("first paint", begin, m_modules->now() - begin);
+            m_firstPaintRecorded = true;
+            exportStartupReport();
+        });
+    }
+
     if (watched == this && m_navView && m_navView->viewMode() == QListView::ListMode) {
         if (QEvent::WindowDeactivate == event->type() || QEvent::WindowActivate == event->type()) {
             DPalette pa = DApplicationHelper::instance()->palette(m_navView);
@@ -753,7 +830,7 @@ void MainWindow::resetNavList(bool isIconMode)
         //Icon模式，"update"使用右上角角标Margin
         for (auto data : m_remindeSubscriptList) {
             for (int i = 0; i < m_navModel->rowCount(); i++) {
-                if (m_modules.at(i).first->name() == data.m_name) {
+                if (m_modules->metadata(i).name == data.m_name) {
                     data.m_action.first->setVisible(data.m_action.second->isVisible());
                     data.m_action.second->setVisible(false);
                     if (data.m_action.first->isVisible())
@@ -782,7 +859,7 @@ void MainWindow::resetNavList(bool isIconMode)
         //List模式，"update"使用统一Margin
         for (auto data : m_remindeSubscriptList) {
             for (int i = 0; i < m_navModel->rowCount(); i++) {
-                if (m_modules.at(i).first->name() == data.m_name) {
+                if (m_modules->metadata(i).name == data.m_name) {
                     m_navModel->item(i, 0)->setData(NavItemMargin, Dtk::MarginsRole);
                     data.m_action.second->setVisible(data.m_action.first->isVisible());
                     data.m_action.first->setVisible(false);
@@ -815,37 +892,26 @@ void MainWindow::onEnterSearchWidget(QString moduleName, QString widget)
         qDebug() << Q_FUNC_INFO << " Search widget is current display widget.";
         // load wireless detail pages.
         if ((moduleName == "network") && (widgetPages.size() > 1)) {
-            auto res = std::find_if(m_modules.begin(), m_modules.end(), [ = ](const QPair<ModuleInterface *, QString> &data)->bool{
-                return data.first->name() == moduleName;
-            });
-
-            if (res != m_modules.end()) {
-                (*res).first->load(widget);
-                return;
-            }
+            m_contentStack.top().first->load(widget);
+            return;
         }
         if ((moduleName == "keyboard") && (widgetPages.size() >= 1)) {
-            auto res = std::find_if(m_modules.begin(), m_modules.end(), [ = ](const QPair<ModuleInterface *, QString> &data)->bool{
-                return data.first->name() == moduleName;
-            });
-
-            if (res != m_modules.end()) {
-                (*res).first->load(widget);
-                return;
-            }
+            m_contentStack.top().first->load(widget);
+            return;
         }
         return;
     }
 
-    for (int firstCount = 0; firstCount < m_modules.count(); firstCount++) {
-        //Compare moduleName and m_modules.second(module name)
-        if (moduleName == m_modules[firstCount].first->name()) {
+    for (int firstCount = 0; firstCount < m_modules->count(); firstCount++) {
+        //Compare moduleName and module name
+        if (moduleName == m_modules->metadata(firstCount).name) {
             //enter first level widget
             m_navView->setCurrentIndex(m_navView->model()->index(firstCount, 0));
 
             if (m_topWidget) {
                 popAllWidgets();
             }
+            loadModule(firstCount, ModuleRegistry::Search);
             onFirstItemClick(m_navView->model()->index(firstCount, 0));
 
             //当从dbus搜索进入这里时，如果传入的page参数错误，则会使用m_widgetName保存一个错的数据。
@@ -856,7 +922,7 @@ void MainWindow::onEnterSearchWidget(QString moduleName, QString widget)
 
             //notify related module load widget
 //            QTimer::singleShot(0, this, [ = ] { //avoid default and load sequence in time
-            auto errCode = m_modules[m_firstCount].first->load(widget);
+            auto errCode = m_modules->instance(m_firstCount)->load(widget);
             if (!errCode || m_widgetName == "") {
                 return;
             }
@@ -889,69 +955,72 @@ void MainWindow::changeEvent(QEvent *event)
 
 void MainWindow::setModuleVisible(ModuleInterface *const inter, const bool visible)
 {
+    const int index = m_modules->indexOf(inter);
+    if (index == -1) {
+        inter->setAvailable(visible && !m_hideModuleNames.contains(inter->name()));
+        qDebug() << Q_FUNC_INFO << "Not found module!";
+        return;
+    }
+
+    setNavItemVisible(index, visible);
+}
+
+void MainWindow::setNavItemVisible(int index, const bool visible)
+{
+    const QString &name = m_modules->metadata(index).name;
     bool bFinalVisible = visible;
-    if (bFinalVisible && m_hideModuleNames.contains(inter->name())) {
+    if (bFinalVisible && m_hideModuleNames.contains(name)) {
         bFinalVisible = false;
     }
-    inter->setAvailable(bFinalVisible);
-
-    auto find_it = std::find_if(m_modules.cbegin(),
-                                m_modules.cend(),
-    [ = ](const QPair<ModuleInterface *, QString> &pair) {
-        return pair.first == inter;
-    });
+    m_modules->setAvailable(index, bFinalVisible);
 
-    if (find_it != m_modules.cend()) {
-        m_navView->setRowHidden(find_it - m_modules.cbegin(), !bFinalVisible);
-        Q_EMIT moduleVisibleChanged(find_it->first->name(), bFinalVisible);
+    m_navView->setRowHidden(index, !bFinalVisible);
+    Q_EMIT moduleVisibleChanged(name, bFinalVisible);
 
-        qDebug() << "[SearchWidget] find_it->first->name() : " << find_it->first->name() << bFinalVisible;
-        if ("bluetooth" == find_it->first->name()) {
-            if (bFinalVisible) {
-                m_searchWidget->removeUnExsitData(tr("Bluetooth"));
-            } else {
-                m_searchWidget->addUnExsitData(tr("Bluetooth"));
+    qDebug() << "[SearchWidget] name : " << name << bFinalVisible;
+    if ("bluetooth" == name) {
+        if (bFinalVisible) {
+            m_searchWidget->removeUnExsitData(tr("Bluetooth"));
+        } else {
+            m_searchWidget->addUnExsitData(tr("Bluetooth"));
 
-                //当前处于＂蓝牙＂页面才会回到主页面
-                if (m_contentStack.count() > 0 && m_contentStack.at(0).first->name() == "bluetooth") {
-                    popAllWidgets();
-                    resetNavList(m_contentStack.empty());
-                }
+            //当前处于＂蓝牙＂页面才会回到主页面
+            if (m_contentStack.count() > 0 && m_contentStack.at(0).first->name() == "bluetooth") {
+                popAllWidgets();
+                resetNavList(m_contentStack.empty());
             }
-        } else if ("wacom" == find_it->first->name()) {
-            if (bFinalVisible) {
-                m_searchWidget->removeUnExsitData(tr("Drawing Tablet"));
-            } else {
-                m_searchWidget->addUnExsitData(tr("Drawing Tablet"));
+        }
+    } else if ("wacom" == name) {
+        if (bFinalVisible) {
+            m_searchWidget->removeUnExsitData(tr("Drawing Tablet"));
+        } else {
+            m_searchWidget->addUnExsitData(tr("Drawing Tablet"));
 
-                //当前处于＂数位板＂页面才会回到主页面
-                if (m_contentStack.count() > 0 && m_contentStack.at(0).first->name() == "wacom") {
-                    popAllWidgets();
-                    resetNavList(m_contentStack.empty());
-                }
-            }
-        }  else if ("cloudsync" == find_it->first->name()) {
-            if (bFinalVisible) {
-                m_searchWidget->removeUnExsitData(tr("Cloud Sync"));
-            } else {
-                m_searchWidget->addUnExsitData(tr("Cloud Sync"));
-            }
-        } else if ("commoninfo" == find_it->first->name()) {
-            if (bFinalVisible) {
-                m_searchWidget->removeUnExsitData(tr("General Settings"));
-            } else {
-                m_searchWidget->addUnExsitData(tr("General Settings"));
-            }
-        } else if ("update" == find_it->first->name()) {
-            m_updateVisibale = bFinalVisible;
-            if (bFinalVisible) {
-                m_searchWidget->removeUnExsitData(tr("Updates"));
-            } else {
-                m_searchWidget->addUnExsitData(tr("Updates"));
+            //当前处于＂数位板＂页面才会回到主页面
+            if (m_contentStack.count() > 0 && m_contentStack.at(0).first->name() == "wacom") {
+                popAllWidgets();
+                resetNavList(m_contentStack.empty());
             }
         }
-    } else {
-        qDebug() << Q_FUNC_INFO << "Not found module!";
+    }  else if ("cloudsync" == name) {
+        if (bFinalVisible) {
+            m_searchWidget->removeUnExsitData(tr("Cloud Sync"));
+        } else {
+            m_searchWidget->addUnExsitData(tr("Cloud Sync"));
+        }
+    } else if ("commoninfo" == name) {
+        if (bFinalVisible) {
+            m_searchWidget->removeUnExsitData(tr("General Settings"));
+        } else {
+            m_searchWidget->addUnExsitData(tr("General Settings"));
+        }
+    } else if ("update" == name) {
+        m_updateVisibale = bFinalVisible;
+        if (bFinalVisible) {
+            m_searchWidget->removeUnExsitData(tr("Updates"));
+        } else {
+            m_searchWidget->addUnExsitData(tr("Updates"));
+        }
     }
 }
 
@@ -1131,7 +1200,7 @@ void MainWindow::updateViewBackground()
 
 void MainWindow::onFirstItemClick(const QModelIndex &index)
 {
-    ModuleInterface *inter = m_modules[index.row()].first;
+    ModuleInterface *inter = loadModule(index.row(), ModuleRegistry::Navigation);
 
     if (!m_contentStack.isEmpty() && m_contentStack.last().first == inter) {
         return;
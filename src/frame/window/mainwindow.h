@@ -23,6 +23,7 @@
 
 #include "navigation/navmodel.h"
 #include "interface/frameproxyinterface.h"
+#include "moduleregistry.h"
 
 #include <DMainWindow>
 #include <DBackgroundGroup>
@@ -59,6 +60,7 @@ extern const QString GSettinsWindowHeight;
 
 namespace DCC_NAMESPACE {
 class ModuleInterface;
+class StartupScheduler;
 class FourthColWidget : public QWidget
 {
     Q_OBJECT
@@ -122,6 +124,9 @@ protected:
 private:
     void resetNavList(bool isIconMode);
     void modulePreInitialize(const QString &m = nullptr);
+    ModuleInterface *loadModule(int index, ModuleRegistry::LoadReason reason);
+    void exportStartupReport();
+    void setNavItemVisible(int index, const bool visible);
     void popAllWidgets(int place = 0);//place is Remain count
     void onFirstItemClick(const QModelIndex &index);
     void pushNormalWidget(ModuleInterface *const inter, QWidget *const w);  //exchange third widget : push new widget
@@ -134,13 +139,18 @@ private:
 
 private:
     bool m_bInit{false};
+    bool m_bFirstPainted{false};
+    // 首次绘制的耗时已记录到启动时间线
+    bool m_firstPaintRecorded{false};
+    bool m_startupReported{false};
     QHBoxLayout *m_contentLayout;
     QHBoxLayout *m_rightContentLayout;
     dcc::widgets::MultiSelectListView *m_navView;
     DBackgroundGroup *m_rightView;
     QStandardItemModel *m_navModel;
     QStack<QPair<ModuleInterface *, QWidget *>> m_contentStack;
-    QList<QPair<ModuleInterface *, QString>> m_modules;
+    ModuleRegistry *m_modules;
+    StartupScheduler *m_scheduler;
     QList<ModuleInterface *> m_initList;
     QPair<ModuleInterface *, QWidget *> m_lastThirdPage;
     bool m_bIsFinalWidget;//used to distinguish the widget is final or top : fianl pop in popWidget , top pop by m_topWidget
@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     zccrs <zccrs@live.com>
+ *
+ * Maintainer: zccrs <zhangjide@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "moduleregistry.h"
+#include "interface/moduleinterface.h"
+
+#include <QJsonArray>
+#include <QCoreApplication>
+#include <QDebug>
+
+using namespace DCC_NAMESPACE;
+
+namespace {
+const QString StageCategory = QStringLiteral("stage");
+// 主线程在时间线中的 tid, DBus 服务从 MainThreadId + 1 开始依次分配
+const int MainThreadId = 1;
+
+QJsonObject completeEvent(const QString &name, const QString &category, qint64 begin, qint64 duration, int tid)
+{
+    QJsonObject event;
+    event.insert("name", name);
+    event.insert("cat", category);
+    event.insert("ph", "X");
+    event.insert("ts", begin);
+    event.insert("dur", duration);
+    event.insert("pid", QCoreApplication::applicationPid());
+    event.insert("tid", tid);
+    return event;
+}
+
+QJsonObject threadNameEvent(const QString &name, int tid)
+{
+    QJsonObject event;
+    event.insert("name", "thread_name");
+    event.insert("ph", "M");
+    event.insert("pid", QCoreApplication::applicationPid());
+    event.insert("tid", tid);
+    event.insert("args", QJsonObject { { "name", name } });
+    return event;
+}
+
+const char *reasonName(ModuleRegistry::LoadReason reason)
+{
+    switch (reason) {
+    case ModuleRegistry::Navigation:
+        return "navigation";
+    case ModuleRegistry::Search:
+        return "search";
+    default:
+        return "startup";
+    }
+}
+}
+
+ModuleRegistry::ModuleRegistry()
+{
+    m_clock.start();
+}
+
+ModuleRegistry::~ModuleRegistry()
+{
+    for (const Entry &entry : m_entries) {
+        if (entry.inter)
+            delete entry.inter;
+    }
+}
+
+void ModuleRegistry::append(const ModuleMetadata &meta)
+{
+    Entry entry;
+    entry.meta = meta;
+    m_entries.append(entry);
+}
+
+void ModuleRegistry::insert(int index, ModuleInterface *inter)
+{
+    Entry entry;
+    entry.meta.name = inter->name();
+    entry.meta.displayName = inter->displayName();
+    entry.meta.icon = inter->icon();
+    entry.meta.translationPath = inter->translationPath();
+    entry.meta.probe = true;
+    entry.inter = inter;
+    // 插件在加载时已经创建,没有创建耗时
+    entry.constructTime = 0;
+    m_entries.insert(qBound(0, index, m_entries.size()), entry);
+}
+
+int ModuleRegistry::indexOf(const QString &name) const
+{
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).meta.name == name)
+            return i;
+    }
+
+    return -1;
+}
+
+int ModuleRegistry::indexOf(const ModuleInterface *inter) const
+{
+    if (!inter)
+        return -1;
+
+    for (int i = 0; i < m_entries.size(); ++i) {
+        if (m_entries.at(i).inter == inter)
+            return i;
+    }
+
+    return -1;
+}
+
+bool ModuleRegistry::isAvailable(int index) const
+{
+    const Entry &entry = m_entries.at(index);
+    return entry.inter ? entry.inter->isAvailable() : entry.available;
+}
+
+void ModuleRegistry::setAvailable(int index, bool available)
+{
+    Entry &entry = m_entries[index];
+    entry.available = available;
+    if (entry.inter)
+        entry.inter->setAvailable(available);
+}
+
+ModuleInterface *ModuleRegistry::load(int index, LoadReason reason, bool sync)
+{
+    Entry &entry = m_entries[index];
+    if (entry.loaded)
+        return entry.inter;
+
+    entry.loaded = true;
+    entry.reason = reason;
+    entry.loadAt = now();
+
+    QElapsedTimer et;
+    if (!entry.inter) {
+        et.start();
+        entry.inter = entry.meta.creator();
+        entry.constructTime = et.nsecsElapsed() / 1000;
+        // 创建前通过 gsettings 等隐藏的状态需要同步给模块
+        entry.inter->setAvailable(entry.available);
+    }
+
+    // preInitialize 中模块可能会直接调用 setModuleVisible(this, ...),此时 entry.inter 已经可以被查找到
+    et.start();
+    entry.inter->preInitialize(sync);
+    entry.preInitializeTime = et.nsecsElapsed() / 1000;
+
+    if (reason != Startup) {
+        qDebug() << QString("load %1 module on %2, construct: %3ms, preInitialize: %4ms")
+                 .arg(entry.meta.name)
+                 .arg(reasonName(reason))
+                 .arg(entry.constructTime / 1000)
+                 .arg(entry.preInitializeTime / 1000);
+    }
+
+    return entry.inter;
+}
+
+void ModuleRegistry::addStage(const QString &name, qint64 begin, qint64 duration)
+{
+    addEvent(name, StageCategory, begin, duration);
+}
+
+void ModuleRegistry::addEvent(const QString &name, const QString &category, qint64 begin, qint64 duration)
+{
+    m_events << Event { name, category, begin, duration };
+}
+
+QJsonObject ModuleRegistry::report() const
+{
+    QJsonObject stages;
+    for (const Event &event : m_events) {
+        if (event.category == StageCategory)
+            stages.insert(event.name, event.duration / 1000);
+    }
+
+    QJsonArray modules;
+    for (const Entry &entry : m_entries) {
+        QJsonObject module;
+        module.insert("name", entry.meta.name);
+        module.insert("probe", entry.meta.probe);
+        module.insert("loaded", entry.loaded);
+        if (entry.loaded) {
+            module.insert("reason", reasonName(entry.reason));
+            module.insert("loadAt", entry.loadAt / 1000);
+            module.insert("construct", entry.constructTime / 1000);
+            module.insert("preInitialize", entry.preInitializeTime / 1000);
+        }
+        modules.append(module);
+    }
+
+    QJsonObject report;
+    report.insert("elapsed", now() / 1000);
+    report.insert("stages", stages);
+    report.insert("modules", modules);
+    return report;
+}
+
+QJsonObject ModuleRegistry::trace() const
+{
+    QJsonArray events;
+    events.append(threadNameEvent("dde-control-center", MainThreadId));
+
+    for (const Entry &entry : m_entries) {
+        if (!entry.loaded)
+            continue;
+
+        const QString &category = QString("module,%1").arg(reasonName(entry.reason));
+        qint64 begin = entry.loadAt;
+        if (entry.constructTime > 0) {
+            events.append(completeEvent(QString("construct %1").arg(entry.meta.name), category,
+                                        begin, entry.constructTime, MainThreadId));
+            begin += entry.constructTime;
+        }
+        events.append(completeEvent(QString("preInitialize %1").arg(entry.meta.name), category,
+                                    begin, entry.preInitializeTime, MainThreadId));
+    }
+
+    int tid = MainThreadId;
+    for (const Event &event : m_events) {
+        if (event.category == StageCategory) {
+            events.append(completeEvent(event.name, event.category, event.begin, event.duration, MainThreadId));
+            continue;
+        }
+
+        // 异步事件之间会重叠,各自单独一行显示
+        events.append(threadNameEvent(event.name, ++tid));
+        events.append(completeEvent(event.name, event.category, event.begin, event.duration, tid));
+    }
+
+    QJsonObject trace;
+    trace.insert("traceEvents", events);
+    trace.insert("displayTimeUnit", "ms");
+    return trace;
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     zccrs <zccrs@live.com>
+ *
+ * Maintainer: zccrs <zhangjide@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QString>
+#include <QStringList>
+#include <QIcon>
+#include <QList>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include <functional>
+
+namespace DCC_NAMESPACE {
+class ModuleInterface;
+
+// 一级模块的静态描述,用于在模块实例化之前生成导航列表和搜索数据
+struct ModuleMetadata {
+    QString name;
+    QString displayName;
+    QIcon icon;
+    QString translationPath;
+    // 为 true 时模块需要在启动时 preInitialize,由模块自己探测设备/服务是否存在,
+    // 如蓝牙、数位板、触控板等;为 false 时延迟到第一次进入或搜索该模块时再实例化
+    bool probe{false};
+    std::function<ModuleInterface *()> creator;
+    // preInitialize 时会访问的 DBus 服务,由各模块的 worker 提供,启动时提前并行激活
+    QStringList sessionServices;
+    QStringList systemServices;
+};
+
+/**
+ * @brief The ModuleRegistry class 一级模块注册表
+ * 按导航列表的顺序保存所有模块的静态描述,模块在第一次使用时才创建并 preInitialize,
+ * 同时记录每个模块的创建/preInitialize 耗时,生成启动报告
+ */
+class ModuleRegistry
+{
+public:
+    enum LoadReason {
+        Startup,        // 启动时加载(需要探测可用性的模块/插件/启动参数指定的模块)
+        Navigation,     // 点击导航列表
+        Search,         // 搜索或 dbus ShowPage 进入
+    };
+
+    ModuleRegistry();
+    ~ModuleRegistry();
+
+    // 内置模块,creator 在第一次 load 时调用
+    void append(const ModuleMetadata &meta);
+    // 已经实例化的模块(插件),插入到 index 处,始终在启动时 preInitialize
+    void insert(int index, ModuleInterface *inter);
+
+    int count() const { return m_entries.size(); }
+    int indexOf(const QString &name) const;
+    int indexOf(const ModuleInterface *inter) const;
+    const ModuleMetadata &metadata(int index) const { return m_entries.at(index).meta; }
+
+    // 返回已创建的模块,未创建时返回 nullptr
+    ModuleInterface *instance(int index) const { return m_entries.at(index).inter; }
+    bool isLoaded(int index) const { return m_entries.at(index).loaded; }
+
+    // 模块未创建时保存可用状态,创建后同步给模块
+    bool isAvailable(int index) const;
+    void setAvailable(int index, bool available);
+
+    // 返回 index 对应的模块,未加载时创建并 preInitialize
+    ModuleInterface *load(int index, LoadReason reason, bool sync = false);
+
+    // 注册表创建至今的微秒数,作为启动事件的时间戳
+    qint64 now() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // 记录模块以外的启动事件,时间单位为微秒
+    // addStage 为主线程上的启动阶段,如加载搜索数据; addEvent 为异步事件,如激活 DBus 服务
+    void addStage(const QString &name, qint64 begin, qint64 duration);
+    void addEvent(const QString &name, const QString &category, qint64 begin, qint64 duration);
+
+    /**
+     * @brief report 启动报告
+     * {"elapsed":启动至今的毫秒数, "stages":{阶段:耗时}, "modules":[{"name", "probe", "loaded",
+     *  "reason", "loadAt", "construct", "preInitialize"}]},时间单位均为毫秒,未加载的模块只有前三项
+     */
+    QJsonObject report() const;
+
+    /**
+     * @brief trace Chrome trace 格式(chrome://tracing, Perfetto)的启动时间线
+     * 模块的创建/preInitialize 和启动阶段位于主线程,每个 DBus 服务的激活单独一行
+     */
+    QJsonObject trace() const;
+
+private:
+    struct Event {
+        QString name;
+        QString category;
+        qint64 begin;
+        qint64 duration;
+    };
+
+    struct Entry {
+        ModuleMetadata meta;
+        ModuleInterface *inter{nullptr};
+        bool loaded{false};
+        bool available{true};
+        LoadReason reason{Startup};
+        qint64 loadAt{-1};
+        qint64 constructTime{-1};
+        qint64 preInitializeTime{-1};
+    };
+
+    QList<Entry> m_entries;
+    QList<Event> m_events;
+    QElapsedTimer m_clock;
+};
+
+}// namespace DCC_NAMESPACE
@@ -107,7 +107,6 @@ void AccountsModule::active()
     connect(m_accountsWidget, &AccountsWidget::requestBack, this, [ = ] {
         m_frameProxy->popWidget(this);
     });
-    connect(m_accountsWidget, &AccountsWidget::requestLoadUserList, m_accountsWorker, &AccountsWorker::loadUserList);
     m_frameProxy->pushWidget(this, m_accountsWidget);
     m_accountsWidget->setVisible(true);
     m_accountsWidget->showDefaultAccountInfo();
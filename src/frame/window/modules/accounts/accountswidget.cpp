@@ -24,26 +24,19 @@
 #include "modules/accounts/usermodel.h"
 #include "modules/accounts/user.h"
 #include "accountsdetailwidget.h"
+#include "userlistmodel.h"
 #include "window/utils.h"
-#include "onlineicon.h"
 
 #include <DStyleOption>
-#include <DStandardItem>
 
 #include <QWidget>
 #include <QVBoxLayout>
-#include <QStandardItem>
-#include <QStandardItemModel>
 #include <QTimer>
 #include <QDebug>
 #include <QIcon>
 #include <QSize>
-#include <QPainter>
 #include <QPixmap>
-#include <QBitmap>
-#include <QPainterPath>
 #include <QScroller>
-#include <QScrollBar>
 
 DWIDGET_USE_NAMESPACE
 using namespace dcc::accounts;
@@ -54,7 +47,7 @@ AccountsWidget::AccountsWidget(QWidget *parent)
     : QWidget(parent)
     , m_createBtn(new DFloatingButton(DStyle::SP_IncreaseElement, this))
     , m_userlistView(new dcc::widgets::MultiSelectListView(this))
-    , m_userItemModel(new QStandardItemModel(this))
+    , m_userItemModel(new UserListModel(m_userlistView->viewport(), this))
     , m_saveClickedRow(0)
 {
     m_createBtn->setFixedSize(50, 50);
@@ -81,7 +74,10 @@ AccountsWidget::AccountsWidget(QWidget *parent)
     m_userlistView->setDragEnabled(false);
     m_userlistView->setIconSize(QSize(30, 30));
     m_userlistView->setLayoutDirection(Qt::LeftToRight);
+    // 列表项高度一致,滚动时不需要逐项计算大小
+    m_userlistView->setUniformItemSizes(true);
     m_userlistView->setModel(m_userItemModel);
+    m_userItemModel->setAvatarSize(m_userlistView->iconSize());
 
     QScroller *scroller = QScroller::scroller(m_userlistView->viewport());
     QScrollerProperties sp;
@@ -92,23 +88,11 @@ AccountsWidget::AccountsWidget(QWidget *parent)
 
     connect(m_userlistView, &QListView::clicked, this, &AccountsWidget::onItemClicked);
     connect(m_userlistView, &DListView::activated, m_userlistView, &QListView::clicked);
-    connect(m_userlistView->verticalScrollBar(), &QScrollBar::valueChanged, this, [ = ](int value) {
-        static int valueTemp = 0;
-        if (value > valueTemp) {
-            requestLoadUserList();
-        }
-        valueTemp = value;
-    });
     connect(m_createBtn, &QPushButton::clicked, this, &AccountsWidget::requestCreateAccount);
 }
 
 AccountsWidget::~AccountsWidget()
 {
-    if (m_userItemModel) {
-        m_userItemModel->clear();
-        m_userItemModel->deleteLater();
-        m_userItemModel = nullptr;
-    }
 }
 
 void AccountsWidget::setModel(UserModel *model)
@@ -155,60 +139,11 @@ void AccountsWidget::setShowFirstUserInfo(bool show)
 void AccountsWidget::addUser(User *user, bool t1)
 {
     //active
-    m_userList << user;
-    DStandardItem *item = new DStandardItem;
-    item->setData(0, AccountsWidget::ItemDataRole);
-
-    if (IsServerSystem) {
-        /* 用户列表显示用户类型 */
-        auto *subTitleAction = new DViewItemAction;
-        if (user->userType() == User::UserType::Administrator) {
-            subTitleAction->setText(tr("Administrator"));
-        } else {
-            subTitleAction->setText(tr("Standard User"));
-        }
-        subTitleAction->setFontSize(DFontSizeManager::T8);
-        subTitleAction->setTextColorRole(DPalette::TextTips);
-        item->setTextActionList({subTitleAction});
-
-        connect(user, &User::userTypeChanged, this, [=](int userType) {
-            if (userType == User::UserType::Administrator) {
-                subTitleAction->setText(tr("Administrator"));
-            } else {
-                subTitleAction->setText(tr("Standard User"));
-            }
-        });
-    }
-
-    DViewItemAction *onlineFlag = new DViewItemAction(Qt::AlignCenter | Qt::AlignRight, QSize(), QSize(), true);
-    OnlineIcon *onlineIcon = new OnlineIcon(m_userlistView->viewport());
-    onlineIcon->setFixedSize(12, 12);
-    onlineFlag->setWidget(onlineIcon);
-    item->setActionList(Qt::Edge::RightEdge, {onlineFlag});
-    onlineFlag->setVisible(user->online());
-    if (onlineFlag->widget()) {
-        onlineFlag->widget()->setVisible(onlineFlag->isVisible());
-    }
-    connect(user, &User::onlineChanged, this, [=](const bool &online) {
-        onlineFlag->setVisible(online);
-        if (onlineFlag->widget()) {
-            onlineFlag->widget()->setVisible(onlineFlag->isVisible());
-        }
-    });
-
-    m_userItemModel->appendRow(item);
-    connectUserWithItem(user);
+    // 列表项的头像、在线状态等由 UserListModel 在第一次显示时创建
+    m_userItemModel->addUser(user);
 
     connect(user, &User::isCurrentUserChanged, this, [ = ](bool isCurrentUser) {
         if (isCurrentUser) {
-            auto tindex = m_userList.indexOf(user);
-            auto titem = m_userItemModel->takeRow(tindex);
-
-            m_userItemModel->insertRow(0, titem);
-
-            m_userList.removeOne(user);
-            m_userList.push_front(user);
-
             showDefaultAccountInfo();
         }
     });
@@ -216,21 +151,8 @@ void AccountsWidget::addUser(User *user, bool t1)
     if (t1)
         return;
 
-    auto path = user->currentAvatar();
-    path = path.startsWith("file://") ? QUrl(path).toLocalFile() : path;
-    QPixmap pixmap = pixmapToRound(path);
-
-    item->setIcon(QIcon(pixmap));
-    item->setText(user->displayName());
-
     if (user->isCurrentUser()) {
         //如果是当前用户
-        auto tttitem = m_userItemModel->takeRow(m_userItemModel->rowCount() - 1);
-        Q_ASSERT(tttitem[0] == item);
-        m_userItemModel->insertRow(0, item);
-
-        m_userList.push_front(user);
-        m_userList.pop_back();
         m_currentUserAdded = true;
 
         QTimer::singleShot(0, this, &AccountsWidget::showDefaultAccountInfo);
@@ -239,10 +161,10 @@ void AccountsWidget::addUser(User *user, bool t1)
 
 void AccountsWidget::removeUser(User *user)
 {
-    m_userItemModel->removeRow(m_userList.indexOf(user)); // It will delete when remove
-    m_userList.removeOne(user);
+    disconnect(user, nullptr, this, nullptr);
+    m_userItemModel->removeUser(user);
 
-    if (m_userList.isEmpty()) {
+    if (m_userItemModel->rowCount() == 0) {
         Q_EMIT requestBack();
         return;
     }
@@ -253,66 +175,12 @@ void AccountsWidget::removeUser(User *user)
 void AccountsWidget::onItemClicked(const QModelIndex &index)
 {
     m_saveClickedRow = index.row();
-    Q_EMIT requestShowAccountsDetail(m_userList[index.row()]);
-    m_userlistView->resetStatus(index);
-}
-
-void AccountsWidget::connectUserWithItem(User *user)
-{
-    connect(user, &User::nameChanged, this, [ = ](const QString &) {
-        int tindex = m_userList.indexOf(user);
-        auto titem = m_userItemModel->item(tindex);
-        if (!titem) {
-            return;
-        }
-        titem->setText(user->displayName());
-    });
-    connect(user, &User::fullnameChanged, this, [ = ](const QString &) {
-        int tindex = m_userList.indexOf(user);
-        auto titem = m_userItemModel->item(tindex);
-        if (titem) {
-            titem->setText(user->displayName());
-        }
-    });
-    connect(user, &User::currentAvatarChanged, this, [ = ](const QString & avatar) {
-        int tindex = m_userList.indexOf(user);
-        auto titem = m_userItemModel->item(tindex);
-        if (!titem) {
-            return;
-        }
-        auto ratio = this->devicePixelRatioF();
-        auto path = avatar;
-        if (ratio > 4.0) {
-            path.replace("icons/", "icons/bigger/");
-        }
-
-        path = path.startsWith("file://") ? QUrl(path).toLocalFile() : path;
-        QPixmap pixmap = pixmapToRound(path);
-
-        titem->setIcon(QIcon(pixmap));
-    });
-}
-
-QPixmap AccountsWidget::pixmapToRound(const QPixmap &src)
-{
-    if (src.isNull()) {
-        return QPixmap();
-    }
-
-    auto pixmap = QPixmap(src);
-    QSize size = pixmap.size();
-    QPixmap mask(size);
-    mask.fill(Qt::transparent);
-
-    QPainter painter(&mask);
-    painter.setRenderHint(QPainter::Antialiasing);
-
-    QPainterPath path;
-    path.addEllipse(0, 0, size.width(), size.height());
-    painter.setClipPath(path);
-    painter.drawPixmap(0, 0, pixmap);
+    User *user = m_userItemModel->user(index.row());
+    if (!user)
+        return;
 
-    return mask;
+    Q_EMIT requestShowAccountsDetail(user);
+    m_userlistView->resetStatus(index);
 }
 
 void AccountsWidget::handleRequestBack(AccountsWidget::ActionOption option)
@@ -32,8 +32,6 @@
 
 QT_BEGIN_NAMESPACE
 class QVBoxLayout;
-class QStandardItem;
-class QStandardItemModel;
 QT_END_NAMESPACE
 
 namespace dcc {
@@ -50,6 +48,7 @@ namespace DCC_NAMESPACE {
 namespace accounts {
 class AccountsDetailWidget;
 class MySortFilterProxyModel;
+class UserListModel;
 //显示用户列表
 class AccountsWidget : public QWidget
 {
@@ -62,7 +61,6 @@ public:
     void showDefaultAccountInfo();
     void showLastAccountInfo();
     void setShowFirstUserInfo(bool show);
-    void connectUserWithItem(dcc::accounts::User *user);
 
     enum AccountRole {
         ItemDataRole = Dtk::UserRole + 1
@@ -74,7 +72,6 @@ public:
         ModifyPwdSuccess
     };
 
-    QPixmap pixmapToRound(const QPixmap &src);
     void handleRequestBack(AccountsWidget::ActionOption option = AccountsWidget::ClickCancel);
 
 public Q_SLOTS:
@@ -87,14 +84,12 @@ Q_SIGNALS:
     void requestCreateAccount();
     void requestShowLastClickedUserInfo(bool t = false);
     void requestBack();
-    void requestLoadUserList();
 
 private:
     DTK_WIDGET_NAMESPACE::DFloatingButton *m_createBtn;
     dcc::widgets::MultiSelectListView *m_userlistView;
-    QStandardItemModel *m_userItemModel;
+    UserListModel *m_userItemModel;
     dcc::accounts::UserModel *m_userModel;
-    QList<dcc::accounts::User *> m_userList;
     bool m_isShowFirstUserInfo = false;
     bool m_currentUserAdded = false;
     int m_saveClickedRow;
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2011 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     liuhong <liuhong_cm@deepin.com>
+ *
+ * Maintainer: liuhong <liuhong_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "avatarcache.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDateTime>
+#include <QPainter>
+#include <QPainterPath>
+#include <QDir>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::accounts;
+
+namespace {
+// 缓存上限, 单位 KB
+const int MaxCacheCost = 16 * 1024;
+}
+
+AvatarCache *AvatarCache::instance()
+{
+    static AvatarCache *cache = new AvatarCache;
+    return cache;
+}
+
+AvatarCache::AvatarCache(QObject *parent)
+    : QObject(parent)
+    , m_cacheDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/avatars")
+    , m_cache(MaxCacheCost)
+{
+}
+
+QPixmap AvatarCache::avatar(const QString &path, const QSize &size, qreal ratio, bool round)
+{
+    if (path.isEmpty())
+        return QPixmap();
+
+    // 键中包含文件的修改时间和大小, 同一路径的头像被替换后重新生成
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QPixmap();
+
+    const QString &k = fileKey(info, size, ratio, round);
+    if (QPixmap *pixmap = m_cache.object(k))
+        return *pixmap;
+
+    // 无法解码的文件不重复提交, 文件被替换后键改变时再试
+    if (m_pending.contains(k) || m_failed.contains(k))
+        return QPixmap();
+
+    m_pending.insert(k);
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, k, path] {
+        const QImage &img = watcher->result();
+        watcher->deleteLater();
+        m_pending.remove(k);
+
+        if (img.isNull()) {
+            m_failed.insert(k);
+            return;
+        }
+
+        // QPixmap 只能在主线程创建
+        m_cache.insert(k, new QPixmap(QPixmap::fromImage(img)), qMax(1, static_cast<int>(img.sizeInBytes() / 1024)));
+        Q_EMIT avatarReady(path);
+    });
+    watcher->setFuture(QtConcurrent::run(&AvatarCache::render, path, size, ratio, round, m_cacheDir));
+
+    return QPixmap();
+}
+
+QString AvatarCache::key(const QString &path, const QSize &size, qreal ratio, bool round)
+{
+    return QString("%1|%2x%3@%4|%5").arg(path).arg(size.width()).arg(size.height()).arg(ratio).arg(round);
+}
+
+QString AvatarCache::fileKey(const QFileInfo &info, const QSize &size, qreal ratio, bool round)
+{
+    return QString("%1|%2|%3").arg(key(info.absoluteFilePath(), size, ratio, round))
+           .arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size());
+}
+
+QImage AvatarCache::render(const QString &path, const QSize &size, qreal ratio, bool round, const QString &cacheDir)
+{
+    // 缓存文件名包含源文件的修改时间和大小, 头像文件被替换后自动失效
+    const QFileInfo info(path);
+    if (!info.exists())
+        return QImage();
+
+    const QByteArray &k = fileKey(info, size, ratio, round).toUtf8();
+    const QString &cachePath = QString("%1/%2.png").arg(cacheDir)
+                               .arg(QString(QCryptographicHash::hash(k, QCryptographicHash::Sha1).toHex()));
+
+    QImage img(cachePath);
+    if (img.isNull()) {
+        QImageReader reader(path);
+        if (size.isValid() && reader.size().isValid())
+            reader.setScaledSize(reader.size().scaled(size * ratio, Qt::KeepAspectRatio));
+
+        img = reader.read();
+        if (img.isNull())
+            return QImage();
+
+        if (round)
+            img = toRound(img);
+
+        if (QDir().mkpath(cacheDir)) {
+            // 多个线程可能同时写同一个缓存文件, 写完后再替换
+            QSaveFile file(cachePath);
+            if (file.open(QIODevice::WriteOnly) && img.save(&file, "PNG"))
+                file.commit();
+        }
+    }
+
+    img.setDevicePixelRatio(ratio);
+    return img;
+}
+
+QImage AvatarCache::toRound(const QImage &source)
+{
+    QImage img(source.size(), QImage::Format_ARGB32_Premultiplied);
+    img.fill(Qt::transparent);
+
+    QPainter painter(&img);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    QPainterPath path;
+    path.addEllipse(0, 0, img.width(), img.height());
+    painter.setClipPath(path);
+    painter.drawImage(0, 0, source);
+
+    return img;
+}
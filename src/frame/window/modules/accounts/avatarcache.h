@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2011 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     liuhong <liuhong_cm@deepin.com>
+ *
+ * Maintainer: liuhong <liuhong_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QCache>
+#include <QSet>
+#include <QPixmap>
+#include <QImage>
+
+class QFileInfo;
+
+namespace DCC_NAMESPACE {
+namespace accounts {
+
+/**
+ * @brief The AvatarCache class 用户头像的共享缓存
+ * 头像在后台线程中解码、缩放并裁剪成圆形, 按文件修改时间保存到磁盘缓存;
+ * 没有缓存时返回空图片, 生成后发出 avatarReady 通知列表刷新
+ */
+class AvatarCache : public QObject
+{
+    Q_OBJECT
+public:
+    static AvatarCache *instance();
+
+    // size 为逻辑像素, 为空时保持原始大小
+    QPixmap avatar(const QString &path, const QSize &size, qreal ratio, bool round);
+
+    QString cacheDir() const { return m_cacheDir; }
+
+    static QString key(const QString &path, const QSize &size, qreal ratio, bool round);
+    // 在 key 的基础上加上文件的修改时间和大小
+    static QString fileKey(const QFileInfo &info, const QSize &size, qreal ratio, bool round);
+    // 可以在任意线程调用
+    static QImage render(const QString &path, const QSize &size, qreal ratio, bool round, const QString &cacheDir);
+    static QImage toRound(const QImage &source);
+
+Q_SIGNALS:
+    void avatarReady(const QString &path);
+
+private:
+    explicit AvatarCache(QObject *parent = nullptr);
+
+private:
+    QString m_cacheDir;
+    QCache<QString, QPixmap> m_cache;
+    QSet<QString> m_pending;
+    QSet<QString> m_failed;
+};
+
+}   // namespace accounts
+}   // namespace DCC_NAMESPACE
@@ -22,6 +22,7 @@
 #include "avatarlistwidget.h"
 #include "modules/accounts/user.h"
 #include "avataritemdelegate.h"
+#include "avatarcache.h"
 
 #include <QWidget>
 #include <QListView>
@@ -55,6 +56,7 @@ AvatarListWidget::AvatarListWidget(User *usr, QWidget *parent)
     initWidgets();
 
     connect(this, &DListView::clicked, this, &AvatarListWidget::onItemClicked);
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, &AvatarListWidget::onAvatarReady);
 }
 
 AvatarListWidget::~AvatarListWidget()
@@ -110,7 +112,7 @@ void AvatarListWidget::refreshCustomAvatar(const QString& str)
         item = m_avatarItemModel->item(MaxAvatarSize);
     }
 
-    item->setData(QVariant::fromValue(QPixmap(customPicPath)), Qt::DecorationRole);
+    setItemAvatar(item, customPicPath);
     item->setData(QVariant::fromValue(customPicPath), AvatarListWidget::SaveAvatarRole);
     item->setData(m_avatarSize, Qt::SizeHintRole);
 
@@ -213,14 +215,42 @@ void AvatarListWidget::addItemFromDefaultDir()
         if (ratio > 1.0) {
             pxPath.replace("icons/", "icons/bigger/");
         }
-        auto px = QPixmap(pxPath).scaled(QSize(74, 74) * ratio,
-                                           Qt::KeepAspectRatio, Qt::FastTransformation);
-        px.setDevicePixelRatio(ratio);
-
-        item->setData(QVariant::fromValue(px), Qt::DecorationRole);
         item->setData(QVariant::fromValue(iconpath), AvatarListWidget::SaveAvatarRole);
         item->setData(m_avatarSize, Qt::SizeHintRole);
         m_avatarItemModel->appendRow(item);
+        setItemAvatar(item, pxPath);
+    }
+}
+
+void AvatarListWidget::setItemAvatar(QStandardItem *item, const QString &path)
+{
+    const QPersistentModelIndex index(item->index());
+    for (auto it = m_pendingAvatars.begin(); it != m_pendingAvatars.end();) {
+        if (it.value() == index) {
+            it = m_pendingAvatars.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // 头像在后台解码和缩放, 没有缓存时先显示空白, 生成后再填充
+    const QPixmap &px = AvatarCache::instance()->avatar(path, QSize(74, 74), devicePixelRatioF(), false);
+    item->setData(QVariant::fromValue(px), Qt::DecorationRole);
+    if (px.isNull())
+        m_pendingAvatars.insert(path, index);
+}
+
+void AvatarListWidget::onAvatarReady(const QString &path)
+{
+    const QList<QPersistentModelIndex> &indexes = m_pendingAvatars.values(path);
+    m_pendingAvatars.remove(path);
+
+    for (const QPersistentModelIndex &index : indexes) {
+        if (!index.isValid())
+            continue;
+
+        QStandardItem *item = m_avatarItemModel->itemFromIndex(index);
+        setItemAvatar(item, path);
     }
 }
 
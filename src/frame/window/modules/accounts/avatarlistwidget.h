@@ -30,11 +30,14 @@
 #include <DListView>
 
 #include <QWidget>
+#include <QMultiHash>
+#include <QPersistentModelIndex>
 
 QT_BEGIN_NAMESPACE
 class QVBoxLayout;
 class QLabel;
 class QListView;
+class QStandardItem;
 class QStandardItemModel;
 class QModelIndex;
 QT_END_NAMESPACE
@@ -72,9 +75,11 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void onItemClicked(const QModelIndex &index);
+    void onAvatarReady(const QString &path);
 
 private:
     void initWidgets();
+    void setItemAvatar(QStandardItem *item, const QString &path);
     QString getUserAddedCustomPicPath(const QString &usrName);
 
 private:
@@ -85,6 +90,8 @@ private:
     QSize m_avatarSize;
     QModelIndex m_currentSelectIndex;
     bool m_displayLastItem;
+    // 等待生成的头像路径 -> 列表项
+    QMultiHash<QString, QPersistentModelIndex> m_pendingAvatars;
 };
 
 }
@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2011 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     liuhong <liuhong_cm@deepin.com>
+ *
+ * Maintainer: liuhong <liuhong_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "userlistmodel.h"
+#include "accountswidget.h"
+#include "avatarcache.h"
+#include "onlineicon.h"
+#include "modules/accounts/user.h"
+#include "window/utils.h"
+
+#include <DFontSizeManager>
+#include <DPalette>
+
+#include <QUrl>
+#include <QIcon>
+
+DWIDGET_USE_NAMESPACE
+using namespace dcc::accounts;
+using namespace DCC_NAMESPACE::accounts;
+
+UserListModel::UserListModel(QWidget *viewport, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_viewport(viewport)
+    , m_avatarSize(30, 30)
+{
+    connect(AvatarCache::instance(), &AvatarCache::avatarReady, this, &UserListModel::onAvatarReady);
+}
+
+UserListModel::~UserListModel()
+{
+    for (User *user : m_users)
+        releaseItem(user);
+}
+
+void UserListModel::addUser(User *user)
+{
+    if (m_users.contains(user))
+        return;
+
+    // 当前用户显示在第一个
+    const int row = user->isCurrentUser() ? 0 : m_users.size();
+    beginInsertRows(QModelIndex(), row, row);
+    m_users.insert(row, user);
+    endInsertRows();
+
+    connect(user, &User::nameChanged, this, [ = ] {
+        updateRow(user, { Qt::DisplayRole });
+    });
+    connect(user, &User::fullnameChanged, this, [ = ] {
+        updateRow(user, { Qt::DisplayRole });
+    });
+    connect(user, &User::currentAvatarChanged, this, [ = ] {
+        updateRow(user, { Qt::DecorationRole });
+    });
+    connect(user, &User::onlineChanged, this, [ = ] {
+        updateOnline(user);
+    });
+    connect(user, &User::userTypeChanged, this, [ = ] {
+        updateUserType(user);
+    });
+    connect(user, &User::isCurrentUserChanged, this, [ = ](bool isCurrentUser) {
+        if (isCurrentUser)
+            moveToFront(user);
+    });
+}
+
+void UserListModel::removeUser(User *user)
+{
+    const int row = m_users.indexOf(user);
+    if (row < 0)
+        return;
+
+    disconnect(user, nullptr, this, nullptr);
+    for (auto it = m_avatarRequests.begin(); it != m_avatarRequests.end();) {
+        if (it.value() == user) {
+            it = m_avatarRequests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    m_users.removeAt(row);
+    endRemoveRows();
+
+    releaseItem(user);
+}
+
+User *UserListModel::user(int row) const
+{
+    return m_users.value(row, nullptr);
+}
+
+void UserListModel::setAvatarSize(const QSize &size)
+{
+    if (m_avatarSize == size)
+        return;
+
+    m_avatarSize = size;
+    if (!m_users.isEmpty())
+        Q_EMIT dataChanged(index(0), index(m_users.size() - 1), { Qt::DecorationRole });
+}
+
+int UserListModel::indexOf(User *user) const
+{
+    return m_users.indexOf(user);
+}
+
+int UserListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_users.size();
+}
+
+QVariant UserListModel::data(const QModelIndex &index, int role) const
+{
+    User *user = this->user(index.row());
+    if (!index.isValid() || !user)
+        return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return user->displayName();
+    case Qt::DecorationRole: {
+        // 头像在后台生成, 生成后再刷新这一行
+        const QString &path = avatarPath(user);
+        const QPixmap &avatar = AvatarCache::instance()->avatar(path, m_avatarSize, m_viewport->devicePixelRatioF(), true);
+        if (avatar.isNull()) {
+            if (!m_avatarRequests.contains(path, user))
+                m_avatarRequests.insert(path, user);
+            return QVariant();
+        }
+        return QIcon(avatar);
+    }
+    case Dtk::RightActionListRole:
+        return QVariant::fromValue(DViewItemActionList { item(user).onlineFlag });
+    case Dtk::TextActionListRole:
+        if (IsServerSystem)
+            return QVariant::fromValue(DViewItemActionList { item(user).userType });
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+UserListModel::Item &UserListModel::item(User *user) const
+{
+    auto it = m_items.find(user);
+    if (it != m_items.end())
+        return it.value();
+
+    Item &item = m_items[user];
+    UserListModel *self = const_cast<UserListModel *>(this);
+
+    item.onlineFlag = new DViewItemAction(Qt::AlignCenter | Qt::AlignRight, QSize(), QSize(), true, self);
+    OnlineIcon *onlineIcon = new OnlineIcon(m_viewport);
+    onlineIcon->setFixedSize(12, 12);
+    item.onlineFlag->setWidget(onlineIcon);
+
+    if (IsServerSystem) {
+        /* 用户列表显示用户类型 */
+        item.userType = new DViewItemAction(Qt::AlignLeft, QSize(), QSize(), false, self);
+        item.userType->setFontSize(DFontSizeManager::T8);
+        item.userType->setTextColorRole(DPalette::TextTips);
+    }
+
+    self->updateOnline(user);
+    self->updateUserType(user);
+    return item;
+}
+
+void UserListModel::releaseItem(User *user)
+{
+    auto it = m_items.find(user);
+    if (it == m_items.end())
+        return;
+
+    if (it->onlineFlag) {
+        delete it->onlineFlag->widget();
+        delete it->onlineFlag;
+    }
+    delete it->userType;
+    m_items.erase(it);
+}
+
+void UserListModel::updateOnline(User *user)
+{
+    auto it = m_items.find(user);
+    if (it == m_items.end() || !it->onlineFlag)
+        return;
+
+    DViewItemAction *onlineFlag = it->onlineFlag;
+    onlineFlag->setVisible(user->online());
+    if (onlineFlag->widget()) {
+        onlineFlag->widget()->setVisible(onlineFlag->isVisible());
+    }
+}
+
+void UserListModel::updateUserType(User *user)
+{
+    auto it = m_items.find(user);
+    if (it == m_items.end() || !it->userType)
+        return;
+
+    if (user->userType() == User::UserType::Administrator) {
+        it->userType->setText(AccountsWidget::tr("Administrator"));
+    } else {
+        it->userType->setText(AccountsWidget::tr("Standard User"));
+    }
+}
+
+void UserListModel::updateRow(User *user, const QVector<int> &roles)
+{
+    const int row = m_users.indexOf(user);
+    if (row < 0)
+        return;
+
+    const QModelIndex &idx = index(row);
+    Q_EMIT dataChanged(idx, idx, roles);
+}
+
+void UserListModel::moveToFront(User *user)
+{
+    const int row = m_users.indexOf(user);
+    if (row <= 0)
+        return;
+
+    beginMoveRows(QModelIndex(), row, row, QModelIndex(), 0);
+    m_users.move(row, 0);
+    endMoveRows();
+}
+
+void UserListModel::onAvatarReady(const QString &path)
+{
+    for (User *user : m_avatarRequests.values(path))
+        updateRow(user, { Qt::DecorationRole });
+    m_avatarRequests.remove(path);
+}
+
+QString UserListModel::avatarPath(User *user) const
+{
+    auto path = user->currentAvatar();
+    if (m_viewport->devicePixelRatioF() > 4.0) {
+        path.replace("icons/", "icons/bigger/");
+    }
+    return path.startsWith("file://") ? QUrl(path).toLocalFile() : path;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2011 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     liuhong <liuhong_cm@deepin.com>
+ *
+ * Maintainer: liuhong <liuhong_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <DStyledItemDelegate>
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QSize>
+
+namespace dcc {
+namespace accounts {
+class User;
+}
+}
+
+namespace DCC_NAMESPACE {
+namespace accounts {
+
+/**
+ * @brief The UserListModel class 用户列表的数据
+ * 头像、在线状态等只在列表项第一次显示时创建, 用户很多时不需要为每个用户都创建列表项;
+ * 当前用户始终显示在第一个
+ */
+class UserListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // viewport 用于放置在线状态的控件
+    explicit UserListModel(QWidget *viewport, QObject *parent = nullptr);
+    ~UserListModel() override;
+
+    void addUser(dcc::accounts::User *user);
+    void removeUser(dcc::accounts::User *user);
+    dcc::accounts::User *user(int row) const;
+    void setAvatarSize(const QSize &size);
+    int indexOf(dcc::accounts::User *user) const;
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    struct Item {
+        DTK_WIDGET_NAMESPACE::DViewItemAction *onlineFlag = nullptr;
+        DTK_WIDGET_NAMESPACE::DViewItemAction *userType = nullptr;
+    };
+
+    Item &item(dcc::accounts::User *user) const;
+    void releaseItem(dcc::accounts::User *user);
+    void updateOnline(dcc::accounts::User *user);
+    void updateUserType(dcc::accounts::User *user);
+    void updateRow(dcc::accounts::User *user, const QVector<int> &roles);
+    void moveToFront(dcc::accounts::User *user);
+    void onAvatarReady(const QString &path);
+    QString avatarPath(dcc::accounts::User *user) const;
+
+private:
+    QWidget *m_viewport;
+    QSize m_avatarSize;
+    QList<dcc::accounts::User *> m_users;
+    // 已经显示过的列表项
+    mutable QHash<dcc::accounts::User *, Item> m_items;
+    // 等待生成的头像路径 -> 用户
+    mutable QMultiHash<QString, dcc::accounts::User *> m_avatarRequests;
+};
+
+}   // namespace accounts
+}   // namespace DCC_NAMESPACE
@@ -185,6 +185,12 @@ void DeviceSettingsItem::setDevice(const Device *device)
             m_deviceItem->setText(alias);
         }
     });
+    // 设备名称在原位置更新,不再重新添加设备
+    connect(device, &Device::nameChanged, this, [this](const QString &name) {
+        if (m_deviceItem && m_device->alias().isEmpty()) {
+            m_deviceItem->setText(name);
+        }
+    });
 
     onDeviceStateChanged(device->state(), device->connectState());
     onDevicePairedChanged(device->paired());
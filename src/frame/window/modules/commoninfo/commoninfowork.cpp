@@ -38,6 +38,19 @@ using namespace commoninfo;
 
 const QString UeProgramInterface("com.deepin.userexperience.Daemon");
 const QString UeProgramObjPath("/com/deepin/userexperience/Daemon");
+const QString GrubService("com.deepin.daemon.Grub2");
+const QString DeepinIdService("com.deepin.deepinid");
+const QString LicenseService("com.deepin.license");
+
+QStringList CommonInfoWork::sessionServices()
+{
+    return { DeepinIdService };
+}
+
+QStringList CommonInfoWork::systemServices()
+{
+    return { GrubService, LicenseService };
+}
 
 CommonInfoWork::CommonInfoWork(CommonInfoModel *model, QObject *parent)
     : QObject(parent)
@@ -45,20 +58,20 @@ CommonInfoWork::CommonInfoWork(CommonInfoModel *model, QObject *parent)
     , m_title("")
     , m_content("")
 {
-    m_dBusGrub = new GrubDbus("com.deepin.daemon.Grub2",
+    m_dBusGrub = new GrubDbus(GrubService,
                              "/com/deepin/daemon/Grub2",
                              QDBusConnection::systemBus(),
                              this);
 
-    m_dBusGrubTheme = new GrubThemeDbus("com.deepin.daemon.Grub2",
+    m_dBusGrubTheme = new GrubThemeDbus(GrubService,
                                        "/com/deepin/daemon/Grub2/Theme",
                                        QDBusConnection::systemBus(), this);
 
-    m_dBusdeepinIdInter = new GrubDevelopMode("com.deepin.deepinid",
+    m_dBusdeepinIdInter = new GrubDevelopMode(DeepinIdService,
                                                 "/com/deepin/deepinid",
                                                 QDBusConnection::sessionBus(), this);
 
-    m_activeInfo = new QDBusInterface("com.deepin.license",
+    m_activeInfo = new QDBusInterface(LicenseService,
                                       "/com/deepin/license/Info",
                                       "com.deepin.license.Info",
                                       QDBusConnection::systemBus(),this);
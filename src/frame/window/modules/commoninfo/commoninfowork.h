@@ -45,6 +45,10 @@ class CommonInfoWork : public QObject
     Q_OBJECT
 public:
     explicit CommonInfoWork(CommonInfoModel *model, QObject *parent = nullptr);
+
+    // 构造时访问的 DBus 服务
+    static QStringList sessionServices();
+    static QStringList systemServices();
     virtual ~CommonInfoWork();
 
     void activate();
@@ -54,6 +54,11 @@ using namespace dcc::widgets;
 using namespace DCC_NAMESPACE::network;
 using namespace dde::network;
 
+QStringList NetworkModule::sessionServices()
+{
+    return { "com.deepin.daemon.Network" };
+}
+
 NetworkModule::NetworkModule(DCC_NAMESPACE::FrameProxyInterface *frame, QObject *parent)
     : QObject(parent)
     , ModuleInterface(frame)
@@ -50,6 +50,9 @@ class NetworkModule : public QObject, public ModuleInterface
 
 public:
     explicit NetworkModule(FrameProxyInterface *frame, QObject *parent = nullptr);
+
+    // NetworkWorker(dde-network-utils) 构造时访问的会话总线服务
+    static QStringList sessionServices();
     ~NetworkModule();
     void showPage(const QString &jsonData) override;
 
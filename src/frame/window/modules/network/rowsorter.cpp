@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *             listenerri <listenerri@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rowsorter.h"
+
+#include <QHash>
+#include <QList>
+#include <QStandardItemModel>
+
+#include <algorithm>
+
+namespace DCC_NAMESPACE {
+namespace network {
+
+QVector<bool> longestIncreasing(const QVector<int> &seq)
+{
+    const int n = seq.size();
+    // tails[k] 为长度 k + 1 的递增子序列中最小结尾的下标
+    QVector<int> tails;
+    QVector<int> prev(n, -1);
+    for (int i = 0; i < n; ++i) {
+        auto it = std::lower_bound(tails.begin(), tails.end(), seq.at(i), [&seq](int idx, int value) {
+            return seq.at(idx) < value;
+        });
+        const int k = static_cast<int>(it - tails.begin());
+        prev[i] = k > 0 ? tails.at(k - 1) : -1;
+        if (k == tails.size()) {
+            tails.append(i);
+        } else {
+            tails[k] = i;
+        }
+    }
+
+    QVector<bool> keep(n, false);
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i != -1; i = prev.at(i))
+        keep[i] = true;
+
+    return keep;
+}
+
+int sortRows(QStandardItemModel *model,
+             const std::function<bool(const QStandardItem *, const QStandardItem *)> &lessThan,
+             const std::function<void(QStandardItem *, int)> &moved)
+{
+    const int count = model->rowCount();
+    QList<QStandardItem *> sorted;
+    sorted.reserve(count);
+    for (int i = 0; i < count; ++i)
+        sorted << model->item(i);
+
+    std::stable_sort(sorted.begin(), sorted.end(), lessThan);
+
+    QHash<const QStandardItem *, int> target;
+    target.reserve(count);
+    for (int i = 0; i < count; ++i)
+        target.insert(sorted.at(i), i);
+
+    QVector<int> ranks(count);
+    for (int i = 0; i < count; ++i)
+        ranks[i] = target.value(model->item(i));
+
+    const QVector<bool> &keep = longestIncreasing(ranks);
+    QList<QStandardItem *> moving;
+    for (int i = count - 1; i >= 0; --i) {
+        if (!keep.at(i))
+            moving << model->takeRow(i).first();
+    }
+
+    std::sort(moving.begin(), moving.end(), [&target](const QStandardItem *a, const QStandardItem *b) {
+        return target.value(a) < target.value(b);
+    });
+
+    // 按目标位置从小到大插入, 插入时前面的项都已经就位
+    for (QStandardItem *item : moving) {
+        const int row = target.value(item);
+        model->insertRow(row, item);
+        if (moved)
+            moved(item, row);
+    }
+
+    return moving.size();
+}
+
+}
+}
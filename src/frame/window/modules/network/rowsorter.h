@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2011 ~ 2018 Deepin Technology Co., Ltd.
+ *
+ * Author:     sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *
+ * Maintainer: sbw <sbw@sbw.so>
+ *             kirigaya <kirigaya@mkacg.com>
+ *             Hualet <mr.asianwang@gmail.com>
+ *             listenerri <listenerri@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ROWSORTER_H
+#define ROWSORTER_H
+
+#include "interface/namespace.h"
+
+#include <QVector>
+
+#include <functional>
+
+class QStandardItem;
+class QStandardItemModel;
+
+namespace DCC_NAMESPACE {
+namespace network {
+
+// 返回 seq 的一个最长递增子序列, 这些位置上的项不需要移动
+QVector<bool> longestIncreasing(const QVector<int> &seq);
+
+// 按 lessThan 稳定排序 model 的行, 只移动不在最长递增子序列中的行, 不需要整个列表重新布局;
+// 每移动一行调用一次 moved, 视图可以在其中恢复该行的隐藏状态. 返回移动的行数
+int sortRows(QStandardItemModel *model,
+             const std::function<bool(const QStandardItem *, const QStandardItem *)> &lessThan,
+             const std::function<void(QStandardItem *, int)> &moved = nullptr);
+
+}
+}
+
+#endif // ROWSORTER_H
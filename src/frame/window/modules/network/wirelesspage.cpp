@@ -25,6 +25,7 @@
  */
 
 #include "wirelesspage.h"
+#include "rowsorter.h"
 #include "connectionwirelesseditpage.h"
 #include "widgets/settingsgroup.h"
 #include "widgets/switchwidget.h"
@@ -57,6 +58,11 @@ using namespace dcc::widgets;
 using namespace DCC_NAMESPACE::network;
 using namespace dde::network;
 
+namespace {
+// 信号强度变化小于这个值时不更新图标和排序, 避免列表来回跳动
+const int StrengthHysteresis = 10;
+}
+
 APItem::APItem(const QString &text, QStyle *style, DTK_WIDGET_NAMESPACE::DListView *parent)
     : DStandardItem(text)
     , m_parentView(nullptr)
@@ -256,8 +262,9 @@ WirelessPage::WirelessPage(WirelessDevice *dev, QWidget *parent)
     , m_lvAP(new DListView(this))
     , m_clickedItem(nullptr)
     , m_modelAP(new QStandardItemModel(m_lvAP))
-    , m_sortDelayTimer(new QTimer(this))
+    , m_batchTimer(new QTimer(this))
     , m_autoConnectHideSsid("")
+    , m_sortRequested(false)
 {
     qRegisterMetaType<APSortInfo>();
     m_preWifiStatus = Wifi_Unknown;
@@ -277,8 +284,8 @@ WirelessPage::WirelessPage(WirelessDevice *dev, QWidget *parent)
     scroller->setScrollerProperties(sp);
 
     m_modelAP->setSortRole(APItem::SortRole);
-    m_sortDelayTimer->setInterval(100);
-    m_sortDelayTimer->setSingleShot(true);
+    m_batchTimer->setInterval(1000 / 60);
+    m_batchTimer->setSingleShot(true);
 
     APItem *nonbc = new APItem(tr("Connect to hidden network"), style());
     nonbc->setSignalStrength(-1);
@@ -349,7 +356,7 @@ WirelessPage::WirelessPage(WirelessDevice *dev, QWidget *parent)
                                          idx.data(Qt::ItemDataRole::DisplayRole).toString());
     });
 
-    connect(m_sortDelayTimer, &QTimer::timeout, this, &WirelessPage::sortAPList);
+    connect(m_batchTimer, &QTimer::timeout, this, &WirelessPage::flushAPChanges);
     connect(m_closeHotspotBtn, &QPushButton::clicked, this, &WirelessPage::onCloseHotspotClicked);
     connect(m_device, &WirelessDevice::apAdded, this, &WirelessPage::onAPAdded);
     connect(m_device, &WirelessDevice::apInfoChanged, this, &WirelessPage::onAPChanged);
@@ -495,7 +502,7 @@ void WirelessPage::onAPAdded(const QJsonObject &apInfo)
             this->onApWidgetEditRequested(apItem->data(APItem::PathRole).toString(),
                                           apItem->data(Qt::ItemDataRole::DisplayRole).toString());
         });
-        m_sortDelayTimer->start();
+        requestSort();
     }
 }
 
@@ -514,33 +521,67 @@ void WirelessPage::onAPChanged(const QJsonObject &apInfo)
             this->onApWidgetEditRequested(apItem->data(APItem::PathRole).toString(),
                                           apItem->data(Qt::ItemDataRole::DisplayRole).toString());
         });
-        m_sortDelayTimer->start();
+        requestSort();
         return;
     }
 
+    // 同一个 ap 在一帧内的多次变化只处理最后一次
+    m_pendingAps.insert(ssid, apInfo);
+    if (!m_batchTimer->isActive())
+        m_batchTimer->start();
+}
+
+bool WirelessPage::applyAPChange(const QJsonObject &apInfo)
+{
+    const QString &ssid = apInfo.value("Ssid").toString();
+    APItem *it = m_apItems.value(ssid);
+    if (!it)
+        return false;
+
     const QString &path = apInfo.value("Path").toString();
     const int strength = apInfo.value("Strength").toInt();
     const bool isSecure = apInfo.value("Secured").toBool();
+    const bool isConnected = ssid == m_device->activeApSsid();
 
-    APItem *it = m_apItems[ssid];
-
-    if (strength < 5 && !it->checkState() && ssid != m_device->activeApSsid()) {
+    if (strength < 5 && !it->checkState() && !isConnected) {
         if (nullptr == m_clickedItem || it->uuid() != m_clickedItem->uuid()) {
-            m_lvAP->setRowHidden(it->row(), true);
+            setAPHidden(it, true);
         }
     } else {
-        m_lvAP->setRowHidden(it->row(), false);
+        setAPHidden(it, false);
     }
 
-    APSortInfo si{strength, ssid, ssid == m_device->activeApSsid()};
-    m_apItems[ssid]->setSortInfo(si);
+    APSortInfo si = it->sortInfo();
+    const bool strengthChanged = qAbs(strength - si.signalstrength) >= StrengthHysteresis;
+    const bool sortChanged = strengthChanged || si.connected != isConnected;
+    if (sortChanged) {
+        si.ssid = ssid;
+        si.connected = isConnected;
+        if (strengthChanged)
+            si.signalstrength = strength;
+        it->setSortInfo(si);
+        if (strengthChanged)
+            it->setSignalStrength(strength);
+    }
 
-    m_apItems[ssid]->setSignalStrength(strength);
     if (it->path() != path) {
-        m_apItems[ssid]->setPath(path);
+        it->setPath(path);
+    }
+    if (it->secure() != isSecure) {
+        it->setSecure(isSecure);
+    }
+
+    return sortChanged;
+}
+
+void WirelessPage::setAPHidden(APItem *item, bool hidden)
+{
+    if (hidden) {
+        m_hiddenAps.insert(item);
+    } else {
+        m_hiddenAps.remove(item);
     }
-    it->setSecure(isSecure);
-    m_sortDelayTimer->start();
+    m_lvAP->setRowHidden(item->row(), hidden);
 }
 
 void WirelessPage::onAPRemoved(const QJsonObject &apInfo)
@@ -558,6 +599,8 @@ void WirelessPage::onAPRemoved(const QJsonObject &apInfo)
             m_clickedItem = nullptr;
             qDebug() << "remove clicked item," << QThread::currentThreadId();
         }
+        m_hiddenAps.remove(m_apItems[ssid]);
+        m_pendingAps.remove(ssid);
         m_modelAP->removeRow(m_modelAP->indexFromItem(m_apItems[ssid]).row());
         m_apItems.erase(m_apItems.find(ssid));
     }
@@ -607,9 +650,37 @@ void WirelessPage::onActivateApFailed(const QString &apPath, const QString &uuid
     }
 }
 
+void WirelessPage::requestSort()
+{
+    m_sortRequested = true;
+    if (!m_batchTimer->isActive())
+        m_batchTimer->start();
+}
+
+void WirelessPage::flushAPChanges()
+{
+    bool needSort = m_sortRequested;
+    m_sortRequested = false;
+
+    const QHash<QString, QJsonObject> pending = m_pendingAps;
+    m_pendingAps.clear();
+    for (const QJsonObject &apInfo : pending) {
+        if (applyAPChange(apInfo))
+            needSort = true;
+    }
+
+    if (needSort)
+        sortAPList();
+}
+
 void WirelessPage::sortAPList()
 {
-    m_modelAP->sort(0, Qt::SortOrder::DescendingOrder);
+    // 移动的行在视图中会丢失隐藏状态, 移动后恢复
+    sortRows(m_modelAP, [](const QStandardItem *a, const QStandardItem *b) {
+        return *b < *a;
+    }, [this](QStandardItem *item, int row) {
+        m_lvAP->setRowHidden(row, m_hiddenAps.contains(static_cast<APItem *>(item)));
+    });
 }
 
 void WirelessPage::onApWidgetEditRequested(const QString &apPath, const QString &ssid)
@@ -736,7 +807,7 @@ void WirelessPage::updateActiveAp()
             });
         }
     }
-    m_sortDelayTimer->start();
+    requestSort();
 }
 
 QString WirelessPage::connectionUuid(const QString &ssid)
@@ -37,6 +37,9 @@
 #include <DSpinner>
 
 #include <QPointer>
+#include <QHash>
+#include <QSet>
+#include <QJsonObject>
 
 QT_BEGIN_NAMESPACE
 class QTimer;
@@ -153,6 +156,7 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void sortAPList();
+    void flushAPChanges();
     void onApWidgetEditRequested(const QString &apPath, const QString &ssid);
     void onApWidgetConnectRequested(const QString &path, const QString &ssid);
     void showConnectHidePage();
@@ -162,6 +166,9 @@ private Q_SLOTS:
 
 private:
     void updateActiveAp();
+    void requestSort();
+    bool applyAPChange(const QJsonObject &apInfo);
+    void setAPHidden(APItem *item, bool hidden);
     QString connectionUuid(const QString &ssid);
     QString connectionSsid(const QString &uuid);
     void updateLayout(bool enabled);
@@ -183,9 +190,13 @@ private:
 
     QString m_editingUuid;
     QString m_lastConnectSsid;
-    QTimer *m_sortDelayTimer;
+    // 一帧内的 ap 变化合并后统一处理
+    QTimer *m_batchTimer;
     QMap<QString, APItem *> m_apItems;
     QString m_autoConnectHideSsid;
+    QHash<QString, QJsonObject> m_pendingAps;
+    QSet<APItem *> m_hiddenAps;
+    bool m_sortRequested;
 };
 }   // namespace dcc
 }   // namespace network
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "fontlistmodel.h"
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::personalization;
+
+FontListModel::FontListModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_pixelSize(0)
+{
+}
+
+void FontListModel::setNames(const QStringList &names)
+{
+    beginResetModel();
+    m_names = names;
+    m_fonts.clear();
+    endResetModel();
+}
+
+void FontListModel::setPixelSize(int pixelSize)
+{
+    if (m_pixelSize == pixelSize)
+        return;
+
+    m_pixelSize = pixelSize;
+    m_fonts.clear();
+    if (!m_names.isEmpty())
+        Q_EMIT dataChanged(index(0), index(m_names.size() - 1), { Qt::FontRole });
+}
+
+int FontListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_names.size();
+}
+
+QVariant FontListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_names.size())
+        return QVariant();
+
+    switch (role) {
+    case Qt::DisplayRole:
+    case Qt::EditRole:
+        return m_names.at(index.row());
+    case Qt::FontRole: {
+        auto it = m_fonts.constFind(index.row());
+        if (it == m_fonts.cend()) {
+            QFont font(m_names.at(index.row()));
+            if (m_pixelSize > 0)
+                font.setPixelSize(m_pixelSize);
+            it = m_fonts.insert(index.row(), font);
+        }
+        return it.value();
+    }
+    default:
+        return QVariant();
+    }
+}
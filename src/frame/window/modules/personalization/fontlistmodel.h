@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QHash>
+#include <QFont>
+
+namespace DCC_NAMESPACE {
+namespace personalization {
+
+/**
+ * @brief The FontListModel class 字体下拉框的数据
+ * 只保存字体名称, 每一项的 QFont 在第一次显示时才创建, 安装了大量字体时不需要一次创建所有的列表项
+ */
+class FontListModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    explicit FontListModel(QObject *parent = nullptr);
+
+    void setNames(const QStringList &names);
+    // 小于等于 0 时使用字体的默认大小
+    void setPixelSize(int pixelSize);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList m_names;
+    int m_pixelSize;
+    mutable QHash<int, QFont> m_fonts;
+};
+
+}
+}
@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "personalizationfontswidget.h"
+#include "fontlistmodel.h"
 
 #include "widgets/titledslideritem.h"
 #include "widgets/dccslider.h"
@@ -35,7 +36,6 @@
 #include <QHBoxLayout>
 #include <QLabel>
 #include <QComboBox>
-#include <QStandardItemModel>
 #include <QDebug>
 #include <QTimer>
 
@@ -87,7 +87,7 @@ PersonalizationFontsWidget::PersonalizationFontsWidget(QWidget *parent)
     sfontLayout->addWidget(sfLabel);
     sfontLayout->addWidget(m_standardFontsCbBox);
 
-    m_standardFontsCbBox->setModel(new QStandardItemModel(this));
+    m_standardFontsCbBox->setModel(new FontListModel(this));
     m_standardFontsCbBox->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
     m_centralLayout->addWidget(sfontitem);
 
@@ -104,7 +104,7 @@ PersonalizationFontsWidget::PersonalizationFontsWidget(QWidget *parent)
     mfLabel->setFixedWidth(140);
     mfontLayout->addWidget(mfLabel);
     mfontLayout->addWidget(m_monoFontsCbBox);
-    m_monoFontsCbBox->setModel(new QStandardItemModel(this));
+    m_monoFontsCbBox->setModel(new FontListModel(this));
     m_centralLayout->addWidget(mfontitem);
     m_centralLayout->addStretch();
     setLayout(m_centralLayout);
@@ -159,23 +159,19 @@ void PersonalizationFontsWidget::setFontSize(int size)
 
 void PersonalizationFontsWidget::setList(const QList<QJsonObject> &list, dcc::personalization::FontModel *model)
 {
-    QStandardItemModel *fontModel{nullptr};
     if (sender())
         model = qobject_cast<dcc::personalization::FontModel *>(sender());
 
     QComboBox *combox{nullptr};
     combox = (model == m_model->getStandFontModel()) ? m_standardFontsCbBox : m_monoFontsCbBox;
-    fontModel = dynamic_cast<QStandardItemModel *>(combox->model());
 
-    //clear the model
-    fontModel->clear();
+    QStringList names;
+    names.reserve(list.size());
+    for (const QJsonObject &item : list)
+        names << item["Name"].toString();
+
     m_isAppend = true;
-    for (QJsonObject item : list) {
-        QString name = item["Name"].toString();
-        QStandardItem *modelItem = new QStandardItem(name);
-        modelItem->setFont(QFont(name));
-        fontModel->appendRow(modelItem);
-    }
+    qobject_cast<FontListModel *>(combox->model())->setNames(names);
     m_isAppend = false;
 
     onDefaultFontChanged(model->getFontName(), model);
@@ -183,19 +179,9 @@ void PersonalizationFontsWidget::setList(const QList<QJsonObject> &list, dcc::pe
 
 void PersonalizationFontsWidget::setCommboxItemFontSize()
 {
-    auto setCommboxSize = [=](QComboBox *cb){
-        auto model = qobject_cast<QStandardItemModel *>(cb->model());
-        for (auto i = 0; i < model->rowCount(); ++i) {
-            auto item = model->item(i);
-            auto font = item->font();
-            auto fsize = DFontSizeManager::instance()->t7().pixelSize();
-            font.setPixelSize(fsize);
-            item->setFont(font);
-        }
-    };
-
-    setCommboxSize(m_standardFontsCbBox);
-    setCommboxSize(m_monoFontsCbBox);
+    const int fsize = DFontSizeManager::instance()->t7().pixelSize();
+    qobject_cast<FontListModel *>(m_standardFontsCbBox->model())->setPixelSize(fsize);
+    qobject_cast<FontListModel *>(m_monoFontsCbBox->model())->setPixelSize(fsize);
 }
 
 void PersonalizationFontsWidget::onSelectChanged(const QString &name)
@@ -19,6 +19,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "personalizationthemelist.h"
+#include "thumbnailloader.h"
 #include "modules/personalization/model/thememodel.h"
 #include "window/utils.h"
 
@@ -34,7 +35,9 @@ DWIDGET_USE_NAMESPACE
 
 PerssonalizationThemeList::PerssonalizationThemeList(QWidget *parent)
     : QWidget(parent)
+    , m_model(nullptr)
     , m_listview(new DListView)
+    , m_thumbnailLoader(new ThumbnailLoader(QString(), this))
 {
     QVBoxLayout *layout = new QVBoxLayout;
     layout->setMargin(0);
@@ -53,6 +56,7 @@ PerssonalizationThemeList::PerssonalizationThemeList(QWidget *parent)
     layout->setContentsMargins(pageMargins);
     this->setLayout(layout);
     connect(m_listview, &DListView::clicked, this, &PerssonalizationThemeList::onClicked);
+    connect(m_thumbnailLoader, &ThumbnailLoader::thumbnailReady, this, &PerssonalizationThemeList::onThumbnailReady);
 
     QScroller *scroller = QScroller::scroller(m_listview->viewport());
     QScrollerProperties sp;
@@ -93,10 +97,12 @@ void PerssonalizationThemeList::setModel(dcc::personalization::ThemeModel *const
 
 void PerssonalizationThemeList::onAddItem(const QJsonObject &json)
 {
-    if (m_jsonMap.values().contains(json))
+    const QString &title = json["Id"].toString();
+    if (m_items.contains(title)) {
+        m_jsonMap.insert(title, json);
         return;
+    }
 
-    const QString &title = json["Id"].toString();
     m_jsonMap.insert(title, json);
 
     DStandardItem *item = new DStandardItem;
@@ -119,50 +125,53 @@ void PerssonalizationThemeList::onAddItem(const QJsonObject &json)
     item->setData(title, IDRole); //set id data
     item->setCheckState(title == m_model->getDefault() ? Qt::Checked : Qt::Unchecked);
     qobject_cast<QStandardItemModel *>(m_listview->model())->appendRow(item);
+    m_items.insert(title, item);
 }
 
 void PerssonalizationThemeList::setDefault(const QString &name)
 {
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(m_listview->model());
+    // 只需要更新原来的和新的默认项
+    if (DStandardItem *item = m_items.value(m_default))
+        item->setCheckState(Qt::Unchecked);
 
-    for (int i = 0; i < model->rowCount(); ++i) {
-        DStandardItem *item = dynamic_cast<DStandardItem *>(model->item(i, 0));
-        item->setCheckState((item->data(IDRole).toString() == name) ? Qt::Checked : Qt::Unchecked);
-    }
+    m_default = name;
+    if (DStandardItem *item = m_items.value(m_default))
+        item->setCheckState(Qt::Checked);
 }
 
 void PerssonalizationThemeList::onSetPic(const QString &id, const QString &picPath)
 {
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(m_listview->model());
-
-    for (int i = 0; i < model->rowCount(); ++i) {
-        DStandardItem *item = dynamic_cast<DStandardItem *>(model->item(i, 0));
-
-        if (item->data(IDRole).toString() != id)
-            continue;
+    if (!m_items.contains(id))
+        return;
 
-        DViewItemActionList list;
-        QPixmap pxmap = QPixmap(picPath);
-        DViewItemAction *iconAction = new DViewItemAction(Qt::AlignLeft, pxmap.size() / devicePixelRatioF());
-        iconAction->setIcon(QIcon(pxmap));
-        list << iconAction;
-        item->setActionList(Qt::BottomEdge, list);
+    // 缩略图比列表宽时在后台缩小, 解码也在后台完成
+    const int width = m_listview->viewport()->width();
+    const QSize maxSize = width > 0 ? QSize(width, QWIDGETSIZE_MAX) * devicePixelRatioF() : QSize();
+    m_thumbnailLoader->load(id, picPath, maxSize);
+}
 
+void PerssonalizationThemeList::onThumbnailReady(const QString &id, const QImage &image)
+{
+    DStandardItem *item = m_items.value(id);
+    if (!item)
         return;
-    }
+
+    DViewItemActionList list;
+    QPixmap pxmap = QPixmap::fromImage(image);
+    DViewItemAction *iconAction = new DViewItemAction(Qt::AlignLeft, pxmap.size() / devicePixelRatioF());
+    iconAction->setIcon(QIcon(pxmap));
+    list << iconAction;
+    item->setActionList(Qt::BottomEdge, list);
 }
 
 void PerssonalizationThemeList::onRemoveItem(const QString &id)
 {
-    QStandardItemModel *model = qobject_cast<QStandardItemModel *>(m_listview->model());
+    DStandardItem *item = m_items.take(id);
+    if (!item)
+        return;
 
-    for (int i = 0; i < model->rowCount(); ++i) {
-        DStandardItem *item = dynamic_cast<DStandardItem *>(model->item(i, 0));
-        if (item->data(IDRole).toString() == id) {
-            model->removeRow(i);
-            break;
-        }
-    }
+    m_thumbnailLoader->cancel(id);
+    qobject_cast<QStandardItemModel *>(m_listview->model())->removeRow(item->row());
 }
 
 void PerssonalizationThemeList::onClicked(const QModelIndex &index)
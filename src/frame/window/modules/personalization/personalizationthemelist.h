@@ -27,6 +27,7 @@
 
 #include <QWidget>
 #include <QJsonObject>
+#include <QHash>
 
 namespace dcc {
 namespace personalization {
@@ -36,10 +37,13 @@ class ThemeModel;
 
 DWIDGET_BEGIN_NAMESPACE
 class DListView;
+class DStandardItem;
 DWIDGET_END_NAMESPACE
 
 namespace DCC_NAMESPACE {
 namespace personalization {
+class ThumbnailLoader;
+
 class PerssonalizationThemeList : public QWidget
 {
     Q_OBJECT
@@ -59,6 +63,9 @@ public Q_SLOTS:
     void onRemoveItem(const QString &id);
     void onClicked(const QModelIndex &);
 
+private Q_SLOTS:
+    void onThumbnailReady(const QString &id, const QImage &image);
+
 private:
     enum PersonalizationItemDataRole{
         IDRole = DTK_NAMESPACE::UserRole + 1,
@@ -68,6 +75,10 @@ protected:
     QMap<QString, QJsonObject> m_jsonMap;
     dcc::personalization::ThemeModel *m_model;
     DTK_WIDGET_NAMESPACE::DListView *m_listview;
+    // id -> 列表项, 查找时不需要遍历整个列表
+    QHash<QString, DTK_WIDGET_NAMESPACE::DStandardItem *> m_items;
+    QString m_default;
+    ThumbnailLoader *m_thumbnailLoader;
 };
 }
 }
@@ -19,28 +19,27 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "themeitempic.h"
+#include "themepreviewcache.h"
 
 #include <DStyle>
-#include <DSvgRenderer>
 
 #include <QMouseEvent>
 #include <QBitmap>
 #include <QPainter>
-#include <QPainterPath>
-#include <QImage>
 #include <QDebug>
 
 using namespace DCC_NAMESPACE;
 using namespace DCC_NAMESPACE::personalization;
 DWIDGET_USE_NAMESPACE
-DGUI_USE_NAMESPACE
-using DTK_GUI_NAMESPACE::DSvgRenderer;
 
 ThemeItemPic::ThemeItemPic(QWidget *parent)
     : QWidget(parent)
     , m_isSelected(false)
-    , render(new DSvgRenderer())
 {
+    connect(ThemePreviewCache::instance(), &ThemePreviewCache::previewReady, this, [this](const QString &path) {
+        if (path == m_path)
+            update();
+    });
 }
 
 bool ThemeItemPic::isSelected()
@@ -56,8 +55,9 @@ void ThemeItemPic::setSelected(bool selected)
 
 void ThemeItemPic::setPath(const QString &picPath)
 {
-    render->load(picPath);
-    QSize defaultSize = render->defaultSize();
+    m_path = picPath;
+    m_picSize = ThemePreviewCache::instance()->defaultSize(picPath);
+    QSize defaultSize = m_picSize;
 
     int margins = style()->pixelMetric(static_cast<QStyle::PixelMetric>(DStyle::PM_FrameMargins));
     int borderWidth = style()->pixelMetric(static_cast<QStyle::PixelMetric>(DStyle::PM_FocusBorderWidth), nullptr, nullptr);
@@ -69,7 +69,6 @@ void ThemeItemPic::setPath(const QString &picPath)
 
 ThemeItemPic::~ThemeItemPic()
 {
-    render->deleteLater();
 }
 
 void ThemeItemPic::mousePressEvent(QMouseEvent* event)
@@ -92,27 +91,14 @@ void ThemeItemPic::paintEvent(QPaintEvent *event)
     QPainter painter(this);
     painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
 
-    //first draw image
-    const auto ratio = devicePixelRatioF();
-    QSize defaultSize = render->defaultSize() * ratio;
-    QImage img = render->toImage(defaultSize);
-    QRect picRect = rect().adjusted(totalSpace, totalSpace, -totalSpace, -totalSpace);
-    painter.drawImage(picRect, img, img.rect());
-
-    //second draw picture rounded rect bound
-    QPen pen;
-    pen.setColor(palette().base().color());
-    painter.setPen(pen);
-    painter.drawRoundedRect(picRect, radius, radius);
-
-    //third fill space with base brush
-    QPainterPath picPath;
-    picPath.addRect(picRect);
-    QPainterPath roundPath;
-    roundPath.addRoundedRect(picRect, radius, radius);
-    QPainterPath anglePath = picPath - roundPath;
-    painter.fillPath(anglePath, palette().base().color());
-    painter.strokePath(picPath, palette().base().color());
+    //预览图和圆角边框在后台生成好,这里只需要贴图
+    if (!m_path.isEmpty()) {
+        QRect picRect = rect().adjusted(totalSpace, totalSpace, -totalSpace, -totalSpace);
+        const QPixmap &pixmap = ThemePreviewCache::instance()->preview(m_path, m_picSize, devicePixelRatioF(),
+                                                                       palette().base().color(), radius);
+        if (!pixmap.isNull())
+            painter.drawPixmap(picRect.topLeft() - QPoint(1, 1), pixmap);
+    }
 
     //last draw focus rectangle
     if (m_isSelected) {
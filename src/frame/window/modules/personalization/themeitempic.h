@@ -22,8 +22,6 @@
 
 #include "interface/namespace.h"
 
-#include <DSvgRenderer>
-
 #include <QWidget>
 
 class QSize;
@@ -49,7 +47,8 @@ protected:
 
 private:
     bool m_isSelected = false;
-    DTK_GUI_NAMESPACE::DSvgRenderer *render;
+    QString m_path;
+    QSize m_picSize;
 };
 }
 }
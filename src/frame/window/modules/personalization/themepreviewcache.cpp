@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "themepreviewcache.h"
+
+#include <DSvgRenderer>
+
+#include <QAtomicInt>
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QPainter>
+#include <QPainterPath>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::personalization;
+using DTK_GUI_NAMESPACE::DSvgRenderer;
+
+namespace {
+// 缓存上限, 单位 KB
+const int MaxCacheCost = 64 * 1024;
+
+QAtomicInt RasterizeCount;
+}
+
+ThemePreviewCache *ThemePreviewCache::instance()
+{
+    static ThemePreviewCache *cache = new ThemePreviewCache;
+    return cache;
+}
+
+ThemePreviewCache::ThemePreviewCache(QObject *parent)
+    : QObject(parent)
+    , m_cache(MaxCacheCost)
+{
+}
+
+QSize ThemePreviewCache::defaultSize(const QString &path)
+{
+    auto it = m_sizes.constFind(path);
+    if (it != m_sizes.cend())
+        return it.value();
+
+    DSvgRenderer render;
+    render.load(path);
+    return m_sizes.insert(path, render.defaultSize()).value();
+}
+
+QPixmap ThemePreviewCache::preview(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius)
+{
+    const QString &k = key(path, size, ratio, base, radius);
+    if (QPixmap *pixmap = m_cache.object(k))
+        return *pixmap;
+
+    if (m_pending.contains(k))
+        return QPixmap();
+
+    m_pending.insert(k);
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, k, path] {
+        const QImage &img = watcher->result();
+        watcher->deleteLater();
+        m_pending.remove(k);
+
+        if (img.isNull())
+            return;
+
+        // QPixmap 只能在主线程创建
+        m_cache.insert(k, new QPixmap(QPixmap::fromImage(img)), qMax(1, static_cast<int>(img.sizeInBytes() / 1024)));
+        Q_EMIT previewReady(path);
+    });
+    watcher->setFuture(QtConcurrent::run(&ThemePreviewCache::rasterize, path, size, ratio, base, radius));
+
+    return QPixmap();
+}
+
+QString ThemePreviewCache::key(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius)
+{
+    return QString("%1|%2x%3@%4|%5|%6").arg(path).arg(size.width()).arg(size.height())
+           .arg(ratio).arg(base.rgba()).arg(radius);
+}
+
+QImage ThemePreviewCache::rasterize(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius)
+{
+    RasterizeCount.fetchAndAddRelaxed(1);
+
+    DSvgRenderer render;
+    if (!render.load(path))
+        return QImage();
+
+    const QImage &source = render.toImage(size * ratio);
+    if (source.isNull())
+        return QImage();
+
+    return compose(source, size, ratio, base, radius);
+}
+
+int ThemePreviewCache::rasterizeCount()
+{
+    return RasterizeCount.loadAcquire();
+}
+
+QImage ThemePreviewCache::compose(const QImage &source, const QSize &size, qreal ratio, const QColor &base, int radius)
+{
+    QImage img(QSize(size.width() + 2, size.height() + 2) * ratio, QImage::Format_ARGB32_Premultiplied);
+    img.setDevicePixelRatio(ratio);
+    img.fill(Qt::transparent);
+
+    QPainter painter(&img);
+    painter.setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
+
+    //first draw image
+    QRect picRect(QPoint(1, 1), size);
+    painter.drawImage(picRect, source, source.rect());
+
+    //second draw picture rounded rect bound
+    QPen pen;
+    pen.setColor(base);
+    painter.setPen(pen);
+    painter.drawRoundedRect(picRect, radius, radius);
+
+    //third fill space with base brush
+    QPainterPath picPath;
+    picPath.addRect(picRect);
+    QPainterPath roundPath;
+    roundPath.addRoundedRect(picRect, radius, radius);
+    QPainterPath anglePath = picPath - roundPath;
+    painter.fillPath(anglePath, base);
+    painter.strokePath(picPath, base);
+
+    return img;
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QCache>
+#include <QHash>
+#include <QSet>
+#include <QPixmap>
+#include <QImage>
+#include <QColor>
+
+namespace DCC_NAMESPACE {
+namespace personalization {
+
+/**
+ * @brief The ThemePreviewCache class 主题预览图的共享缓存
+ * 预览图在后台线程中栅格化并绘制好圆角,按图片路径、尺寸、缩放比例和调色板缓存,
+ * 重绘时只需要直接贴图; 图片生成后发出 previewReady 通知控件刷新
+ */
+class ThemePreviewCache : public QObject
+{
+    Q_OBJECT
+public:
+    static ThemePreviewCache *instance();
+
+    // svg 的原始尺寸, 每个文件只解析一次
+    QSize defaultSize(const QString &path);
+    // 返回缓存的预览图, 没有时返回空图片并在后台生成
+    QPixmap preview(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius);
+
+    static QString key(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius);
+    // 栅格化 svg 并绘制圆角, 可以在任意线程调用
+    static QImage rasterize(const QString &path, const QSize &size, qreal ratio, const QColor &base, int radius);
+    // 在 source 四周留出 1 像素的边框, 圆角以外的部分使用 base 填充
+    static QImage compose(const QImage &source, const QSize &size, qreal ratio, const QColor &base, int radius);
+    // rasterize 累计被调用的次数, 用于确认重绘时命中了缓存
+    static int rasterizeCount();
+
+Q_SIGNALS:
+    void previewReady(const QString &path);
+
+private:
+    explicit ThemePreviewCache(QObject *parent = nullptr);
+
+private:
+    QCache<QString, QPixmap> m_cache;
+    QSet<QString> m_pending;
+    QHash<QString, QSize> m_sizes;
+};
+
+}
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "thumbnailloader.h"
+
+#include <QFutureWatcher>
+#include <QtConcurrent>
+#include <QImageReader>
+#include <QCryptographicHash>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+
+using namespace DCC_NAMESPACE;
+using namespace DCC_NAMESPACE::personalization;
+
+ThumbnailLoader::ThumbnailLoader(const QString &cacheDir, QObject *parent)
+    : QObject(parent)
+    , m_cacheDir(cacheDir.isEmpty() ? QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/thumbnails" : cacheDir)
+    , m_serial(0)
+{
+}
+
+void ThumbnailLoader::load(const QString &id, const QString &path, const QSize &maxSize)
+{
+    const quint64 serial = ++m_serial;
+    m_requests.insert(id, serial);
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [this, watcher, id, serial] {
+        const QImage &img = watcher->result();
+        watcher->deleteLater();
+
+        // 期间重新加载或取消过的结果直接丢弃
+        if (m_requests.value(id) != serial)
+            return;
+
+        m_requests.remove(id);
+        if (!img.isNull())
+            Q_EMIT thumbnailReady(id, img);
+    });
+    watcher->setFuture(QtConcurrent::run(&ThumbnailLoader::decode, path, maxSize, m_cacheDir));
+}
+
+void ThumbnailLoader::cancel(const QString &id)
+{
+    m_requests.remove(id);
+}
+
+QImage ThumbnailLoader::decode(const QString &path, const QSize &maxSize, const QString &cacheDir)
+{
+    QImageReader reader(path);
+    const QSize &size = reader.size();
+    if (!size.isValid() || maxSize.isEmpty() || (size.width() <= maxSize.width() && size.height() <= maxSize.height()))
+        return reader.read();
+
+    // 缓存文件名包含源文件的修改时间和大小, 源文件变化后自动失效
+    const QFileInfo info(path);
+    const QByteArray &key = QString("%1|%2|%3|%4x%5").arg(info.absoluteFilePath())
+                            .arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size())
+                            .arg(maxSize.width()).arg(maxSize.height()).toUtf8();
+    const QString &cachePath = QString("%1/%2.png").arg(cacheDir)
+                               .arg(QString(QCryptographicHash::hash(key, QCryptographicHash::Sha1).toHex()));
+
+    QImage img(cachePath);
+    if (!img.isNull())
+        return img;
+
+    reader.setScaledSize(size.scaled(maxSize, Qt::KeepAspectRatio));
+    img = reader.read();
+    if (!img.isNull() && QDir().mkpath(cacheDir)) {
+        // 多个线程可能同时写同一个缓存文件, 写完后再替换
+        QSaveFile file(cachePath);
+        if (file.open(QIODevice::WriteOnly) && img.save(&file, "PNG"))
+            file.commit();
+    }
+
+    return img;
+}
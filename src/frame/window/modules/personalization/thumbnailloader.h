@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     LiLinling <lilinling_cm@deepin.com>
+ *
+ * Maintainer: LiLinling <lilinling_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QHash>
+#include <QImage>
+#include <QSize>
+
+namespace DCC_NAMESPACE {
+namespace personalization {
+
+/**
+ * @brief The ThumbnailLoader class 主题缩略图的异步加载
+ * 图片在后台线程中解码, 超过 maxSize 时缩小并保存到磁盘缓存, 下次直接读取缩小后的图片;
+ * 同一个 id 重复加载时只保留最后一次的结果
+ */
+class ThumbnailLoader : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ThumbnailLoader(const QString &cacheDir = QString(), QObject *parent = nullptr);
+
+    // maxSize 为设备像素, 为空时不缩放
+    void load(const QString &id, const QString &path, const QSize &maxSize = QSize());
+    void cancel(const QString &id);
+
+    QString cacheDir() const { return m_cacheDir; }
+
+    static QImage decode(const QString &path, const QSize &maxSize, const QString &cacheDir);
+
+Q_SIGNALS:
+    void thumbnailReady(const QString &id, const QImage &image);
+
+private:
+    QString m_cacheDir;
+    // id -> 最后一次加载的序号, 用于丢弃过期的结果
+    QHash<QString, quint64> m_requests;
+    quint64 m_serial;
+};
+
+}
+}
@@ -28,6 +28,11 @@ namespace wacom {
 const QString Service("com.deepin.daemon.InputDevices");
 const QString ServicePath("/com/deepin/daemon/InputDevice/Wacom");
 
+QStringList WacomWorker::sessionServices()
+{
+    return { Service };
+}
+
 WacomWorker::WacomWorker(WacomModel *model, QObject *parent)
     : QObject(parent)
     , m_dbusWacom(new Wacom(Service, ServicePath, QDBusConnection::sessionBus(), this))
@@ -42,6 +42,9 @@ class WacomWorker : public QObject
     Q_OBJECT
 public:
     explicit WacomWorker(WacomModel *model, QObject *parent = nullptr);
+
+    // 数位板由 InputDevices 服务提供
+    static QStringList sessionServices();
     void active();
     void deactive();
 
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2019 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     wubw <wubowen_cm@deepin.com>
+ *
+ * Maintainer: wubw <wubowen_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "searchengine.h"
+
+#include <DPinyin>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace DCC_NAMESPACE::search;
+
+namespace {
+const int MaxGramSize = 3;
+// 精确匹配的结果少于该数量时才进行模糊匹配,避免短输入时出现大量无关结果
+const int FuzzyThreshold = 10;
+
+QString removeDigital(const QString &input)
+{
+    QString value;
+    value.reserve(input.size());
+    for (const QChar &ch : input) {
+        if (!ch.isDigit())
+            value.append(ch);
+    }
+    return value;
+}
+
+// 判断 input 的字符是否按顺序出现在 text 中, first 为第一个匹配字符的位置, span 为匹配跨度
+bool isSubsequence(const QString &text, const QString &input, int &first, int &span)
+{
+    int pos = -1;
+    first = -1;
+    for (const QChar &ch : input) {
+        pos = text.indexOf(ch, pos + 1);
+        if (pos < 0)
+            return false;
+        if (first < 0)
+            first = pos;
+    }
+    span = pos - first + 1;
+    return true;
+}
+
+QVector<int> intersect(const QVector<int> &a, const QVector<int> &b)
+{
+    QVector<int> result;
+    std::set_intersection(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(result));
+    return result;
+}
+
+QVector<int> intersectAll(QList<const QVector<int> *> lists)
+{
+    if (lists.isEmpty())
+        return QVector<int>();
+
+    // 从最短的列表开始求交集
+    std::sort(lists.begin(), lists.end(), [](const QVector<int> *a, const QVector<int> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<int> result = *lists.first();
+    for (int i = 1; i < lists.size() && !result.isEmpty(); ++i) {
+        result = intersect(result, *lists.at(i));
+    }
+    return result;
+}
+}
+
+SearchEngine::Keys SearchEngine::buildKeys(const QString &title, const QString &text)
+{
+    Keys keys;
+    keys.title = title;
+    keys.text = text;
+
+    bool hasHan = false;
+    bool wordStart = true;
+    for (const QChar &ch : text) {
+        if (ch.script() == QChar::Script_Han) {
+            const QString &py = removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(QString(ch))).toLower();
+            keys.pinyin.append(py);
+            if (!py.isEmpty())
+                keys.initials.append(py.at(0));
+            hasHan = true;
+            wordStart = true;
+            continue;
+        }
+
+        const QChar &lower = ch.toLower();
+        keys.pinyin.append(lower);
+        if (lower.isLetterOrNumber()) {
+            if (wordStart)
+                keys.initials.append(lower);
+            wordStart = false;
+        } else {
+            wordStart = true;
+        }
+    }
+
+    // 没有汉字时全拼与文言相同,不需要重复索引
+    if (!hasHan)
+        keys.pinyin.clear();
+
+    return keys;
+}
+
+void SearchEngine::clear()
+{
+    m_entries.clear();
+    m_grams.clear();
+}
+
+int SearchEngine::addEntry(const Keys &keys)
+{
+    const int id = m_entries.size();
+
+    Entry entry;
+    entry.title = keys.title.toLower();
+    entry.text = keys.text.toLower();
+    entry.pinyin = keys.pinyin.toLower();
+    entry.initials = keys.initials.toLower();
+    m_entries.append(entry);
+
+    addGrams(id, entry.text);
+    addGrams(id, entry.pinyin);
+    addGrams(id, entry.initials);
+
+    return id;
+}
+
+void SearchEngine::addGrams(int id, const QString &key)
+{
+    for (int n = 1; n <= MaxGramSize; ++n) {
+        for (int i = 0; i + n <= key.size(); ++i) {
+            QVector<int> &ids = m_grams[key.mid(i, n)];
+            // id 按顺序递增,只需判断最后一个即可保证列表有序且不重复
+            if (ids.isEmpty() || ids.last() != id)
+                ids.append(id);
+        }
+    }
+}
+
+QVector<int> SearchEngine::candidates(const QString &input) const
+{
+    if (input.size() <= MaxGramSize)
+        return m_grams.value(input);
+
+    QList<const QVector<int> *> lists;
+    for (int i = 0; i + MaxGramSize <= input.size(); ++i) {
+        auto it = m_grams.constFind(input.mid(i, MaxGramSize));
+        if (it == m_grams.cend())
+            return QVector<int>();
+        lists << &it.value();
+    }
+
+    return intersectAll(lists);
+}
+
+SearchEngine::Rank SearchEngine::rank(int id, const QString &input, bool fuzzy) const
+{
+    const Entry &entry = m_entries.at(id);
+    Rank r { id, NoMatch, 0, entry.text.size() };
+
+    int pos = -1;
+    if (entry.title == input) {
+        r.type = ExactMatch;
+    } else if (entry.title.startsWith(input)) {
+        r.type = PrefixMatch;
+    } else if ((pos = entry.text.indexOf(input)) >= 0) {
+        r.type = (pos == 0 || !entry.text.at(pos - 1).isLetterOrNumber()) ? WordPrefixMatch : ContainsMatch;
+        r.position = pos;
+    } else if ((pos = entry.pinyin.indexOf(input)) >= 0) {
+        r.type = PinyinMatch;
+        r.position = pos;
+    } else if ((pos = entry.initials.indexOf(input)) >= 0) {
+        r.type = InitialsMatch;
+        r.position = pos;
+    } else if (fuzzy) {
+        int span = 0;
+        if (isSubsequence(entry.text, input, pos, span)
+                || (!entry.pinyin.isEmpty() && isSubsequence(entry.pinyin, input, pos, span))) {
+            r.type = FuzzyMatch;
+            // 跨度越小越接近连续匹配
+            r.position = span;
+        }
+    }
+
+    return r;
+}
+
+QVector<int> SearchEngine::search(const QString &input) const
+{
+    const QString &key = input.trimmed().toLower();
+    if (key.isEmpty())
+        return QVector<int>();
+
+    QVector<Rank> ranks;
+    const QVector<int> &ids = candidates(key);
+    for (int id : ids) {
+        const Rank &r = rank(id, key, false);
+        if (r.type != NoMatch)
+            ranks << r;
+    }
+
+    if (key.size() > 1 && ranks.size() < FuzzyThreshold) {
+        // 模糊匹配的候选数据需要包含输入的每个字符
+        QList<const QVector<int> *> lists;
+        for (const QChar &ch : key) {
+            auto it = m_grams.constFind(QString(ch));
+            if (it == m_grams.cend()) {
+                lists.clear();
+                break;
+            }
+            lists << &it.value();
+        }
+
+        QVector<int> matched;
+        for (const Rank &r : ranks)
+            matched << r.id;
+        std::sort(matched.begin(), matched.end());
+
+        for (int id : intersectAll(lists)) {
+            if (std::binary_search(matched.cbegin(), matched.cend(), id))
+                continue;
+            const Rank &r = rank(id, key, true);
+            if (r.type != NoMatch)
+                ranks << r;
+        }
+    }
+
+    std::sort(ranks.begin(), ranks.end(), [](const Rank &a, const Rank &b) {
+        if (a.type != b.type)
+            return a.type < b.type;
+        if (a.position != b.position)
+            return a.position < b.position;
+        if (a.length != b.length)
+            return a.length < b.length;
+        return a.id < b.id;
+    });
+
+    QVector<int> result;
+    result.reserve(ranks.size());
+    for (const Rank &r : ranks)
+        result << r.id;
+
+    return result;
+}
+
+SearchEngine::MatchType SearchEngine::match(int id, const QString &input) const
+{
+    if (id < 0 || id >= m_entries.size())
+        return NoMatch;
+
+    return static_cast<MatchType>(rank(id, input.trimmed().toLower(), true).type);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2019 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     wubw <wubowen_cm@deepin.com>
+ *
+ * Maintainer: wubw <wubowen_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+/**
+ * @brief The SearchEngine class 设置项搜索引擎
+ * 每条数据在加入时预先计算好小写文本,全拼和拼音首字母,并按 1~3 个字符的 n-gram 建立倒排索引;
+ * 搜索时先由 n-gram 求出候选数据,再按匹配程度(完全匹配 > 前缀 > 单词前缀 > 包含 > 拼音 > 首字母 > 模糊)排序
+ */
+class SearchEngine
+{
+public:
+    struct Keys {
+        QString title;      // 设置项名称,用于判断完全匹配/前缀匹配
+        QString text;       // 下拉框显示的完整文言,如 "显示 --> 亮度"
+        QString pinyin;     // text 的全拼
+        QString initials;   // text 的拼音首字母
+    };
+
+    enum MatchType {
+        ExactMatch = 0,
+        PrefixMatch,
+        WordPrefixMatch,
+        ContainsMatch,
+        PinyinMatch,
+        InitialsMatch,
+        FuzzyMatch,
+        NoMatch
+    };
+
+    // 根据文言计算搜索用的 Keys, 汉字会转换为全拼和首字母
+    static Keys buildKeys(const QString &title, const QString &text);
+
+    void clear();
+    int count() const { return m_entries.size(); }
+
+    // 返回数据的 id, 按加入顺序从 0 递增
+    int addEntry(const Keys &keys);
+
+    // 返回按匹配程度排序后的数据 id
+    QVector<int> search(const QString &input) const;
+
+    MatchType match(int id, const QString &input) const;
+
+private:
+    struct Entry {
+        QString title;
+        QString text;
+        QString pinyin;
+        QString initials;
+    };
+
+    struct Rank {
+        int id;
+        int type;
+        int position;
+        int length;
+    };
+
+    void addGrams(int id, const QString &key);
+    QVector<int> candidates(const QString &input) const;
+    Rank rank(int id, const QString &input, bool fuzzy) const;
+
+private:
+    QVector<Entry> m_entries;
+    QHash<QString, QVector<int>> m_grams;  // n-gram -> 有序的数据 id
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2019 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     wubw <wubowen_cm@deepin.com>
+ *
+ * Maintainer: wubw <wubowen_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "searchindex.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QVector>
+#include <QXmlStreamReader>
+
+#include <cstring>
+
+using namespace DCC_NAMESPACE::search;
+
+namespace {
+const char IndexMagic[8] = {'D', 'C', 'C', 'S', 'I', 'D', 'X', '\0'};
+const quint32 IndexByteOrder = 0x01020304;
+const quint32 IndexVersion = 1;
+const int EntryFields = 3;
+
+// 文件头之后依次是 count 条记录(每个字段为 quint32 偏移 + quint32 长度, 单位为 QChar),
+// 以及所有字符串按 UTF-16 连续存放的字符串池
+struct IndexHeader {
+    char magic[8];
+    quint32 byteOrder;
+    quint32 version;
+    qint64 sourceSize;
+    qint64 sourceMtime;
+    quint32 count;
+    quint32 reserved;
+};
+
+struct IndexField {
+    quint32 offset;
+    quint32 length;
+};
+
+qint64 sourceMtime(const QFileInfo &info)
+{
+    // 编译进资源的 .ts 可能没有记录修改时间,此时只比较文件大小
+    const QDateTime &time = info.lastModified();
+    return time.isValid() ? time.toMSecsSinceEpoch() : 0;
+}
+}
+
+bool SearchIndex::parseTs(const QString &tsPath, QList<SearchIndexEntry> &entries)
+{
+    QFile file(tsPath);
+
+    if (!file.exists()) {
+        qDebug() << " [SearchWidget] File not exist";
+        return false;
+    }
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << " [SearchWidget] File open failed";
+        return false;
+    }
+
+    QXmlStreamReader xmlRead(&file);
+    SearchIndexEntry entry;
+    QString xmlExplain;
+
+    //遍历XML文件,在 <> 时进入 StartElement, 在中间内容时进入 Characters, 在 </> 时进入 EndElement
+    //读到 extra-contents_path 时即得到一条完整的搜索数据
+    while (!xmlRead.atEnd()) {
+        switch (xmlRead.readNext()) {
+        case QXmlStreamReader::StartElement:
+            xmlExplain = xmlRead.name().toString();
+            break;
+        case QXmlStreamReader::Characters:
+            if (xmlRead.isWhitespace()) {
+                break;
+            }
+
+            if (xmlExplain == XML_Source) {
+                entry.translateContent = xmlRead.text().toString();
+            } else if (xmlExplain == XML_Title || xmlExplain == XML_Numerusform) {
+                if (!xmlRead.text().isEmpty())  // translation not nullptr can set it
+                    entry.translateContent = xmlRead.text().toString();
+            } else if (xmlExplain == XML_Child_Path) {
+                entry.childPage = xmlRead.text().toString();
+            } else if (xmlExplain == XML_Explain_Path) {
+                entry.fullPagePath = xmlRead.text().toString();
+                entries << entry;
+                entry = SearchIndexEntry();
+            }
+            break;
+        default: break;
+        }
+    }
+
+    file.close();
+
+    return !xmlRead.hasError();
+}
+
+bool SearchIndex::write(const QString &tsPath, const QString &indexPath)
+{
+    QList<SearchIndexEntry> entries;
+    if (!parseTs(tsPath, entries)) {
+        return false;
+    }
+
+    QFileInfo info(tsPath);
+    IndexHeader header;
+    memcpy(header.magic, IndexMagic, sizeof(IndexMagic));
+    header.byteOrder = IndexByteOrder;
+    header.version = IndexVersion;
+    header.sourceSize = info.size();
+    header.sourceMtime = sourceMtime(info);
+    header.count = static_cast<quint32>(entries.size());
+    header.reserved = 0;
+
+    QVector<IndexField> fields;
+    fields.reserve(entries.size() * EntryFields);
+    QString pool;
+    auto appendString = [&](const QString &str) {
+        fields.append({static_cast<quint32>(pool.size()), static_cast<quint32>(str.size())});
+        pool.append(str);
+    };
+
+    for (const SearchIndexEntry &entry : entries) {
+        appendString(entry.translateContent);
+        appendString(entry.childPage);
+        appendString(entry.fullPagePath);
+    }
+
+    QDir().mkpath(QFileInfo(indexPath).absolutePath());
+    QSaveFile file(indexPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "[SearchIndex] can not write" << indexPath;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(fields.constData()), fields.size() * static_cast<int>(sizeof(IndexField)));
+    file.write(reinterpret_cast<const char *>(pool.constData()), pool.size() * static_cast<int>(sizeof(QChar)));
+
+    return file.commit();
+}
+
+bool SearchIndex::load(const QString &tsPath, QList<SearchIndexEntry> &entries, const QString &indexDir)
+{
+    QFile file(indexPath(tsPath, indexDir));
+    if (!file.exists() || !file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    const qint64 size = file.size();
+    if (size < static_cast<qint64>(sizeof(IndexHeader))) {
+        return false;
+    }
+
+    uchar *data = file.map(0, size);
+    if (!data) {
+        return false;
+    }
+
+    bool ok = false;
+    do {
+        IndexHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        if (memcmp(header.magic, IndexMagic, sizeof(IndexMagic)) != 0
+                || header.byteOrder != IndexByteOrder
+                || header.version != IndexVersion) {
+            break;
+        }
+
+        // 源文件被修改过(例如更新了翻译)时索引已过期
+        const QFileInfo info(tsPath);
+        const qint64 mtime = sourceMtime(info);
+        if (header.sourceSize != info.size()
+                || (mtime && header.sourceMtime && header.sourceMtime != mtime)) {
+            qDebug() << "[SearchIndex] index is stale:" << file.fileName();
+            break;
+        }
+
+        const qint64 fieldsSize = static_cast<qint64>(header.count) * EntryFields * static_cast<qint64>(sizeof(IndexField));
+        if (static_cast<qint64>(sizeof(IndexHeader)) + fieldsSize > size) {
+            break;
+        }
+
+        const IndexField *fields = reinterpret_cast<const IndexField *>(data + sizeof(IndexHeader));
+        const QChar *pool = reinterpret_cast<const QChar *>(data + sizeof(IndexHeader) + fieldsSize);
+        const qint64 poolSize = (size - static_cast<qint64>(sizeof(IndexHeader)) - fieldsSize) / static_cast<qint64>(sizeof(QChar));
+
+        auto readString = [&](const IndexField &field, QString &out) {
+            if (static_cast<qint64>(field.offset) + field.length > poolSize) {
+                return false;
+            }
+            out = QString(pool + field.offset, static_cast<int>(field.length));
+            return true;
+        };
+
+        QList<SearchIndexEntry> list;
+        list.reserve(static_cast<int>(header.count));
+        bool valid = true;
+        for (quint32 i = 0; i < header.count && valid; ++i) {
+            const IndexField *field = fields + i * EntryFields;
+            SearchIndexEntry entry;
+            valid = readString(field[0], entry.translateContent)
+                    && readString(field[1], entry.childPage)
+                    && readString(field[2], entry.fullPagePath);
+            list << entry;
+        }
+
+        if (valid) {
+            entries << list;
+            ok = true;
+        }
+    } while (false);
+
+    file.unmap(data);
+
+    return ok;
+}
+
+QString SearchIndex::indexPath(const QString &tsPath, const QString &indexDir)
+{
+    return QDir(indexDir).filePath(QFileInfo(tsPath).completeBaseName() + QStringLiteral(".idx"));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2019 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     wubw <wubowen_cm@deepin.com>
+ *
+ * Maintainer: wubw <wubowen_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QString>
+#include <QList>
+
+#ifndef DCC_SEARCH_INDEX_DIR
+#define DCC_SEARCH_INDEX_DIR "/usr/share/dde-control-center/search-index"
+#endif
+
+const QString XML_Source = "source";
+const QString XML_Title = "translation";
+const QString XML_Numerusform = "numerusform";
+const QString XML_Explain_Path = "extra-contents_path";
+const QString XML_Child_Path = "extra-child_page";
+
+namespace DCC_NAMESPACE {
+namespace search {
+
+// ts文件中一条带 extra-contents_path 的搜索数据(未经过模块名/服务器等过滤)
+struct SearchIndexEntry {
+    QString translateContent;   // translation 不为空时为译文,否则为 source
+    QString childPage;          // extra-child_page 原文,由 SearchModel 负责翻译
+    QString fullPagePath;       // extra-contents_path
+};
+
+/**
+ * @brief The SearchIndex class 搜索数据的二进制索引
+ * 构建时由 dcc-search-indexer 将每个语言的 .ts 文件预编译为索引文件,
+ * 运行时通过 mmap 直接读取,避免每次启动都用 QXmlStreamReader 解析 .ts;
+ * 索引中记录了源文件的大小和修改时间,与源文件不一致时视为过期
+ */
+class SearchIndex
+{
+public:
+    // 解析 .ts 文件,返回全部带 extra-contents_path 的数据
+    static bool parseTs(const QString &tsPath, QList<SearchIndexEntry> &entries);
+
+    // 将 tsPath 对应的数据写入 indexPath
+    static bool write(const QString &tsPath, const QString &indexPath);
+
+    // mmap 读取 tsPath 对应的索引,索引不存在或已过期时返回 false
+    static bool load(const QString &tsPath, QList<SearchIndexEntry> &entries,
+                     const QString &indexDir = QStringLiteral(DCC_SEARCH_INDEX_DIR));
+
+    // 根据 .ts 文件路径得到索引文件路径,如 dde-control-center_zh_CN.ts -> dde-control-center_zh_CN.idx
+    static QString indexPath(const QString &tsPath, const QString &indexDir = QStringLiteral(DCC_SEARCH_INDEX_DIR));
+};
+
+}// namespace search
+}// namespace DCC_NAMESPACE
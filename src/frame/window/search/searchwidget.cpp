@@ -22,14 +22,11 @@
 #include "window/utils.h"
 #include "interface/moduleinterface.h"
 
-#include <DPinyin>
 #include <QDebug>
 #include <QLineEdit>
 #include <QListWidget>
 #include <QPushButton>
-#include <QXmlStreamReader>
 #include <QCompleter>
-#include <QRegularExpression>
 #include <QPainter>
 #include <QRect>
 #include <QApplication>
@@ -71,7 +68,7 @@ void DCompleterStyledItemDelegate::paint(QPainter *painter, const QStyleOptionVi
     if (option.showDecorationSelected && (option.state & (QStyle::State_Selected | QStyle::State_MouseOver))) {
         painter->fillRect(option.rect, option.palette.brush(cg, QPalette::Highlight));
     }
-    QIcon itemIcon = QIcon::fromTheme(index.data(Qt::UserRole + 1).toString());
+    QIcon itemIcon = QIcon::fromTheme(index.data(SearchModel::IconNameRole).toString());
     QSize iconSize = QSize(option.rect.height() - 2, option.rect.height() - 2);
     painter->drawPixmap(QRect(0, option.rect.y(), option.rect.height() - 0, option.rect.height() - 2), itemIcon.pixmap(iconSize));
 
@@ -93,6 +90,35 @@ QSize DCompleterStyledItemDelegate::sizeHint(const QStyleOptionViewItem &option,
     return s;
 }
 
+SearchFilterModel::SearchFilterModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+{
+    setDynamicSortFilter(true);
+    setFilterRole(SearchModel::VisibleRole);
+}
+
+void SearchFilterModel::setSearchResult(const QVector<int> &rows)
+{
+    m_rank.clear();
+    m_rank.reserve(rows.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        m_rank.insert(rows.at(i), i);
+    }
+
+    invalidate();
+}
+
+bool SearchFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+    return m_rank.contains(sourceRow)
+           && sourceModel()->index(sourceRow, 0, sourceParent).data(SearchModel::VisibleRole).toBool();
+}
+
+bool SearchFilterModel::lessThan(const QModelIndex &left, const QModelIndex &right) const
+{
+    return m_rank.value(left.row()) < m_rank.value(right.row());
+}
+
 SearchModel::SearchModel(QObject *parent)
     : QStandardItemModel(parent)
     , m_bIsChinese(false)
@@ -172,13 +198,16 @@ SearchWidget::SearchWidget(QWidget *parent)
     : DTK_WIDGET_NAMESPACE::DSearchEdit(parent)
 {
     m_model = new SearchModel(this);
-    m_completer = new ddeCompleter(m_model, this);
+    m_filterModel = new SearchFilterModel(this);
+    m_filterModel->setSourceModel(m_model);
+    m_filterModel->sort(0);
+    m_completer = new ddeCompleter(m_filterModel, this);
     m_completer->popup()->setItemDelegate(&styledItemDelegate);
     m_completer->popup()->setAttribute(Qt::WA_InputMethodEnabled);
 
-    m_completer->setFilterMode(Qt::MatchContains);//设置QCompleter支持匹配字符搜索
-    m_completer->setCaseSensitivity(Qt::CaseInsensitive);//这个属性可设置进行匹配时的大小写敏感性
-    m_completer->setCompletionRole(Qt::UserRole); //设置ItemDataRole
+    //匹配和排序由 SearchEngine 完成,QCompleter 只负责显示 m_filterModel 中的结果
+    m_completer->setCompletionMode(QCompleter::UnfilteredPopupCompletion);
+    m_completer->setCompletionRole(Qt::DisplayRole); //设置ItemDataRole
     m_completer->setWrapAround(false);
     m_completer->installEventFilter(this);
     m_completer->setWidget(lineEdit());  //设置自动补全时弹出时相应位置的widget
@@ -206,11 +235,8 @@ SearchWidget::SearchWidget(QWidget *parent)
                 const QString &currentCompletion = m_completer->popup()->currentIndex().data().toString();
                 qDebug() << Q_FUNC_INFO << " [SearchWidget] currentCompletion : " << currentCompletion;
 
-                //中文遍历一遍,若没有匹配再遍历将拼音转化为中文再遍历
-                //解决输入拼音时,有配置数据后,直接回车无法进入第一个匹配数据页面的问题
-                if (!jumpContentPathWidget(currentCompletion)) {
-                    jumpContentPathWidget(m_model->transPinyinToChinese(currentCompletion));
-                }
+                //下拉框中显示的都是汉字,输入拼音时也可以直接跳转
+                jumpContentPathWidget(currentCompletion);
 
                 //根据匹配的信息补全DSearchEdit的内容，block信号避免重新触发自动补全
                 this->blockSignals(true);
@@ -238,6 +264,10 @@ bool SearchModel::jumpContentPathWidget(const QString &path)
         SearchBoxStruct::Ptr data = getModuleBtnString(path);
         if (data->translateContent != "" && data->fullPagePath != "") {
             for (int i = 0; i < m_EnterNewPagelist.count(); i++) {
+                if (m_EnterNewPagelist[i]->filterFlags & ~SearchBoxStruct::DuplicateText) {
+                    continue;
+                }
+
                 if (m_EnterNewPagelist[i]->translateContent == data->fullPagePath) {//getModuleBtnString解析SearchBoxStruct.fullPagePath，满足此处判断
 #if DEBUG_XML_SWITCH
                     qDebug() << " [SearchWidget] m_EnterNewPagelist[i].translateContent : " << m_EnterNewPagelist[i].translateContent << " , fullPagePath : " << m_EnterNewPagelist[i].fullPagePath << " , actualModuleName: " << m_EnterNewPagelist[i].actualModuleName;
@@ -263,47 +293,20 @@ void SearchModel::loadxml()
 {
     clear(); // It doesn't seem to leak memory
     m_EnterNewPagelist.clear();
-    m_inputList.clear();
-    m_TxtListAll.clear();
+    m_engine.clear();
+    m_textEntries.clear();
+    m_moduleEntries.clear();
+    m_removeableEntries.clear();
 
     //添加一项空数据，为了防止使用setText输入错误数据时直接跳转到list中正确的第一个页面
     m_EnterNewPagelist.append(std::make_shared<SearchBoxStruct>());
-    m_inputList.append(SearchDataStruct());
-    appendRow(new QStandardItem(""));
+    QStandardItem *emptyItem = new QStandardItem("");
+    emptyItem->setData(true, VisibleRole);
+    appendRow(emptyItem);
+    m_engine.addEntry(SearchEngine::Keys());
 
+    //全部数据只在此处加载一次,之后模块/设备是否存在只修改对应数据的 filterFlags,不再重新加载
     for (SearchBoxStruct::Ptr searchBoxStrcut : m_originList) {
-        //"蓝牙","数位板"不存在则不加载该模块search数据
-        //目前只用到了模块名，未使用detail信息，之后再添加模块内区分
-        bool bIsLeapfrog = false;
-        auto res = std::any_of(m_unexsitList.begin(), m_unexsitList.end(), [=](const UnexsitStruct &date) {
-            return searchBoxStrcut->actualModuleName == date.module;
-        });
-
-        if (res) {
-            bIsLeapfrog = true;
-            continue;
-        }
-
-        if (bIsLeapfrog) continue;
-
-        //“鼠标”可移除设备 : 指点杆，触控板
-        //“网络”模块可移除设备 : 个人热点，有线网，无线网
-        //“电源”模块可移除设备 : 使用电池
-        //不存在时，不加载数据
-        //是以上模块才会有此判断，其他模块不用此判断(包含在m_defaultRemoveableList的页面才需要“添加/移除”xml信息)
-        if (m_defaultRemoveableList.contains(searchBoxStrcut->fullPagePath.section('/', 2, -1))) {
-            auto result = std::find_if(m_removeableActualExistList.begin(),
-                                       m_removeableActualExistList.end(),
-                                       [=](const QPair<QString, QString> &date) {
-                return date.second == searchBoxStrcut->fullPagePath.section('/', 2, -1);
-            });
-
-            //设备不存在，不加载xml数据
-            if (result == m_removeableActualExistList.end()) {
-                continue;
-            }
-        }
-
         if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
             continue;
         }
@@ -331,35 +334,111 @@ void SearchModel::loadxml()
             }
         }
 
+        searchBoxStrcut->filterFlags = 0;
+        searchBoxStrcut->items.clear();
         m_EnterNewPagelist.append(searchBoxStrcut);
+        m_textEntries[searchBoxStrcut->translateContent].append(searchBoxStrcut);
 
-        if (m_TxtListAll.contains(searchBoxStrcut->translateContent)) {
-            continue;
+        //"蓝牙","数位板"不存在则不显示该模块search数据
+        //目前只用到了模块名，未使用detail信息，之后再添加模块内区分
+        m_moduleEntries.insert(searchBoxStrcut->actualModuleName, searchBoxStrcut);
+        auto res = std::any_of(m_unexsitList.begin(), m_unexsitList.end(), [=](const UnexsitStruct &date) {
+            return searchBoxStrcut->actualModuleName == date.module;
+        });
+        if (res) {
+            searchBoxStrcut->filterFlags |= SearchBoxStruct::UnexsitModule;
         }
 
-        m_TxtListAll.append(searchBoxStrcut->translateContent);
+        //“鼠标”可移除设备 : 指点杆，触控板
+        //“网络”模块可移除设备 : 个人热点，有线网，无线网
+        //“电源”模块可移除设备 : 使用电池
+        //不存在时，不显示数据
+        //是以上模块才会有此判断，其他模块不用此判断(包含在m_defaultRemoveableList的页面才需要“显示/隐藏”xml信息)
+        const QString &page = searchBoxStrcut->fullPagePath.section('/', 2, -1);
+        if (m_defaultRemoveableList.contains(page)) {
+            m_removeableEntries.insert(page, searchBoxStrcut);
+            auto result = std::find_if(m_removeableActualExistList.begin(),
+                                       m_removeableActualExistList.end(),
+                                       [=](const QPair<QString, QString> &date) {
+                return date.second == page;
+            });
 
-        // Add search result content
-        if (!m_bIsChinese) {
-            auto icon = m_iconMap.find(searchBoxStrcut->fullPagePath.section('/', 1, 1));
-            if (icon == m_iconMap.end()) {
-                continue;
+            if (result == m_removeableActualExistList.end()) {
+                searchBoxStrcut->filterFlags |= SearchBoxStruct::RemoveableDevice;
             }
+        }
+    }
 
-            if ("" == searchBoxStrcut->childPageName) {
-                appendRow(new QStandardItem(icon.value(), QString("%1 --> %2").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->translateContent)));
-            }
-            else {
-                appendRow(new QStandardItem(
-                    icon.value(), QString("%1 --> %2 / %3").arg(searchBoxStrcut->actualModuleName).arg(searchBoxStrcut->childPageName).arg(searchBoxStrcut->translateContent)));
-            }
+    //相同文言只显示第一个可见的数据
+    for (auto it = m_textEntries.cbegin(); it != m_textEntries.cend(); ++it) {
+        updateDuplicateText(it.key());
+    }
+
+    for (int i = 1; i < m_EnterNewPagelist.count(); i++) {
+        SearchBoxStruct::Ptr searchBoxStrcut = m_EnterNewPagelist[i];
+
+        appendSearchData(searchBoxStrcut);
+    }
+}
+
+QVector<int> SearchModel::search(const QString &text) const
+{
+    return m_engine.search(text);
+}
+
+void SearchModel::setFilterFlag(SearchBoxStruct::Ptr data, SearchBoxStruct::FilterFlag flag, bool on)
+{
+    const int flags = on ? (data->filterFlags | flag) : (data->filterFlags & ~flag);
+    if (flags == data->filterFlags) {
+        return;
+    }
+
+    data->filterFlags = flags;
+    //只修改该数据对应行的 VisibleRole,由 SearchFilterModel 插入/移除这几行
+    const bool visible = flags == 0;
+    for (QStandardItem *item : data->items) {
+        if (item->data(VisibleRole).toBool() != visible) {
+            item->setData(visible, VisibleRole);
         }
-        else {
-            appendChineseData(searchBoxStrcut);
+    }
+}
+
+void SearchModel::updateDuplicateText(const QString &text)
+{
+    bool found = false;
+    for (SearchBoxStruct::Ptr data : m_textEntries.value(text)) {
+        setFilterFlag(data, SearchBoxStruct::DuplicateText, found);
+        if (!(data->filterFlags & ~SearchBoxStruct::DuplicateText)) {
+            found = true;
         }
     }
 }
 
+void SearchModel::updateModuleFilter(const QString &module)
+{
+    const bool hidden = std::any_of(m_unexsitList.begin(), m_unexsitList.end(), [=](const UnexsitStruct &date) {
+        return date.module == module;
+    });
+
+    for (SearchBoxStruct::Ptr data : m_moduleEntries.values(module)) {
+        setFilterFlag(data, SearchBoxStruct::UnexsitModule, hidden);
+        updateDuplicateText(data->translateContent);
+    }
+}
+
+void SearchModel::updateRemoveableFilter(const QString &page)
+{
+    const bool hidden = std::none_of(m_removeableActualExistList.begin(), m_removeableActualExistList.end(),
+                                     [=](const QPair<QString, QString> &date) {
+        return date.second == page;
+    });
+
+    for (SearchBoxStruct::Ptr data : m_removeableEntries.values(page)) {
+        setFilterFlag(data, SearchBoxStruct::RemoveableDevice, hidden);
+        updateDuplicateText(data->translateContent);
+    }
+}
+
 //Follow display content to Analysis SearchBoxStruct data
 SearchBoxStruct::Ptr SearchModel::getModuleBtnString(QString value)
 {
@@ -403,142 +482,32 @@ QString SearchModel::getModulesName(const QString &name, bool state)
     return strResult;
 }
 
-QString SearchModel::removeDigital(QString input)
-{
-    if ("" == input)
-        return "";
-
-    QString value = "";
-    QByteArray ba = input.toLocal8Bit();
-    char *data = nullptr;
-    data = ba.data();
-    while (*data) {
-        if (!(*data >= '0' && *data <= '9')) {
-            value += *data;
-        }
-        data++;
-    }
-
-    return value;
-}
-
-QString SearchModel::transPinyinToChinese(const QString &pinyin)
-{
-    QString value = pinyin;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    auto res = std::find_if(m_inputList.begin(), m_inputList.end(), [=] (const SearchDataStruct data)->bool{
-            return value == data.pinyin;
-        });
-
-        if (res != m_inputList.end()) {
-            value =(*res).chiese;
-        }
-
-    return value;
-}
-
-QString SearchModel::containTxtData(QString txt)
-{
-    QString value = txt;
-
-    //遍历"汉字-拼音"列表,将存在的"拼音"转换为"汉字"
-    auto res = std::find_if(m_inputList.begin(), m_inputList.end(), [=] (const SearchDataStruct data)->bool{
-                return (data.chiese.contains(txt, Qt::CaseInsensitive) ||
-                        data.pinyin.contains(txt, Qt::CaseInsensitive));
-            });
-
-            if (res != m_inputList.end()) {
-                value = (*res).chiese;
-            }
-
-    return value;
-}
-
-void SearchModel::appendChineseData(SearchBoxStruct::Ptr data)
+void SearchModel::appendSearchData(SearchBoxStruct::Ptr data)
 {
     auto icon = m_iconMap.find(data->fullPagePath.section('/', 1, 1));
     if (icon == m_iconMap.end()) {
         return;
     }
 
-    // 其他函数存在修改智能指针的数值，复制一份解决。
-    SearchBoxStruct::Ptr dataBackup(new SearchBoxStruct(*data));
-
-    if ("" == dataBackup->childPageName) {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        appendRow(new QStandardItem(icon.value(),
-                                    QString("%1 --> %2").arg(dataBackup->actualModuleName).arg(dataBackup->translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        setData(index(rowCount() - 1, 0),
-                         QString("%1 --> %2")
-                         .arg(dataBackup->actualModuleName)
-                         .arg(dataBackup->translateContent),
-                         Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-
-        QString hanziTxt = QString("%1 --> %2").arg(dataBackup->actualModuleName).arg(dataBackup->translateContent);
-
-        QString pinyinTxt = QString("%1 --> %2")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
-
-        // 如果模块名称中英文相同则不继续添加拼音搜索显示,否则会重复索引
-        if (dataBackup->actualModuleName == DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName)) return;
-
-        //添加显示的汉字(用于拼音搜索显示)
-        appendRow(new QStandardItem(icon.value(), hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        setData(index(rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
+    QString text;
+    if ("" == data->childPageName) {
+        text = QString("%1 --> %2").arg(data->actualModuleName).arg(data->translateContent);
     } else {
-        //先添加使用appenRow添加Qt::EditRole数据(用于下拉框显示),然后添加Qt::UserRole数据(用于输入框搜索)
-        //Qt::EditRole数据用于显示搜索到的结果(汉字)
-        //Qt::UserRole数据用于输入框输入的数据(拼音/汉字 均可)
-        //即在输入框搜索Qt::UserRole的数据,就会在下拉框显示Qt::EditRole的数据
-        appendRow(new QStandardItem(icon.value(),
-                                    QString("%1 --> %2 / %3").arg(dataBackup->actualModuleName).arg(dataBackup->childPageName).arg(dataBackup->translateContent)));
-
-        //设置汉字的Qt::UserRole数据
-        setData(index(rowCount() - 1, 0),
-                         QString("%1 --> %2 / %3")
-                         .arg(dataBackup->actualModuleName)
-                         .arg(dataBackup->childPageName)
-                         .arg(dataBackup->translateContent),
-                         Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icon->name(), Qt::UserRole + 1);
-
-        QString hanziTxt = QString("%1 --> %2 / %3").arg(dataBackup->actualModuleName).arg(dataBackup->childPageName).arg(dataBackup->translateContent);
-        QString pinyinTxt = QString("%1 --> %2 / %3")
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->actualModuleName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->childPageName.remove(QRegularExpression(R"([a-zA-Z]+)")))))
-                            .arg(removeDigital(DTK_CORE_NAMESPACE::Chinese2Pinyin(dataBackup->translateContent.remove(QRegularExpression(R"([a-zA-Z]+)")))));
-        //添加显示的汉字(用于拼音搜索显示)
-        auto icons = m_iconMap.find(dataBackup->fullPagePath.section('/', 1, 1));
-        if (icons == m_iconMap.end()) {
-            return;
-        }
-        appendRow(new QStandardItem(icons.value(), hanziTxt));
-        //设置Qt::UserRole搜索的拼音(即搜索拼音会显示上面的汉字)
-        setData(index(rowCount() - 1, 0), pinyinTxt, Qt::UserRole);
-        setData(index(rowCount() - 1, 0), icons->name(), Qt::UserRole + 1);
-        SearchDataStruct transdata;
-        transdata.chiese = hanziTxt;
-        transdata.pinyin = pinyinTxt;
-        //存储 汉字和拼音 : 在选择对应的下拉框数据后,会将Qt::UserRole数据设置到输入框(即pinyin)
-        //而在输入框发送 DSearchEdit::textChanged 信号时,会遍历m_inputList,根据pinyin获取到对应汉字,再将汉字设置到输入框
-        m_inputList.append(transdata);
+        text = QString("%1 --> %2 / %3").arg(data->actualModuleName).arg(data->childPageName).arg(data->translateContent);
+    }
+
+    //每条数据只有一行,拼音和首字母在 SearchEngine 中预先计算,不再额外添加拼音行
+    QStandardItem *item = new QStandardItem(icon.value(), text);
+    if (m_bIsChinese) {
+        item->setData(icon->name(), IconNameRole);
     }
+    //记录该数据对应的行,模块/设备是否存在只修改这些行的 VisibleRole
+    item->setData(data->filterFlags == 0, VisibleRole);
+    data->items << item;
+    appendRow(item);
+
+    //行号即 SearchEngine 中的 id
+    m_engine.addEntry(SearchEngine::buildKeys(data->translateContent, text));
 }
 
 //返回值:true,不加载该搜索数据
@@ -614,143 +583,56 @@ void SearchModel::setLanguage(const QString &type)
 #if DEBUG_XML_SWITCH
         qDebug() << " [SearchWidget] " << Q_FUNC_INFO;
 #endif
+        const bool compositingAllowSwitch = m_deepinwm->compositingAllowSwitch();
         for (const QString &i : m_xmlFilePath) {
             QString xmlPath = i.arg(m_lang);
-            QFile   file(xmlPath);
+            QList<SearchIndexEntry> entries;
 
-            if (!file.exists()) {
-                qDebug() << " [SearchWidget] File not exist";
-                continue;
+            //优先使用构建时生成的索引,索引不存在或已过期时再解析xml
+            if (!SearchIndex::load(xmlPath, entries)) {
+                qDebug() << " [SearchWidget] search index unavailable, parse xml : " << xmlPath;
+                if (!SearchIndex::parseTs(xmlPath, entries)) {
+                    continue;
+                }
             }
 
-            if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-                qDebug() << " [SearchWidget] File open failed";
-                continue;
-            }
+            for (const SearchIndexEntry &entry : entries) {
+                SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
+                searchBoxStrcut->translateContent = entry.translateContent;
+                searchBoxStrcut->childPageName = transChildPageName.value(entry.childPage);
+                searchBoxStrcut->fullPagePath = entry.fullPagePath;
+                // follow path module name to get actual module name  ->  Left module dispaly can support
+                // mulLanguages
+                searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
+
+                if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
+                    continue;
+                }
 
-            QXmlStreamReader            xmlRead(&file);
-            QStringRef                  dataName;
-            SearchBoxStruct::Ptr searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-            QString xmlExplain;
-            const bool compositingAllowSwitch = m_deepinwm->compositingAllowSwitch();
-            /*
-            <message>
-                <source>Update Setting</source>
-                <translation>更新设置</translation>
-                <extra-contents_path>/update/Update Setting</extra-contents_path>
-        </message>
-
-        +::StartElement:  "message"
-
-            +::StartElement:  "source"
-                xmlRead.text :  "Update Setting"
-            -::EndElement:  "source"
-
-            +::StartElement:  "translation"
-                xmlRead.text :  "更新设置"
-            -::EndElement:  "translation"
-
-            +::StartElement:  "extra-contents_path"
-                xmlRead.text :  "/update/Update Setting"
-            -::EndElement:  "extra-contents_path"
-
-        -::EndElement:  "message"
-
-        //以上 <>  </> 一一对应,
-        //在xml的 <> 时进入 StartElement ,
-        //在xml 显示中间内容时进入 Characters,
-        //在xml的 </>时进入EndElement
-
-        */
-            //遍历XML文件,读取每一行的xml数据都会
-            //先进入StartElement读取出<>中的内容;
-            //再进入Characters读取出中间数据部分;
-            //最后进入时进入EndElement读取出</>中的内容
-            while (!xmlRead.atEnd()) {
-                switch (xmlRead.readNext()) {
-                    case QXmlStreamReader::StartElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] +::StartElement: " << xmlRead.name() << xmlRead.text();
-#endif
-                        xmlExplain = xmlRead.name().toString();
-                        break;
-                    case QXmlStreamReader::Characters:
-                        if (!xmlRead.isWhitespace()) {
-#if DEBUG_XML_SWITCH
-                            qDebug() << " [SearchWidget]  xmlRead.text : " << xmlRead.text().toString();
-#endif
-                            if (xmlExplain == XML_Source) {  // get xml source date
-                                searchBoxStrcut->translateContent = xmlRead.text().toString();
-                            }
-                            else if (xmlExplain == XML_Title) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString();
-#if DEBUG_XML_SWITCH
-                                qDebug() << " [SearchWidget] searchBoxStrcut->translateContent : " << searchBoxStrcut->translateContent;
-#endif
-                            }
-                            else if (xmlExplain == XML_Numerusform) {
-                                if (xmlRead.text().toString() != "")  // translation not nullptr can set it
-                                    searchBoxStrcut->translateContent = xmlRead.text().toString();
-                            }
-                            else if (XML_Child_Path == xmlExplain) {
-                                searchBoxStrcut->childPageName = transChildPageName.value(xmlRead.text().toString());
-                            }
-                            else if (xmlExplain == XML_Explain_Path) {
-                                searchBoxStrcut->fullPagePath = xmlRead.text().toString();
-                                // follow path module name to get actual module name  ->  Left module dispaly can support
-                                // mulLanguages
-                                searchBoxStrcut->actualModuleName = getModulesName(searchBoxStrcut->fullPagePath.section('/', 1, 1));
-
-                                if ("" == searchBoxStrcut->actualModuleName || "" == searchBoxStrcut->translateContent) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //判断是否为服务器,是服务器时,若当前不是服务器就不添加"Server"
-                                if (isLoadText(searchBoxStrcut->translateContent)) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //判断是否为contens服务器,是contens服务器时,若当前不是服务器就不添加"Server"
-                                if (isLoadContensText(searchBoxStrcut->translateContent)) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //判断是否为服务器，如果是服务器状态下搜索不到网络账户相关（所有界面）
-                                if (m_bIsServerType && tr("Cloud Account") == searchBoxStrcut->actualModuleName) {
-                                    searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                    continue;
-                                }
-
-                                //qDebug()<<"m_deepinwm->compositingAllowSwitch() = "<<m_deepinwm->compositingAllowSwitch();
-                                if (!m_bIsServerType && !compositingAllowSwitch) {
-                                    qDebug() << "search not Window!";
-                                    if (tr("Window Effect") == searchBoxStrcut->translateContent) {
-                                        searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                                        continue;
-                                    }
-                                }
-
-                                list << searchBoxStrcut;
-                                searchBoxStrcut = std::make_shared<SearchBoxStruct>();
-                            }
-                        }
-                        break;
-                    case QXmlStreamReader::EndElement:
-#if DEBUG_XML_SWITCH
-                        qDebug() << " [SearchWidget] -::EndElement: " << xmlRead.name();
-#endif
-                        break;
-                    default: break;
+                //判断是否为服务器,是服务器时,若当前不是服务器就不添加"Server"
+                if (isLoadText(searchBoxStrcut->translateContent)) {
+                    continue;
                 }
-            }
 
-            qDebug() << " [SearchWidget] m_EnterNewPagelist.count : " << m_EnterNewPagelist.count();
+                //判断是否为contens服务器,是contens服务器时,若当前不是服务器就不添加"Server"
+                if (isLoadContensText(searchBoxStrcut->translateContent)) {
+                    continue;
+                }
+
+                //判断是否为服务器，如果是服务器状态下搜索不到网络账户相关（所有界面）
+                if (m_bIsServerType && tr("Cloud Account") == searchBoxStrcut->actualModuleName) {
+                    continue;
+                }
 
-            file.close();
+                if (!m_bIsServerType && !compositingAllowSwitch) {
+                    qDebug() << "search not Window!";
+                    if (tr("Window Effect") == searchBoxStrcut->translateContent) {
+                        continue;
+                    }
+                }
+
+                list << searchBoxStrcut;
+            }
         }
 
         return list;
@@ -793,7 +675,7 @@ void SearchModel::addUnExsitData(const QString &module, const QString &datail)
     data.datail = datail;
     m_unexsitList.append(data);
 
-    return loadxml();
+    return updateModuleFilter(module);
 }
 
 void SearchModel::removeUnExsitData(const QString &module, const QString &datail)
@@ -806,7 +688,7 @@ void SearchModel::removeUnExsitData(const QString &module, const QString &datail
         m_unexsitList.erase(find);
     }
 
-    return loadxml();
+    return updateModuleFilter(module);
 }
 
 void SearchModel::setRemoveableDeviceStatus(const QString &name, bool isExist)
@@ -833,7 +715,7 @@ void SearchModel::setRemoveableDeviceStatus(const QString &name, bool isExist)
         }
 
         qDebug() << "[setRemoveableDeviceStatus] loadWidget : " << name << " , isExist : " << isExist;
-        loadxml();
+        updateRemoveableFilter(value.second);
     } else {
         qDebug() << " Not remember the data , name : " << name;
     }
@@ -852,7 +734,12 @@ void SearchWidget::onAutoComplete(const QString &text)
     if (widget && text.isEmpty()) {
         widget->hide();
     } else {
-        m_completer->setCompletionPrefix(text);
+        m_filterModel->setSearchResult(m_model->search(text));
+        //UnfilteredPopupCompletion 模式下没有结果也会弹出空的下拉框
+        if (m_filterModel->rowCount() == 0) {
+            widget->hide();
+            return;
+        }
         m_completer->complete();
     }
 }
@@ -919,12 +806,6 @@ bool SearchWidget::jumpContentPathWidget(const QString &path)
 
 void SearchWidget::setLanguage(const QString &type)
 {
-    if (type == "zh_CN" || type == "zh_HK" || type == "zh_TW") {
-        m_completer->setCompletionRole(Qt::UserRole); //设置ItemDataRole
-    } else {
-        m_completer->setCompletionRole(Qt::DisplayRole);
-    }
-
     return m_model->setLanguage(type);
 }
 
@@ -21,6 +21,8 @@
 #pragma once
 
 #include "interface/namespace.h"
+#include "searchindex.h"
+#include "searchengine.h"
 
 #include "dsearchedit.h"
 #include <com_deepin_wm.h>
@@ -30,6 +32,7 @@
 #include <QLocale>
 #include <QListView>
 #include <QStandardItemModel>
+#include <QSortFilterProxyModel>
 #include <QStyledItemDelegate>
 #include <QGSettings>
 #include <memory>
@@ -38,32 +41,28 @@ QT_BEGIN_NAMESPACE
 class QListWidget;
 class QListWidgetItem;
 class QPushButton;
-class QXmlStreamReader;
 QT_END_NAMESPACE
 
 #define DEBUG_XML_SWITCH 0
 
-const QString XML_Source = "source";
-const QString XML_Title = "translation";
-const QString XML_Numerusform = "numerusform";
-const QString XML_Explain_Path = "extra-contents_path";
-const QString XML_Child_Path = "extra-child_page";
-
 using WM = com::deepin::wm;
 
 namespace DCC_NAMESPACE {
 namespace search {
 struct SearchBoxStruct {
     typedef std::shared_ptr<SearchBoxStruct> Ptr;
+    //隐藏该数据的原因,任意一位被置上时都不显示
+    enum FilterFlag {
+        UnexsitModule = 0x1,        // 模块不存在(如蓝牙,数位板)
+        RemoveableDevice = 0x2,     // 可移除设备不存在(如触控板,指点杆)
+        DuplicateText = 0x4,        // 已有相同文言的数据在显示
+    };
     QString translateContent;
     QString actualModuleName;
     QString childPageName;
     QString fullPagePath;
-};
-
-struct SearchDataStruct {
-    QString chiese;
-    QString pinyin;
+    int filterFlags = 0;
+    QList<QStandardItem *> items;   // 该数据在 SearchModel 中对应的行
 };
 
 struct UnexsitStruct {
@@ -80,10 +79,33 @@ public:
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const override;
 };
 
+//只显示搜索结果中 SearchModel::VisibleRole 为 true 的行,并按匹配程度排序
+//设备插拔时只有对应的行会被插入/移除
+class SearchFilterModel : public QSortFilterProxyModel
+{
+    Q_OBJECT
+public:
+    explicit SearchFilterModel(QObject *parent = nullptr);
+
+    void setSearchResult(const QVector<int> &rows);
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override;
+
+private:
+    QHash<int, int> m_rank; // SearchModel 中的行 -> 排名
+};
+
 class SearchModel : public QStandardItemModel {
     Q_OBJECT
     friend class SearchWidget;
 public:
+    enum SearchDataRole {
+        IconNameRole = Qt::UserRole + 1,
+        VisibleRole
+    };
+
     explicit SearchModel(QObject* parent = nullptr);
 
 public:
@@ -93,6 +115,7 @@ public:
     void addUnExsitData(const QString &module = "", const QString &datail = "");
     void removeUnExsitData(const QString &module = "", const QString &datail = "");
     void setRemoveableDeviceStatus(const QString &name, bool isExist);
+    QVector<int> search(const QString &text) const;
 
 Q_SIGNALS:
     void notifyModuleSearch(QString, QString);
@@ -101,10 +124,11 @@ private:
     void loadxml();
     SearchBoxStruct::Ptr getModuleBtnString(QString value);
     QString getModulesName(const QString &name, bool state = true);
-    QString removeDigital(QString input);
-    QString transPinyinToChinese(const QString &pinyin);
-    QString containTxtData(QString txt);
-    void appendChineseData(SearchBoxStruct::Ptr data);
+    void appendSearchData(SearchBoxStruct::Ptr data);
+    void setFilterFlag(SearchBoxStruct::Ptr data, SearchBoxStruct::FilterFlag flag, bool on);
+    void updateDuplicateText(const QString &text);
+    void updateModuleFilter(const QString &module);
+    void updateRemoveableFilter(const QString &page);
     bool isLoadText(const QString &txt);
     bool isLoadContensText(const QString &text);
 
@@ -115,11 +139,13 @@ private:
     QString m_lang;
     QMap<QString, QIcon> m_iconMap;
     QList<QPair<QString, QString>> m_moduleNameList;//用于存储如 "update"和"Update"
-    QList<SearchDataStruct> m_inputList;
+    SearchEngine m_engine;
     QList<UnexsitStruct>    m_unexsitList;
     QList<QPair<QString, bool>> m_serverTxtList;//QString表示和服务器/桌面版有关的文言,bool:true表示只有服务器版会存在,false表示只有桌面版存在
     QList<QString> m_TxtList;
-    QList<QString> m_TxtListAll;
+    QHash<QString, QList<SearchBoxStruct::Ptr>> m_textEntries;     //相同文言的数据,只显示第一个可见的
+    QMultiHash<QString, SearchBoxStruct::Ptr> m_moduleEntries;     //key: actualModuleName
+    QMultiHash<QString, SearchBoxStruct::Ptr> m_removeableEntries; //key: 可移除设备对应的页面
     QStringList m_defaultRemoveableList;//存储已知全部模块是否存在
     QList<QPair<QString, QString>> m_removedefaultWidgetList;//用于存储可以出设备名称，和该名称对应的页面
     QList<QPair<QString, QString>> m_removeableActualExistList;//存储实际模块是否存在
@@ -156,6 +182,7 @@ Q_SIGNALS:
 
 private:
     SearchModel *m_model;
+    SearchFilterModel *m_filterModel;
     QCompleter *m_completer;
     DCompleterStyledItemDelegate styledItemDelegate;
 };
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     zccrs <zccrs@live.com>
+ *
+ * Maintainer: zccrs <zhangjide@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "startupscheduler.h"
+#include "moduleregistry.h"
+
+#include <QDBusConnection>
+#include <QDBusMessage>
+#include <QDBusPendingCallWatcher>
+#include <QTimer>
+#include <QDebug>
+
+using namespace DCC_NAMESPACE;
+
+StartupScheduler::StartupScheduler(ModuleRegistry *registry, QObject *parent)
+    : QObject(parent)
+    , m_registry(registry)
+    , m_started(false)
+    , m_scheduled(false)
+{
+}
+
+void StartupScheduler::schedule(int index, bool sync)
+{
+    if (isPending(index) || m_registry->isLoaded(index))
+        return;
+
+    // 加入队列时就开始激活服务,与其他模块的服务以及窗口的初始化并行
+    Task task { index, sync, {} };
+    const ModuleMetadata &meta = m_registry->metadata(index);
+    for (const QString &service : meta.sessionServices)
+        task.calls << activate(service, false);
+    for (const QString &service : meta.systemServices)
+        task.calls << activate(service, true);
+
+    m_tasks << task;
+}
+
+void StartupScheduler::start()
+{
+    m_started = true;
+    scheduleNext();
+}
+
+void StartupScheduler::join(int index)
+{
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (m_tasks.at(i).index != index)
+            continue;
+
+        Task task = m_tasks.takeAt(i);
+        for (QDBusPendingCall &call : task.calls)
+            call.waitForFinished();
+
+        run(task);
+        if (m_tasks.isEmpty())
+            Q_EMIT finished();
+        return;
+    }
+}
+
+bool StartupScheduler::isPending(int index) const
+{
+    for (const Task &task : m_tasks) {
+        if (task.index == index)
+            return true;
+    }
+
+    return false;
+}
+
+void StartupScheduler::runNext()
+{
+    m_scheduled = false;
+
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        if (!isReady(m_tasks.at(i)))
+            continue;
+
+        run(m_tasks.takeAt(i));
+        if (m_tasks.isEmpty()) {
+            Q_EMIT finished();
+        } else {
+            scheduleNext();
+        }
+        return;
+    }
+
+    // 没有服务已就绪的模块,等待下一个服务激活完成后再调度
+}
+
+QDBusPendingCall StartupScheduler::activate(const QString &service, bool systemBus)
+{
+    const QString &key = QString("%1:%2").arg(systemBus ? "system" : "session").arg(service);
+    auto it = m_activations.constFind(key);
+    if (it != m_activations.cend())
+        return it.value();
+
+    QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.DBus",
+                                                      "/org/freedesktop/DBus",
+                                                      "org.freedesktop.DBus",
+                                                      "StartServiceByName");
+    msg << service << quint32(0);
+
+    QDBusConnection bus = systemBus ? QDBusConnection::systemBus() : QDBusConnection::sessionBus();
+    QDBusPendingCall call = bus.asyncCall(msg);
+    m_activations.insert(key, call);
+
+    const qint64 begin = m_registry->now();
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call, this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [this, key, begin](QDBusPendingCallWatcher *w) {
+        if (w->isError())
+            qDebug() << QString("activate %1 failed: %2").arg(key).arg(w->error().message());
+
+        m_registry->addEvent(key, "dbus", begin, m_registry->now() - begin);
+        w->deleteLater();
+        scheduleNext();
+    });
+
+    return call;
+}
+
+bool StartupScheduler::isReady(const Task &task) const
+{
+    for (const QDBusPendingCall &call : task.calls) {
+        if (!call.isFinished())
+            return false;
+    }
+
+    return true;
+}
+
+void StartupScheduler::run(const Task &task)
+{
+    m_registry->load(task.index, ModuleRegistry::Startup, task.sync);
+    Q_EMIT moduleLoaded(task.index);
+}
+
+void StartupScheduler::scheduleNext()
+{
+    if (!m_started || m_scheduled || m_tasks.isEmpty())
+        return;
+
+    // 每次事件循环只执行一个模块,期间窗口可以处理绘制和输入事件
+    m_scheduled = true;
+    QTimer::singleShot(0, this, &StartupScheduler::runNext);
+}
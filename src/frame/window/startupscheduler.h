@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     zccrs <zccrs@live.com>
+ *
+ * Maintainer: zccrs <zhangjide@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include "interface/namespace.h"
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QDBusPendingCall>
+
+namespace DCC_NAMESPACE {
+class ModuleRegistry;
+
+/**
+ * @brief The StartupScheduler class 启动时模块 DBus 服务的预激活
+ * 模块加入队列时通过异步的 StartServiceByName 并行激活它的 worker 会访问的服务,
+ * 服务就绪后每次事件循环串行 preInitialize 一个模块,避免 worker 构造时同步等待服务启动;
+ * 模块第一次显示前调用 join,等待自己的服务并立即 preInitialize
+ */
+class StartupScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit StartupScheduler(ModuleRegistry *registry, QObject *parent = nullptr);
+
+    void schedule(int index, bool sync = false);
+    void start();
+    void join(int index);
+
+    bool isPending(int index) const;
+    bool isFinished() const { return m_tasks.isEmpty(); }
+
+Q_SIGNALS:
+    void moduleLoaded(int index);
+    void finished();
+
+private Q_SLOTS:
+    void runNext();
+
+private:
+    struct Task {
+        int index;
+        bool sync;
+        QList<QDBusPendingCall> calls;
+    };
+
+    QDBusPendingCall activate(const QString &service, bool systemBus);
+    bool isReady(const Task &task) const;
+    void run(const Task &task);
+    void scheduleNext();
+
+private:
+    ModuleRegistry *m_registry;
+    QList<Task> m_tasks;
+    // 服务名 -> 激活服务的异步调用,多个模块依赖同一个服务时只激活一次
+    QHash<QString, QDBusPendingCall> m_activations;
+    bool m_started;
+    bool m_scheduled;
+};
+
+}// namespace DCC_NAMESPACE
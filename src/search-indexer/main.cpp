@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2019 ~ 2019 Deepin Technology Co., Ltd.
+ *
+ * Author:     wubw <wubowen_cm@deepin.com>
+ *
+ * Maintainer: wubw <wubowen_cm@deepin.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "searchindex.h"
+
+#include <QCoreApplication>
+#include <QStringList>
+
+#include <iostream>
+
+using namespace DCC_NAMESPACE::search;
+
+// 用法: dcc-search-indexer <xxx.ts> <xxx.idx>
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList &args = app.arguments();
+
+    if (args.size() != 3) {
+        std::cerr << "usage: dcc-search-indexer <translation.ts> <output.idx>" << std::endl;
+        return -1;
+    }
+
+    if (!SearchIndex::write(args.at(1), args.at(2))) {
+        std::cerr << "failed to generate search index for " << args.at(1).toStdString() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include "quick_control/wifi/accesspointtable.h"
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QDebug>
+
+class Tst_AccessPointTable : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new AccessPointTable;
+        obj->setDevices({ &dev1, &dev2 });
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+    static AccessPoint ap(const QString &ssid, int strength, const QString &path = QString())
+    {
+        AccessPoint ap;
+        ap.ssid = ssid;
+        ap.path = path.isEmpty() ? "/ap/" + ssid : path;
+        ap.strength = strength;
+        return ap;
+    }
+
+public:
+    QObject dev1;
+    QObject dev2;
+    AccessPointTable *obj = nullptr;
+};
+
+TEST_F(Tst_AccessPointTable, fromJson)
+{
+    const AccessPoint &ap = AccessPoint::fromJson({ { "Ssid", "office" }, { "Path", "/ap/1" }, { "Strength", 64 },
+                                                    { "Secured", true }, { "SecuredInEap", true } });
+
+    EXPECT_EQ(ap.ssid, QString("office"));
+    EXPECT_EQ(ap.path, QString("/ap/1"));
+    EXPECT_EQ(ap.strength, 64);
+    EXPECT_TRUE(ap.secured);
+    EXPECT_EQ(ap.flags, uint(AccessPoint::SecuredInEap));
+}
+
+TEST_F(Tst_AccessPointTable, rows)
+{
+    // 2 headers + hidden network
+    EXPECT_EQ(obj->rowCount(), 3);
+
+    obj->append(&dev1, ap("a", 10));
+    obj->append(&dev1, ap("b", 80));
+    obj->append(&dev2, ap("c", 50));
+    obj->sort(&dev1, QString());
+
+    ASSERT_EQ(obj->rowCount(), 6);
+    EXPECT_EQ(obj->row(0).device, &dev1);
+    EXPECT_EQ(obj->row(0).ap, -1);
+    EXPECT_EQ(obj->accessPoint(&dev1, obj->row(1).ap)->ssid, QString("b"));
+    EXPECT_EQ(obj->row(3).device, &dev2);
+    EXPECT_EQ(obj->row(5).device, nullptr);
+
+    EXPECT_EQ(obj->rowOf(&dev2), 3);
+    EXPECT_EQ(obj->rowOf(&dev2, 0), 4);
+    EXPECT_EQ(obj->indexOfPath(&dev1, "/ap/a"), 1);
+    EXPECT_EQ(obj->indexOfSsid(&dev1, "b"), 0);
+
+    // active ap first
+    obj->sort(&dev1, "a");
+    EXPECT_EQ(obj->indexOfSsid(&dev1, "a"), 0);
+
+    obj->remove(&dev1, 0);
+    EXPECT_EQ(obj->rowCount(), 5);
+    EXPECT_EQ(obj->indexOfPath(&dev1, "/ap/a"), -1);
+    EXPECT_EQ(obj->rowOf(&dev2), 2);
+
+    // aps of remaining devices are kept
+    obj->setDevices({ &dev2 });
+    EXPECT_EQ(obj->rowCount(), 3);
+    EXPECT_EQ(obj->count(&dev2), 1);
+    EXPECT_FALSE(obj->contains(&dev1));
+}
+
+TEST_F(Tst_AccessPointTable, benchmark)
+{
+    // 150+ BSSIDs in a dense office, all strengths change every scan
+    const int ApCount = 160;
+    const int Scans = 200;
+
+    for (int i = 0; i < ApCount; ++i)
+        obj->append(i % 2 ? &dev1 : &dev2, ap(QString("ssid-%1").arg(i), i % 100));
+    obj->sort(&dev1, QString());
+    obj->sort(&dev2, QString());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    quint32 seed = 1;
+    qint64 visited = 0;
+    for (int scan = 0; scan < Scans; ++scan) {
+        for (int i = 0; i < ApCount; ++i) {
+            const QObject *dev = i % 2 ? &dev1 : &dev2;
+            const QString &path = QString("/ap/ssid-%1").arg(i);
+            const int index = obj->indexOfPath(dev, path);
+            if (index == -1)
+                continue;
+
+            seed = seed * 1103515245 + 12345;
+            AccessPoint changed = *obj->accessPoint(dev, index);
+            changed.strength = (seed >> 16) % 100;
+            obj->replace(dev, index, changed);
+        }
+
+        // a few aps come and go
+        obj->remove(&dev1, 0);
+        obj->append(&dev1, ap(QString("ssid-%1").arg(scan % ApCount * 2 + 1), 50));
+        obj->sort(&dev1, QString());
+
+        // repaint every row
+        for (int r = 0; r < obj->rowCount(); ++r) {
+            const AccessPointTable::Row row = obj->row(r);
+            if (const AccessPoint *ap = obj->accessPoint(row.device, row.ap))
+                visited += ap->strength >= 0;
+        }
+    }
+
+    const qint64 elapsed = timer.nsecsElapsed();
+    EXPECT_EQ(obj->rowCount(), ApCount + 3);
+    EXPECT_GT(visited, 0);
+
+    qInfo() << "aps:" << ApCount << "scans:" << Scans
+            << "per scan(us):" << elapsed / Scans / 1000;
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "window/modules/accounts/avatarcache.h"
+
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+
+using namespace DCC_NAMESPACE::accounts;
+
+class Tst_AvatarCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        cacheDir = dir.filePath("cache");
+
+        QImage img(QSize(200, 200), QImage::Format_RGB32);
+        img.fill(Qt::red);
+        path = dir.filePath("avatar.png");
+        ASSERT_TRUE(img.save(path));
+    }
+
+    int cacheCount() const
+    {
+        return QDir(cacheDir).entryList(QDir::Files).size();
+    }
+
+public:
+    QTemporaryDir dir;
+    QString cacheDir;
+    QString path;
+};
+
+TEST_F(Tst_AvatarCache, render)
+{
+    const QImage &img = AvatarCache::render(path, QSize(30, 30), 2, true, cacheDir);
+    ASSERT_EQ(img.size(), QSize(60, 60));
+    EXPECT_EQ(img.devicePixelRatio(), 2);
+    // 圆形以外透明
+    EXPECT_EQ(qAlpha(img.pixel(0, 0)), 0);
+    EXPECT_EQ(img.pixelColor(30, 30), QColor(Qt::red));
+    EXPECT_EQ(cacheCount(), 1);
+
+    // 第二次直接读取缓存
+    EXPECT_EQ(AvatarCache::render(path, QSize(30, 30), 2, true, cacheDir).size(), QSize(60, 60));
+    EXPECT_EQ(cacheCount(), 1);
+
+    // 不同的缩放比例单独缓存
+    EXPECT_EQ(AvatarCache::render(path, QSize(30, 30), 1, true, cacheDir).size(), QSize(30, 30));
+    EXPECT_EQ(cacheCount(), 2);
+
+    EXPECT_TRUE(AvatarCache::render(dir.filePath("missing.png"), QSize(30, 30), 1, true, cacheDir).isNull());
+}
+
+TEST_F(Tst_AvatarCache, modified)
+{
+    AvatarCache::render(path, QSize(74, 74), 1, false, cacheDir);
+    ASSERT_EQ(cacheCount(), 1);
+
+    // 头像文件被替换后重新生成
+    QImage img(QSize(100, 50), QImage::Format_RGB32);
+    img.fill(Qt::green);
+    QFile::remove(path);
+    ASSERT_TRUE(img.save(path));
+
+    const QImage &result = AvatarCache::render(path, QSize(74, 74), 1, false, cacheDir);
+    EXPECT_EQ(result.size(), QSize(74, 37));
+    EXPECT_EQ(cacheCount(), 2);
+}
+
+TEST_F(Tst_AvatarCache, fileKey)
+{
+    // 内存缓存的键, 与路径、大小、缩放比例和文件内容都有关
+    const QString &k = AvatarCache::fileKey(QFileInfo(path), QSize(74, 74), 1, false);
+    EXPECT_EQ(AvatarCache::fileKey(QFileInfo(path), QSize(74, 74), 1, false), k);
+    EXPECT_NE(AvatarCache::fileKey(QFileInfo(path), QSize(74, 74), 2, false), k);
+
+    // 同一路径的头像被替换后键改变
+    QImage img(QSize(100, 50), QImage::Format_RGB32);
+    img.fill(Qt::green);
+    QFile::remove(path);
+    ASSERT_TRUE(img.save(path));
+
+    EXPECT_NE(AvatarCache::fileKey(QFileInfo(path), QSize(74, 74), 1, false), k);
+}
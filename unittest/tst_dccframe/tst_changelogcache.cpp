@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "modules/update/changelogcache.h"
+
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QFile>
+
+using namespace dcc::update;
+
+class Tst_ChangeLogCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        path = dir.filePath("UpdateInfo.json");
+
+        QFile file(path);
+        ASSERT_TRUE(file.open(QFile::WriteOnly));
+        file.write(R"({
+            "systemInfo": { "update_time": "2020-06-01", "zh_CN": "系统更新", "en_US": "System updates" },
+            "appInfo": [
+                { "package_id": "deepin-music", "zh_CN": "音乐旧日志", "en_US": "old music log" },
+                { "package_id": "deepin-movie", "zh_CN": "影院日志" },
+                { "package_id": "deepin-music", "zh_CN": "音乐日志", "en_US": "music log" }
+            ]
+        })");
+    }
+
+public:
+    QTemporaryDir dir;
+    QString path;
+};
+
+TEST_F(Tst_ChangeLogCache, parse)
+{
+    const ChangeLogData &data = ChangeLogCache::parse(path);
+
+    EXPECT_EQ(data.updateTime, QString("2020-06-01"));
+    EXPECT_EQ(data.systemInfo.value("en_US"), QString("System updates"));
+    EXPECT_FALSE(data.systemInfo.contains("update_time"));
+
+    ASSERT_EQ(data.appInfo.size(), 2);
+    // 同一个包出现多次时以最后一条为准
+    EXPECT_EQ(data.appInfo.value("deepin-music").value("zh_CN"), QString("音乐日志"));
+    EXPECT_EQ(data.appInfo.value("deepin-movie").value("zh_CN"), QString("影院日志"));
+    EXPECT_TRUE(data.appInfo.value("deepin-movie").value("en_US").isEmpty());
+}
+
+TEST_F(Tst_ChangeLogCache, lookup)
+{
+    ChangeLogCache cache(path);
+
+    EXPECT_EQ(cache.systemUpdateTime(), QString("2020-06-01"));
+    EXPECT_EQ(cache.systemChangelog("zh_CN"), QString("系统更新"));
+    EXPECT_EQ(cache.changelog("deepin-music", "en_US"), QString("music log"));
+    EXPECT_TRUE(cache.changelog("deepin-terminal", "en_US").isEmpty());
+
+    EXPECT_TRUE(ChangeLogCache::parse(dir.filePath("missing.json")).appInfo.isEmpty());
+}
+
+TEST_F(Tst_ChangeLogCache, reload)
+{
+    ChangeLogCache cache(path);
+    ASSERT_EQ(cache.changelog("deepin-music", "en_US"), QString("music log"));
+
+    QSignalSpy spy(&cache, &ChangeLogCache::changed);
+
+    // 软件包更新后整体替换日志文件
+    QFile file(path);
+    ASSERT_TRUE(file.open(QFile::WriteOnly | QFile::Truncate));
+    file.write(R"({ "appInfo": [ { "package_id": "deepin-music", "en_US": "new music log, with more details" } ] })");
+    file.close();
+
+    for (int i = 0; i < 10 && cache.changelog("deepin-music", "en_US") != "new music log, with more details"; ++i)
+        spy.wait(500);
+
+    EXPECT_EQ(cache.changelog("deepin-music", "en_US"), QString("new music log, with more details"));
+    EXPECT_TRUE(cache.systemUpdateTime().isEmpty());
+    EXPECT_FALSE(spy.isEmpty());
+}
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include "modules/bluetooth/adapter.h"
+#include "modules/bluetooth/devicetable.h"
+
+#include <QJsonDocument>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace dcc::bluetooth;
+
+class Tst_DeviceTable : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        adapter = new Adapter;
+        adapter->setId("/org/bluez/hci0");
+        table = new DeviceTable;
+
+        for (int i = 0; i < DeviceCount; ++i) {
+            Device *device = new Device(adapter);
+            device->setId(path(i));
+            device->setName(QString("Device %1").arg(i));
+            adapter->addDevice(device);
+            table->insert(device);
+        }
+    }
+
+    void TearDown() override
+    {
+        delete table;
+        table = nullptr;
+        delete adapter;
+        adapter = nullptr;
+    }
+
+    static quint32 random(quint32 &seed)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    static QString path(int i)
+    {
+        return QString("/org/bluez/hci0/dev_%1").arg(i);
+    }
+
+    // 与后端 DevicePropertiesChanged 发送的内容一致
+    static QJsonObject properties(int i, int state, int rssi)
+    {
+        QJsonObject obj;
+        obj["Path"] = path(i);
+        obj["AdapterPath"] = "/org/bluez/hci0";
+        obj["Name"] = QString("Device %1").arg(i);
+        obj["Alias"] = "";
+        obj["Address"] = QString("00:11:22:33:44:%1").arg(i % 100, 2, 10, QChar('0'));
+        obj["Paired"] = false;
+        obj["State"] = state;
+        obj["ConnectState"] = false;
+        obj["Icon"] = "audio-card";
+        obj["RSSI"] = rssi;
+        return obj;
+    }
+
+    static void apply(Device *device, const QJsonObject &obj)
+    {
+        device->setName(obj["Name"].toString());
+        device->setAlias(obj["Alias"].toString());
+        device->setPaired(obj["Paired"].toBool());
+        device->setState(Device::State(obj["State"].toInt()), obj["ConnectState"].toBool());
+        device->setDeviceType(obj["Icon"].toString());
+    }
+
+public:
+    static const int DeviceCount = 200;
+    Adapter *adapter = nullptr;
+    DeviceTable *table = nullptr;
+};
+
+TEST_F(Tst_DeviceTable, index)
+{
+    EXPECT_EQ(table->count(), DeviceCount);
+    EXPECT_EQ(table->device(path(7)), adapter->deviceById(path(7)));
+    EXPECT_EQ(table->device("/org/bluez/hci0/dev_none"), nullptr);
+
+    table->remove(path(7));
+    EXPECT_EQ(table->device(path(7)), nullptr);
+    EXPECT_EQ(table->count(), DeviceCount - 1);
+}
+
+TEST_F(Tst_DeviceTable, coalesce)
+{
+    QSignalSpy spy(table, &DeviceTable::devicePropertiesChanged);
+
+    // 一帧内同一设备的多次变化只通知一次,使用最后的属性
+    for (int n = 0; n < 10; ++n) {
+        for (int i = 0; i < 3; ++i)
+            table->enqueue(properties(i, n % 3, -n));
+    }
+    EXPECT_EQ(table->pendingCount(), 3);
+    EXPECT_TRUE(spy.isEmpty());
+
+    ASSERT_TRUE(spy.wait(1000));
+    ASSERT_EQ(spy.size(), 3);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(spy.at(i).at(0).value<Device *>(), table->device(path(i)));
+        EXPECT_EQ(spy.at(i).at(1).value<QJsonObject>()["RSSI"].toInt(), -9);
+    }
+    EXPECT_EQ(table->pendingCount(), 0);
+}
+
+TEST_F(Tst_DeviceTable, remove)
+{
+    QSignalSpy spy(table, &DeviceTable::devicePropertiesChanged);
+
+    // 不在表中的设备忽略
+    table->enqueue(properties(DeviceCount, 1, 0));
+    EXPECT_EQ(table->pendingCount(), 0);
+
+    // 移除的设备丢弃排队的变化,重新加入后再变化只通知一次
+    Device *device = table->device(path(1));
+    table->enqueue(properties(0, 1, 0));
+    table->enqueue(properties(1, 1, 0));
+    table->remove(path(1));
+    table->insert(device);
+    table->enqueue(properties(1, 2, 0));
+    table->flush();
+
+    ASSERT_EQ(spy.size(), 2);
+    EXPECT_EQ(spy.at(0).at(0).value<Device *>(), table->device(path(0)));
+    EXPECT_EQ(spy.at(1).at(1).value<QJsonObject>()["State"].toInt(), 2);
+}
+
+TEST_F(Tst_DeviceTable, benchmark)
+{
+    // 扫描时大量设备的 RSSI 和状态不停变化
+    QList<QByteArray> flood;
+    quint32 seed = 17;
+    for (int i = 0; i < 20000; ++i) {
+        const int index = static_cast<int>(random(seed) % DeviceCount);
+        const QJsonObject &obj = properties(index, static_cast<int>(random(seed) % 3), -static_cast<int>(random(seed) % 100));
+        flood << QJsonDocument(obj).toJson(QJsonDocument::Compact);
+    }
+
+    int notifications = 0;
+    for (const Device *device : adapter->devices())
+        QObject::connect(device, &Device::stateChanged, [&notifications] { ++notifications; });
+
+    QList<const Adapter *> adapters { adapter };
+    QElapsedTimer timer;
+
+    // 原来的方式: 每次变化都遍历适配器查找设备并立即更新
+    timer.start();
+    for (const QByteArray &json : flood) {
+        const QJsonObject obj = QJsonDocument::fromJson(json).object();
+        for (const Adapter *a : adapters) {
+            Device *device = const_cast<Device *>(a->deviceById(obj["Path"].toString()));
+            if (device)
+                apply(device, obj);
+        }
+    }
+    const qint64 directTime = timer.nsecsElapsed();
+    const int directNotifications = notifications;
+
+    // 每 500 个变化算作一帧
+    notifications = 0;
+    QObject::connect(table, &DeviceTable::devicePropertiesChanged, &Tst_DeviceTable::apply);
+    int frames = 0;
+    timer.start();
+    for (int i = 0; i < flood.size(); ++i) {
+        table->enqueue(QJsonDocument::fromJson(flood.at(i)).object());
+        if (i % 500 == 499) {
+            table->flush();
+            ++frames;
+        }
+    }
+    table->flush();
+    const qint64 tableTime = timer.nsecsElapsed();
+
+    EXPECT_LT(notifications, directNotifications);
+
+    qInfo() << "devices:" << DeviceCount << "updates:" << flood.size() << "frames:" << frames
+            << "direct(us):" << directTime / 1000 << "notifications:" << directNotifications
+            << "coalesced(us):" << tableTime / 1000 << "notifications:" << notifications;
+}
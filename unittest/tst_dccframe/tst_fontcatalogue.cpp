@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+#include "modules/personalization/model/fontcatalogue.h"
+
+#include <QLocale>
+
+using namespace dcc::personalization;
+
+TEST(Tst_FontCatalogue, parse)
+{
+    const QByteArray json = R"([
+        { "Id": "Noto Sans CJK SC", "Name": "Noto Sans CJK SC" },
+        { "Id": "dejavu", "Name": "DejaVu Sans" },
+        { "Id": "wqy", "Name": "文泉驿微米黑" },
+        { "Id": "arial", "Name": "arial" }
+    ])";
+
+    // 排序使用默认语言环境的排序规则, 固定为 en_US 使结果不依赖运行环境
+    const QLocale locale;
+    QLocale::setDefault(QLocale("en_US"));
+    const QList<QJsonObject> &list = FontCatalogue::parse("standardfont", json);
+    QLocale::setDefault(locale);
+
+    ASSERT_EQ(list.size(), 4);
+    EXPECT_EQ(list.at(0)["Id"].toString(), QString("arial"));
+    EXPECT_EQ(list.at(1)["Id"].toString(), QString("dejavu"));
+    EXPECT_EQ(list.at(2)["Id"].toString(), QString("Noto Sans CJK SC"));
+    for (const QJsonObject &obj : list)
+        EXPECT_EQ(obj["type"].toString(), QString("standardfont"));
+
+    EXPECT_TRUE(FontCatalogue::parse("monospacefont", "not json").isEmpty());
+}
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+
+#include "modules/keyboard/layoutindex.h"
+
+#include <QFile>
+#include <QXmlStreamReader>
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace dcc::keyboard;
+
+class Tst_LayoutIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new LayoutIndex;
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+    // 读取系统 xkb 规则中的全部布局和变体,与 InputDevices 服务返回的布局列表规模一致
+    static QMap<QString, QString> xkbLayouts()
+    {
+        QMap<QString, QString> layouts;
+        QFile file("/usr/share/X11/xkb/rules/base.xml");
+        if (!file.open(QFile::ReadOnly))
+            return layouts;
+
+        QXmlStreamReader xml(&file);
+        QString layout;
+        QString name;
+        bool variant = false;
+        while (!xml.atEnd()) {
+            xml.readNext();
+            if (xml.isStartElement()) {
+                if (xml.name() == QLatin1String("layout")) {
+                    variant = false;
+                } else if (xml.name() == QLatin1String("variant")) {
+                    variant = true;
+                } else if (xml.name() == QLatin1String("name")) {
+                    name = xml.readElementText();
+                    if (!variant)
+                        layout = name;
+                } else if (xml.name() == QLatin1String("description") && !name.isEmpty()) {
+                    layouts.insert(variant ? layout + ";" + name : layout + ";", xml.readElementText());
+                    name.clear();
+                }
+            }
+        }
+
+        return layouts;
+    }
+
+public:
+    LayoutIndex *obj = nullptr;
+};
+
+TEST_F(Tst_LayoutIndex, pinyin)
+{
+    EXPECT_EQ(obj->pinyin("English (US)"), QString("English (US)"));
+    EXPECT_EQ(obj->pinyin("汉语"), QString("hanyu"));
+    EXPECT_EQ(obj->pinyin("德语(瑞士)"), QString("deyu(ruishi)"));
+    EXPECT_TRUE(obj->pinyin(QString()).isEmpty());
+}
+
+TEST_F(Tst_LayoutIndex, grouped)
+{
+    const QMap<QString, QString> layouts {
+        { "de;", "德语" },
+        { "us;", "英语(美国)" },
+        { "cn;", "汉语" },
+        { "fr;", "法语" },
+        { "us;dvorak", "英语(Dvorak)" },
+        { "af;", "Afghani" },
+    };
+
+    QList<LayoutIndexItem> items;
+    QList<QString> letters;
+    obj->build(layouts, true, items, letters);
+
+    EXPECT_EQ(letters, QList<QString>({ "A", "D", "F", "H", "Y" }));
+    ASSERT_EQ(items.size(), layouts.size() + letters.size());
+
+    QStringList order;
+    for (const LayoutIndexItem &item : items)
+        order << (item.section ? "[" + item.text + "]" : item.key);
+    EXPECT_EQ(order, QStringList({ "[A]", "af;", "[D]", "de;", "[F]", "fr;", "[H]", "cn;", "[Y]", "us;dvorak", "us;" }));
+}
+
+TEST_F(Tst_LayoutIndex, collated)
+{
+    const QMap<QString, QString> layouts {
+        { "b", "banana" },
+        { "a", "Apple" },
+        { "c", "cherry" },
+    };
+
+    QList<LayoutIndexItem> items;
+    QList<QString> letters;
+    obj->build(layouts, false, items, letters);
+
+    EXPECT_TRUE(letters.isEmpty());
+    ASSERT_EQ(items.size(), 3);
+    EXPECT_EQ(items.at(0).key, QString("a"));
+    EXPECT_EQ(items.at(1).key, QString("b"));
+    EXPECT_EQ(items.at(2).key, QString("c"));
+}
+
+TEST_F(Tst_LayoutIndex, benchmark)
+{
+    const QMap<QString, QString> &latin = xkbLayouts();
+    if (latin.isEmpty())
+        return;
+
+    // 中文环境下布局名都是汉字,用常用字组合出同样数量的布局名
+    const QString han = QStringLiteral("汉英德法俄日韩蒙藏维语美国瑞士加拿大阿拉伯波斯土耳其希腊印度泰越南");
+    QMap<QString, QString> chinese;
+    int seed = 0;
+    for (auto it = latin.cbegin(); it != latin.cend(); ++it, ++seed) {
+        QString title;
+        for (int i = 0; i < 4; ++i)
+            title.append(han.at((seed * 7 + i * 13) % han.size()));
+        chinese.insert(it.key(), title + "(" + it.value() + ")");
+    }
+
+    QList<LayoutIndexItem> items;
+    QList<QString> letters;
+    QElapsedTimer timer;
+
+    timer.start();
+    obj->build(latin, false, items, letters);
+    const qint64 latinTime = timer.nsecsElapsed();
+    EXPECT_EQ(items.size(), latin.size());
+
+    timer.start();
+    obj->build(chinese, true, items, letters);
+    const qint64 chineseTime = timer.nsecsElapsed();
+    EXPECT_EQ(items.size(), chinese.size() + letters.size());
+
+    for (int i = 1; i < items.size(); ++i) {
+        if (!items.at(i).section && !items.at(i - 1).section)
+            EXPECT_LE(QString::compare(items.at(i - 1).pinyin, items.at(i).pinyin, Qt::CaseInsensitive), 0);
+    }
+
+    qInfo() << "layouts:" << latin.size()
+            << "collated(us):" << latinTime / 1000 << "grouped(us):" << chineseTime / 1000;
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include "modules/update/mirrorprober.h"
+
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QSignalSpy>
+#include <QTimer>
+
+using namespace dcc::update;
+
+// 本地的 HTTP 服务,模拟镜像源; delay 为响应前的等待时间, 小于 0 时不响应
+class Tst_MirrorProber : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new MirrorProber;
+        server = new QTcpServer;
+        ASSERT_TRUE(server->listen(QHostAddress::LocalHost));
+
+        QObject::connect(server, &QTcpServer::newConnection, server, [this] {
+            while (QTcpSocket *socket = server->nextPendingConnection()) {
+                ++connections;
+                maxActive = qMax(maxActive, ++active);
+                QObject::connect(socket, &QTcpSocket::disconnected, socket, [this, socket] {
+                    --active;
+                    socket->deleteLater();
+                });
+                QObject::connect(socket, &QTcpSocket::readyRead, socket, [this, socket] {
+                    socket->readAll();
+                    if (delay < 0)
+                        return;
+                    QTimer::singleShot(delay, socket, [socket] {
+                        socket->write("HTTP/1.1 200 OK\r\nContent-Length: 0\r\nConnection: close\r\n\r\n");
+                        socket->disconnectFromHost();
+                    });
+                });
+            }
+        });
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+        delete server;
+        server = nullptr;
+    }
+
+    QString url(const QString &path) const
+    {
+        return QString("http://127.0.0.1:%1/%2").arg(server->serverPort()).arg(path);
+    }
+
+    QMap<QString, int> probe(const QList<QPair<QString, QString>> &mirrors)
+    {
+        QMap<QString, int> result;
+        auto conn = QObject::connect(obj, &MirrorProber::resultReady, server, [&result](const QString &id, int latency) {
+            result.insert(id, latency);
+        });
+
+        QSignalSpy spy(obj, &MirrorProber::finished);
+        obj->probe(mirrors);
+        if (spy.isEmpty())
+            spy.wait(5000);
+
+        QObject::disconnect(conn);
+        return result;
+    }
+
+public:
+    MirrorProber *obj = nullptr;
+    QTcpServer *server = nullptr;
+    int delay = 0;
+    int connections = 0;
+    int active = 0;
+    int maxActive = 0;
+};
+
+TEST_F(Tst_MirrorProber, latency)
+{
+    // 找一个没有监听的端口
+    QTcpServer closed;
+    ASSERT_TRUE(closed.listen(QHostAddress::LocalHost));
+    const QString refused = QString("http://127.0.0.1:%1/").arg(closed.serverPort());
+    closed.close();
+
+    const QMap<QString, int> &result = probe({ { "a", url("a/") }, { "b", url("b/") }, { "c", refused } });
+
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_LT(result.value("a"), MirrorProber::TimeoutLatency);
+    EXPECT_LT(result.value("b"), MirrorProber::TimeoutLatency);
+    EXPECT_EQ(result.value("c"), MirrorProber::TimeoutLatency);
+}
+
+TEST_F(Tst_MirrorProber, concurrency)
+{
+    delay = 50;
+    obj->setMaxConcurrency(2);
+
+    QList<QPair<QString, QString>> mirrors;
+    for (int i = 0; i < 6; ++i)
+        mirrors << qMakePair(QString::number(i), url(QString::number(i)));
+
+    const QMap<QString, int> &result = probe(mirrors);
+
+    EXPECT_EQ(result.size(), 6);
+    EXPECT_EQ(connections, 6);
+    EXPECT_LE(maxActive, 2);
+}
+
+TEST_F(Tst_MirrorProber, timeout)
+{
+    delay = -1;
+    obj->setTimeout(200);
+
+    const QMap<QString, int> &result = probe({ { "a", url("a/") } });
+
+    ASSERT_EQ(result.size(), 1);
+    EXPECT_EQ(result.value("a"), MirrorProber::TimeoutLatency);
+}
+
+TEST_F(Tst_MirrorProber, cache)
+{
+    probe({ { "a", url("a/") } });
+    ASSERT_EQ(connections, 1);
+
+    // 有效期内直接使用缓存,不再发起请求
+    const QMap<QString, int> &cached = probe({ { "a", url("a/") } });
+    EXPECT_EQ(cached.size(), 1);
+    EXPECT_EQ(connections, 1);
+
+    obj->setCacheTtl(0);
+    probe({ { "a", url("a/") } });
+    EXPECT_EQ(connections, 2);
+}
+
+TEST_F(Tst_MirrorProber, failure)
+{
+    delay = -1;
+    obj->setTimeout(200);
+    EXPECT_EQ(probe({ { "a", url("a/") } }).value("a"), MirrorProber::TimeoutLatency);
+
+    // 失败的结果不缓存,镜像源恢复后重新测速可以得到正常结果
+    delay = 0;
+    const QMap<QString, int> &result = probe({ { "a", url("a/") } });
+    EXPECT_EQ(connections, 2);
+    EXPECT_LT(result.value("a"), MirrorProber::TimeoutLatency);
+}
+
+TEST_F(Tst_MirrorProber, cancel)
+{
+    delay = -1;
+
+    QSignalSpy resultSpy(obj, &MirrorProber::resultReady);
+    obj->probe({ { "a", url("a/") }, { "b", url("b/") } });
+    EXPECT_TRUE(obj->isRunning());
+
+    obj->cancel();
+    EXPECT_FALSE(obj->isRunning());
+
+    QSignalSpy finishedSpy(obj, &MirrorProber::finished);
+    finishedSpy.wait(300);
+    EXPECT_TRUE(resultSpy.isEmpty());
+    EXPECT_TRUE(finishedSpy.isEmpty());
+}
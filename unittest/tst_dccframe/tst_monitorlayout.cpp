@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+
+#include "modules/display/monitorlayout.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace dcc::display;
+
+class Tst_MonitorLayout : public testing::Test
+{
+public:
+    static quint32 random(quint32 &seed)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    // 随机大小的屏幕,位置分散在一片区域内,通常有重叠和不相连的屏幕
+    static QList<QRect> randomRects(int count, quint32 &seed)
+    {
+        QList<QRect> rects;
+        for (int i = 0; i < count; ++i) {
+            rects << QRect(static_cast<int>(random(seed) % 8000), static_cast<int>(random(seed) % 5000),
+                           static_cast<int>(1024 + random(seed) % 2816), static_cast<int>(768 + random(seed) % 1392));
+        }
+        return rects;
+    }
+
+    // 交易桌常见的多行多列排列
+    static QList<QRect> gridRects(int count, int columns)
+    {
+        QList<QRect> rects;
+        for (int i = 0; i < count; ++i)
+            rects << QRect(i % columns * 1920, i / columns * 1080, 1920, 1080);
+        return rects;
+    }
+};
+
+TEST_F(Tst_MonitorLayout, adjacent)
+{
+    const QRect r0(0, 0, 1920, 1080);
+
+    EXPECT_TRUE(MonitorLayout::isAdjacent(r0, QRect(1920, 500, 1280, 1024)));
+    EXPECT_TRUE(MonitorLayout::isAdjacent(r0, QRect(100, 1080, 1280, 1024)));
+    EXPECT_TRUE(MonitorLayout::isAdjacent(r0, r0));
+    // 只有角点相接时不相邻
+    EXPECT_FALSE(MonitorLayout::isAdjacent(r0, QRect(1920, 1080, 1280, 1024)));
+    EXPECT_FALSE(MonitorLayout::isAdjacent(r0, QRect(1921, 0, 1280, 1024)));
+
+    EXPECT_TRUE(MonitorLayout::isOverlapped(r0, QRect(1919, 0, 1280, 1024)));
+    EXPECT_FALSE(MonitorLayout::isOverlapped(r0, QRect(1920, 0, 1280, 1024)));
+    EXPECT_FALSE(MonitorLayout::isOverlapped(r0, r0));
+}
+
+TEST_F(Tst_MonitorLayout, perfect)
+{
+    EXPECT_TRUE(MonitorLayout(gridRects(6, 3)).isPerfect());
+    EXPECT_TRUE(MonitorLayout({ QRect(0, 0, 1920, 1080), QRect(0, 0, 1920, 1080) }).isPerfect());
+
+    MonitorLayout gap({ QRect(0, 0, 1920, 1080), QRect(1920, 0, 1920, 1080), QRect(3900, 0, 1920, 1080) });
+    EXPECT_FALSE(gap.hasOverlap());
+    EXPECT_FALSE(gap.isConnected());
+    EXPECT_FALSE(gap.isPerfect());
+
+    MonitorLayout overlap({ QRect(0, 0, 1920, 1080), QRect(1920, 0, 1920, 1080), QRect(3000, 1000, 1920, 1080) });
+    EXPECT_TRUE(overlap.hasOverlap());
+    EXPECT_FALSE(overlap.isPerfect());
+
+    const QVector<QVector<int>> &graph = MonitorLayout(gridRects(4, 2)).adjacency();
+    EXPECT_EQ(graph.at(0), QVector<int>({ 1, 2 }));
+    EXPECT_EQ(graph.at(3), QVector<int>({ 1, 2 }));
+}
+
+TEST_F(Tst_MonitorLayout, sweep)
+{
+    // 排序的边得到的结果与两两比较一致
+    quint32 seed = 3;
+    for (int n = 0; n < 300; ++n) {
+        const QList<QRect> &rects = randomRects(2 + n % 8, seed);
+        const MonitorLayout layout(rects);
+        const QVector<QVector<int>> &graph = layout.adjacency();
+
+        bool overlapped = false;
+        for (int i = 0; i < rects.size(); ++i) {
+            for (int j = 0; j < rects.size(); ++j) {
+                if (i == j)
+                    continue;
+                ASSERT_EQ(graph.at(i).contains(j), MonitorLayout::isAdjacent(rects.at(i), rects.at(j)));
+                overlapped |= MonitorLayout::isOverlapped(rects.at(i), rects.at(j));
+            }
+        }
+        ASSERT_EQ(layout.hasOverlap(), overlapped);
+    }
+}
+
+TEST_F(Tst_MonitorLayout, snap)
+{
+    MonitorLayout layout(gridRects(3, 3));
+    layout.setSnapDistance(64);
+
+    bool ok = false;
+    // 拖到左边屏幕的下方,左边与它对齐
+    EXPECT_EQ(layout.snap(2, QPoint(30, 1200), &ok), QPoint(0, 1080));
+    EXPECT_TRUE(ok);
+
+    // 超过对齐距离时保持拖动的位置
+    EXPECT_EQ(layout.snap(2, QPoint(300, 1200), &ok), QPoint(300, 1080));
+    EXPECT_TRUE(ok);
+
+    // 拖走中间的屏幕时吸附回两侧屏幕之间
+    EXPECT_EQ(layout.snap(1, QPoint(1920, 3000), &ok).x(), 1920);
+    EXPECT_TRUE(ok);
+
+    // 拖到左边屏幕的右边时不能与中间的屏幕重合,而是贴到中间屏幕的下方
+    layout.setRects(gridRects(3, 3));
+    EXPECT_EQ(layout.snap(2, QPoint(1900, 10), &ok), QPoint(1920, 1080));
+    EXPECT_TRUE(ok);
+
+    // 小屏幕无法同时贴合距离很远的两个屏幕
+    layout.setRects({ QRect(0, 0, 1920, 1080), QRect(0, 0, 800, 600), QRect(5000, 0, 1920, 1080) });
+    layout.snap(1, QPoint(2500, 0), &ok);
+    EXPECT_FALSE(ok);
+}
+
+TEST_F(Tst_MonitorLayout, arranged)
+{
+    quint32 seed = 5;
+    for (int n = 0; n < 200; ++n) {
+        const QList<QRect> &rects = randomRects(2 + n % 6, seed);
+        const QList<QRect> &arranged = MonitorLayout(rects).arranged();
+
+        ASSERT_EQ(arranged.size(), rects.size());
+        EXPECT_TRUE(MonitorLayout(arranged).isPerfect());
+        for (int i = 0; i < rects.size(); ++i)
+            EXPECT_EQ(arranged.at(i).size(), rects.at(i).size());
+
+        // 任意一个屏幕拖动后的位置仍然是完整的布局
+        QList<QRect> moved = arranged;
+        const int index = static_cast<int>(random(seed) % moved.size());
+        bool ok = false;
+        const QPoint &pos = MonitorLayout(arranged).snap(index, QPoint(static_cast<int>(random(seed) % 8000), static_cast<int>(random(seed) % 5000)), &ok);
+        if (ok) {
+            moved[index].moveTopLeft(pos);
+            EXPECT_TRUE(MonitorLayout(moved).isPerfect());
+        }
+    }
+
+    // 扩展模式下位置相同的屏幕被移开
+    const QList<QRect> &stacked = MonitorLayout({ QRect(0, 0, 1920, 1080), QRect(0, 0, 1920, 1080) }).arranged();
+    EXPECT_NE(stacked.first(), stacked.last());
+    EXPECT_TRUE(MonitorLayout::isAdjacent(stacked.first(), stacked.last()));
+
+    // 已经完整的布局不变
+    EXPECT_EQ(MonitorLayout(gridRects(6, 3)).arranged(), gridRects(6, 3));
+
+    const QList<QRect> &normalized = MonitorLayout::normalized({ QRect(-1920, 100, 1920, 1080), QRect(0, 200, 1920, 1080) });
+    EXPECT_EQ(normalized.first(), QRect(0, 0, 1920, 1080));
+    EXPECT_EQ(normalized.last(), QRect(1920, 100, 1920, 1080));
+}
+
+TEST_F(Tst_MonitorLayout, benchmark)
+{
+    for (int count : { 2, 4, 6, 16 }) {
+        const QList<QRect> &grid = gridRects(count, count < 6 ? 2 : 3);
+        quint32 seed = static_cast<quint32>(count);
+        QList<QList<QRect>> layouts;
+        for (int i = 0; i < 200; ++i)
+            layouts << randomRects(count, seed);
+
+        QElapsedTimer timer;
+
+        // 拖动时每次松开都要检查并吸附
+        timer.start();
+        for (int i = 0; i < 200; ++i) {
+            MonitorLayout layout(grid);
+            layout.snap(i % count, QPoint(static_cast<int>(random(seed) % 8000), static_cast<int>(random(seed) % 5000)));
+            layout.isPerfect();
+        }
+        const qint64 snapTime = timer.nsecsElapsed();
+
+        timer.start();
+        int perfect = 0;
+        for (const QList<QRect> &rects : layouts)
+            perfect += MonitorLayout(MonitorLayout(rects).arranged()).isPerfect() ? 1 : 0;
+        const qint64 arrangeTime = timer.nsecsElapsed();
+        EXPECT_EQ(perfect, layouts.size());
+
+        qInfo() << "screens:" << count
+                << "snap x200(us):" << snapTime / 1000 << "arrange x200(us):" << arrangeTime / 1000;
+    }
+}
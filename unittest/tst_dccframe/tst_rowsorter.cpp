@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include "window/modules/network/rowsorter.h"
+
+#include <QStandardItemModel>
+#include <QPersistentModelIndex>
+
+using namespace DCC_NAMESPACE::network;
+
+// 与无线网络列表一样按信号强度从大到小排序, 强度存放在 UserRole 中
+class Tst_RowSorter : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        model = new QStandardItemModel;
+    }
+
+    void TearDown() override
+    {
+        delete model;
+        model = nullptr;
+    }
+
+    void setStrengths(const QList<int> &strengths)
+    {
+        model->clear();
+        for (int i = 0; i < strengths.size(); ++i) {
+            QStandardItem *item = new QStandardItem(QString("ap%1").arg(i));
+            item->setData(strengths.at(i), Qt::UserRole);
+            model->appendRow(item);
+        }
+    }
+
+    static bool byStrength(const QStandardItem *a, const QStandardItem *b)
+    {
+        return a->data(Qt::UserRole).toInt() > b->data(Qt::UserRole).toInt();
+    }
+
+    QStringList names() const
+    {
+        QStringList list;
+        for (int i = 0; i < model->rowCount(); ++i)
+            list << model->item(i)->text();
+        return list;
+    }
+
+public:
+    QStandardItemModel *model = nullptr;
+};
+
+TEST_F(Tst_RowSorter, longestIncreasing)
+{
+    EXPECT_EQ(longestIncreasing({}), QVector<bool>());
+    EXPECT_EQ(longestIncreasing({ 0, 1, 2, 3 }), QVector<bool>({ true, true, true, true }));
+    EXPECT_EQ(longestIncreasing({ 3, 0, 1, 2 }), QVector<bool>({ false, true, true, true }));
+    EXPECT_EQ(longestIncreasing({ 1, 2, 3, 0 }), QVector<bool>({ true, true, true, false }));
+
+    // 结果一定是递增的, 并且长度最长
+    const QVector<int> seq { 4, 1, 7, 2, 8, 3, 0, 6, 5, 9 };
+    const QVector<bool> &keep = longestIncreasing(seq);
+    int last = -1;
+    int length = 0;
+    for (int i = 0; i < seq.size(); ++i) {
+        if (!keep.at(i))
+            continue;
+        EXPECT_GT(seq.at(i), last);
+        last = seq.at(i);
+        ++length;
+    }
+    EXPECT_EQ(length, 5);
+}
+
+TEST_F(Tst_RowSorter, sorted)
+{
+    // 已经有序时不移动任何行
+    setStrengths({ 90, 70, 50, 30 });
+    EXPECT_EQ(sortRows(model, &Tst_RowSorter::byStrength), 0);
+    EXPECT_EQ(names(), QStringList({ "ap0", "ap1", "ap2", "ap3" }));
+}
+
+TEST_F(Tst_RowSorter, ties)
+{
+    // 强度相同时保持原来的顺序
+    setStrengths({ 50, 80, 50, 50, 80 });
+    EXPECT_EQ(sortRows(model, &Tst_RowSorter::byStrength), 2);
+    EXPECT_EQ(names(), QStringList({ "ap1", "ap4", "ap0", "ap2", "ap3" }));
+
+    EXPECT_EQ(sortRows(model, &Tst_RowSorter::byStrength), 0);
+}
+
+TEST_F(Tst_RowSorter, moved)
+{
+    // 一个网络信号变强, 只移动这一行
+    setStrengths({ 90, 70, 50, 30, 10 });
+    model->item(3)->setData(95, Qt::UserRole);
+
+    QList<QPair<QString, int>> moves;
+    EXPECT_EQ(sortRows(model, &Tst_RowSorter::byStrength, [&moves](QStandardItem *item, int row) {
+        moves << qMakePair(item->text(), row);
+    }), 1);
+
+    EXPECT_EQ(names(), QStringList({ "ap3", "ap0", "ap1", "ap2", "ap4" }));
+    ASSERT_EQ(moves.size(), 1);
+    EXPECT_EQ(moves.first(), qMakePair(QString("ap3"), 0));
+}
+
+TEST_F(Tst_RowSorter, hidden)
+{
+    // 视图按行记录隐藏状态, 行被取出后状态丢失, 与 QListView 的行为一致
+    setStrengths({ 90, 70, 50, 30, 10 });
+    QSet<QStandardItem *> hiddenItems { model->item(1), model->item(3) };
+    QList<QPersistentModelIndex> hiddenRows { model->index(1, 0), model->index(3, 0) };
+
+    model->item(3)->setData(95, Qt::UserRole);
+    model->item(0)->setData(5, Qt::UserRole);
+
+    sortRows(model, &Tst_RowSorter::byStrength, [&](QStandardItem *item, int row) {
+        if (hiddenItems.contains(item))
+            hiddenRows << model->index(row, 0);
+    });
+    EXPECT_EQ(names(), QStringList({ "ap3", "ap1", "ap2", "ap4", "ap0" }));
+
+    QSet<int> rows;
+    for (const QPersistentModelIndex &index : hiddenRows) {
+        if (index.isValid())
+            rows.insert(index.row());
+    }
+
+    QSet<int> expected;
+    for (QStandardItem *item : hiddenItems)
+        expected.insert(item->row());
+
+    EXPECT_EQ(rows, expected);
+    EXPECT_EQ(rows, QSet<int>({ 0, 1 }));
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "window/search/searchengine.h"
+#include "window/search/searchindex.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace DCC_NAMESPACE::search;
+
+class Tst_SearchEngine : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        obj = new SearchEngine;
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+    int add(const QString &title, const QString &module)
+    {
+        return obj->addEntry(SearchEngine::buildKeys(title, QString("%1 --> %2").arg(module).arg(title)));
+    }
+
+public:
+    SearchEngine *obj = nullptr;
+};
+
+TEST_F(Tst_SearchEngine, rank)
+{
+    const int brightness = add("Brightness", "Display");
+    const int autoBrightness = add("Auto Brightness", "Display");
+    const int nightShift = add("Night Shift", "Display");
+    const int bright = add("Bright", "Display");
+
+    const QVector<int> &result = obj->search("bright");
+    ASSERT_EQ(result.size(), 3);
+    EXPECT_EQ(result.at(0), bright);
+    EXPECT_EQ(result.at(1), brightness);
+    EXPECT_EQ(result.at(2), autoBrightness);
+    EXPECT_FALSE(result.contains(nightShift));
+
+    EXPECT_EQ(obj->match(brightness, "BRIGHTNESS"), SearchEngine::ExactMatch);
+    EXPECT_EQ(obj->match(autoBrightness, "bright"), SearchEngine::WordPrefixMatch);
+    EXPECT_EQ(obj->match(nightShift, "ns"), SearchEngine::InitialsMatch);
+    EXPECT_EQ(obj->match(nightShift, "ngtsft"), SearchEngine::FuzzyMatch);
+    EXPECT_EQ(obj->match(nightShift, "xyz"), SearchEngine::NoMatch);
+    EXPECT_TRUE(obj->search("").isEmpty());
+}
+
+TEST_F(Tst_SearchEngine, pinyin)
+{
+    const int id = add("亮度", "显示");
+
+    EXPECT_EQ(obj->match(id, "亮度"), SearchEngine::ExactMatch);
+    EXPECT_EQ(obj->match(id, "liangdu"), SearchEngine::PinyinMatch);
+    EXPECT_EQ(obj->match(id, "ld"), SearchEngine::InitialsMatch);
+    EXPECT_TRUE(obj->search("xianshi").contains(id));
+}
+
+// 按用户逐字输入的方式回放每一条数据的文言,统计每次按键的搜索耗时
+TEST_F(Tst_SearchEngine, replayTypedQueriesBenchmark)
+{
+    const QStringList tsFiles = {
+        DCC_TRANSLATIONS_DIR "/dde-control-center_zh_CN.ts",
+        DCC_TRANSLATIONS_DIR "/dde-control-center_en_US.ts",
+    };
+
+    QStringList titles;
+    for (const QString &ts : tsFiles) {
+        QList<SearchIndexEntry> entries;
+        if (!SearchIndex::parseTs(ts, entries))
+            continue;
+
+        // 重复加入数据,模拟安装了大量插件时的数据量
+        for (int copy = 0; copy < 10; ++copy) {
+            for (const SearchIndexEntry &entry : entries) {
+                const QString &module = entry.fullPagePath.section('/', 1, 1);
+                add(entry.translateContent, module + QString::number(copy));
+                if (copy == 0)
+                    titles << entry.translateContent;
+            }
+        }
+    }
+
+    if (titles.isEmpty())
+        return;
+
+    qint64 total = 0;
+    qint64 worst = 0;
+    int keystrokes = 0;
+    QElapsedTimer timer;
+    for (const QString &title : titles) {
+        for (int i = 1; i <= title.size(); ++i) {
+            timer.start();
+            const QVector<int> &result = obj->search(title.left(i));
+            const qint64 elapsed = timer.nsecsElapsed();
+            total += elapsed;
+            worst = qMax(worst, elapsed);
+            ++keystrokes;
+            if (i == title.size())
+                EXPECT_FALSE(result.isEmpty());
+        }
+    }
+
+    qInfo() << "entries:" << obj->count() << "keystrokes:" << keystrokes
+            << "avg(us):" << total / keystrokes / 1000 << "worst(us):" << worst / 1000;
+}
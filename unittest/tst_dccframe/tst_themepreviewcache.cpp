@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "window/modules/personalization/themepreviewcache.h"
+#include "window/modules/personalization/themeitempic.h"
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QPainter>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <tuple>
+
+using namespace DCC_NAMESPACE::personalization;
+
+class Tst_ThemePreviewCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        path = dir.filePath("preview.svg");
+
+        QFile file(path);
+        ASSERT_TRUE(file.open(QFile::WriteOnly));
+        file.write(R"(<svg xmlns="http://www.w3.org/2000/svg" width="170" height="100">
+            <rect width="170" height="100" fill="#2ca7f8"/>
+            <circle cx="85" cy="50" r="40" fill="#ffffff"/>
+        </svg>)");
+    }
+
+public:
+    QTemporaryDir dir;
+    QString path;
+};
+
+TEST_F(Tst_ThemePreviewCache, compose)
+{
+    QImage source(QSize(40, 20), QImage::Format_ARGB32_Premultiplied);
+    source.fill(Qt::red);
+
+    const QImage &img = ThemePreviewCache::compose(source, QSize(40, 20), 1, Qt::white, 8);
+
+    // 四周各留出 1 像素的边框
+    EXPECT_EQ(img.size(), QSize(42, 22));
+    EXPECT_EQ(img.pixelColor(21, 11), QColor(Qt::red));
+    // 圆角以外使用背景色填充
+    EXPECT_EQ(img.pixelColor(1, 1), QColor(Qt::white));
+}
+
+TEST_F(Tst_ThemePreviewCache, key)
+{
+    const QString &k = ThemePreviewCache::key(path, QSize(170, 100), 1, Qt::white, 8);
+
+    EXPECT_EQ(k, ThemePreviewCache::key(path, QSize(170, 100), 1, Qt::white, 8));
+    EXPECT_NE(k, ThemePreviewCache::key(path, QSize(170, 100), 2, Qt::white, 8));
+    EXPECT_NE(k, ThemePreviewCache::key(path, QSize(170, 100), 1, Qt::black, 8));
+}
+
+TEST_F(Tst_ThemePreviewCache, cache)
+{
+    const QSize size(170, 100);
+    if (ThemePreviewCache::rasterize(path, size, 1, Qt::white, 8).isNull())
+        GTEST_SKIP() << "svg rasterization is unavailable";
+
+    ThemePreviewCache *cache = ThemePreviewCache::instance();
+    QSignalSpy spy(cache, &ThemePreviewCache::previewReady);
+    const int count = ThemePreviewCache::rasterizeCount();
+
+    // 第一次请求在后台生成,生成过程中再次请求不会重复栅格化
+    EXPECT_TRUE(cache->preview(path, size, 1, Qt::white, 8).isNull());
+    EXPECT_TRUE(cache->preview(path, size, 1, Qt::white, 8).isNull());
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(spy.takeFirst().at(0).toString(), path);
+    EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 1);
+
+    // 生成后直接命中缓存
+    const QPixmap &pixmap = cache->preview(path, size, 1, Qt::white, 8);
+    ASSERT_FALSE(pixmap.isNull());
+    EXPECT_EQ(pixmap.size(), QSize(172, 102));
+    EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 1);
+
+    // 尺寸、缩放比例或调色板变化时重新生成
+    const QVector<std::tuple<QSize, qreal, QColor>> changes {
+        std::make_tuple(QSize(85, 50), 1.0, QColor(Qt::white)),
+        std::make_tuple(size, 2.0, QColor(Qt::white)),
+        std::make_tuple(size, 1.0, QColor(Qt::black)),
+    };
+    for (int i = 0; i < changes.size(); ++i) {
+        const QSize &s = std::get<0>(changes.at(i));
+        const qreal ratio = std::get<1>(changes.at(i));
+        const QColor &base = std::get<2>(changes.at(i));
+        EXPECT_NE(ThemePreviewCache::key(path, s, ratio, base, 8), ThemePreviewCache::key(path, size, 1, Qt::white, 8));
+
+        EXPECT_TRUE(cache->preview(path, s, ratio, base, 8).isNull());
+        ASSERT_TRUE(spy.wait(5000));
+        spy.clear();
+        EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 2 + i);
+
+        const QPixmap &changed = cache->preview(path, s, ratio, base, 8);
+        ASSERT_FALSE(changed.isNull());
+        EXPECT_EQ(changed.size(), QSize(s.width() + 2, s.height() + 2) * ratio);
+    }
+    EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 1 + changes.size());
+}
+
+TEST_F(Tst_ThemePreviewCache, benchmark)
+{
+    if (ThemePreviewCache::rasterize(path, QSize(170, 100), 1, Qt::white, 8).isNull())
+        GTEST_SKIP() << "svg rasterization is unavailable";
+
+    // 主题页面一屏大约显示 12 个预览图, 模拟滚动时连续重绘 60 帧
+    const int items = 12;
+    const int frames = 60;
+    QWidget owner;
+    QList<ThemeItemPic *> pics;
+    for (int i = 0; i < items; ++i) {
+        ThemeItemPic *pic = new ThemeItemPic(&owner);
+        pic->setPath(path);
+        pics << pic;
+    }
+    const QSize itemSize = pics.first()->size();
+    const qreal ratio = pics.first()->devicePixelRatioF();
+
+    auto paint = [&](QImage &frame) {
+        frame = QImage(QSize(itemSize.width() * 4, itemSize.height() * 3) * ratio, QImage::Format_ARGB32_Premultiplied);
+        frame.setDevicePixelRatio(ratio);
+        frame.fill(Qt::transparent);
+
+        QPainter painter(&frame);
+        for (int i = 0; i < items; ++i)
+            pics.at(i)->render(&painter, QPoint((i % 4) * itemSize.width(), (i / 4) * itemSize.height()));
+    };
+
+    // 预览图左侧中间的像素,应为 svg 的背景色
+    const QPoint probe = QPoint(itemSize.width() / 2 - 70, itemSize.height() / 2) * ratio;
+
+    // 第一帧没有缓存,所有控件共用一次后台栅格化
+    QSignalSpy spy(ThemePreviewCache::instance(), &ThemePreviewCache::previewReady);
+    const int count = ThemePreviewCache::rasterizeCount();
+    QImage frame;
+    paint(frame);
+    EXPECT_NE(frame.pixelColor(probe), QColor("#2ca7f8"));
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 1);
+
+    qint64 worst = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int f = 0; f < frames; ++f) {
+        QElapsedTimer frameTimer;
+        frameTimer.start();
+        paint(frame);
+        worst = qMax(worst, frameTimer.nsecsElapsed());
+    }
+    const qint64 total = timer.nsecsElapsed();
+
+    // 后续的帧只贴图,不再栅格化
+    EXPECT_EQ(ThemePreviewCache::rasterizeCount(), count + 1);
+    EXPECT_EQ(frame.pixelColor(probe), QColor("#2ca7f8"));
+    qInfo() << "frames:" << frames << "items:" << items << "ratio:" << ratio
+            << "avg(us):" << total / frames / 1000 << "worst(us):" << worst / 1000;
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "window/modules/personalization/thumbnailloader.h"
+
+#include <QTemporaryDir>
+#include <QSignalSpy>
+#include <QDir>
+
+using namespace DCC_NAMESPACE::personalization;
+
+class Tst_ThumbnailLoader : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        ASSERT_TRUE(dir.isValid());
+        cacheDir = dir.filePath("cache");
+        obj = new ThumbnailLoader(cacheDir);
+
+        QImage img(QSize(400, 200), QImage::Format_RGB32);
+        img.fill(Qt::blue);
+        path = dir.filePath("thumbnail.png");
+        ASSERT_TRUE(img.save(path));
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+    }
+
+    int cacheCount() const
+    {
+        return QDir(cacheDir).entryList(QDir::Files).size();
+    }
+
+public:
+    QTemporaryDir dir;
+    QString cacheDir;
+    QString path;
+    ThumbnailLoader *obj = nullptr;
+};
+
+TEST_F(Tst_ThumbnailLoader, decode)
+{
+    // 不超过最大尺寸时直接读取原图, 不写缓存
+    EXPECT_EQ(ThumbnailLoader::decode(path, QSize(), cacheDir).size(), QSize(400, 200));
+    EXPECT_EQ(ThumbnailLoader::decode(path, QSize(800, 800), cacheDir).size(), QSize(400, 200));
+    EXPECT_EQ(cacheCount(), 0);
+
+    EXPECT_EQ(ThumbnailLoader::decode(path, QSize(200, 1000), cacheDir).size(), QSize(200, 100));
+    EXPECT_EQ(cacheCount(), 1);
+
+    // 第二次读取缓存中缩小后的图片
+    EXPECT_EQ(ThumbnailLoader::decode(path, QSize(200, 1000), cacheDir).size(), QSize(200, 100));
+    EXPECT_EQ(cacheCount(), 1);
+
+    EXPECT_TRUE(ThumbnailLoader::decode(dir.filePath("missing.png"), QSize(200, 1000), cacheDir).isNull());
+}
+
+TEST_F(Tst_ThumbnailLoader, load)
+{
+    QSignalSpy spy(obj, &ThumbnailLoader::thumbnailReady);
+    obj->load("a", path, QSize(100, 1000));
+    // 只保留同一个 id 最后一次的结果
+    obj->load("b", path);
+    obj->load("b", path, QSize(200, 1000));
+
+    while (spy.size() < 2 && spy.wait(3000)) { }
+    spy.wait(100);
+
+    ASSERT_EQ(spy.size(), 2);
+    QMap<QString, QSize> result;
+    for (const QList<QVariant> &args : spy)
+        result.insert(args.at(0).toString(), args.at(1).value<QImage>().size());
+    EXPECT_EQ(result.value("a"), QSize(100, 50));
+    EXPECT_EQ(result.value("b"), QSize(200, 100));
+}
+
+TEST_F(Tst_ThumbnailLoader, cancel)
+{
+    QSignalSpy spy(obj, &ThumbnailLoader::thumbnailReady);
+    obj->load("a", path);
+    obj->cancel("a");
+
+    spy.wait(300);
+    EXPECT_TRUE(spy.isEmpty());
+}
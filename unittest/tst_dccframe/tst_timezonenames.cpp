@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "modules/datetime/timezone_dialog/timezone.h"
+
+#include <QTimeZone>
+#include <QtConcurrent>
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace installer;
+
+TEST(Tst_TimezoneNames, name)
+{
+    // 没有翻译时使用去掉大洲的时区名
+    EXPECT_EQ(GetLocalTimezoneName("Asia/Shanghai", "en_US"), QString("Shanghai"));
+    EXPECT_EQ(GetLocalTimezoneName("America/Argentina/Buenos_Aires", "en_US"), QString("Buenos_Aires"));
+    EXPECT_EQ(GetLocalTimezoneName("UTC", "en_US"), QString("UTC"));
+
+    // 不在时区列表中的名字也可以翻译
+    EXPECT_EQ(GetLocalTimezoneName("Nowhere/Somewhere", "en_US"), QString("Somewhere"));
+}
+
+TEST(Tst_TimezoneNames, catalogue)
+{
+    const TimezoneNameMap &names = GetLocalTimezoneNames("en_US");
+    EXPECT_EQ(names.size(), QTimeZone::availableTimeZoneIds().size());
+
+    // 不存在的语言环境不影响生成
+    EXPECT_EQ(GetLocalTimezoneNames("xx_XX").value("Europe/Berlin"), QString("Berlin"));
+}
+
+TEST(Tst_TimezoneNames, concurrent)
+{
+    // 多个线程同时读取时得到相同的结果
+    QList<QFuture<TimezoneNameMap>> futures;
+    for (int i = 0; i < 4; ++i)
+        futures << QtConcurrent::run(GetLocalTimezoneNames, QString("zh_CN"));
+
+    const TimezoneNameMap &names = GetLocalTimezoneNames("zh_CN");
+    for (QFuture<TimezoneNameMap> &future : futures)
+        EXPECT_EQ(future.result(), names);
+}
+
+TEST(Tst_TimezoneNames, benchmark)
+{
+    const QList<QByteArray> &ids = QTimeZone::availableTimeZoneIds();
+    QElapsedTimer timer;
+
+    // 第一次需要翻译全部时区
+    timer.start();
+    GetLocalTimezoneNames("de_DE");
+    const qint64 buildTime = timer.nsecsElapsed();
+
+    // 之后的查询都是查表,与时区选择框生成补全列表的调用方式一致
+    timer.start();
+    int count = 0;
+    for (const QByteArray &id : ids)
+        count += GetLocalTimezoneName(QString::fromLatin1(id), "de_DE").isEmpty() ? 0 : 1;
+    const qint64 lookupTime = timer.nsecsElapsed();
+    EXPECT_EQ(count, ids.size());
+
+    qInfo() << "timezones:" << ids.size()
+            << "build(us):" << buildTime / 1000 << "lookup(us):" << lookupTime / 1000;
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include "modules/accounts/userpropertyloader.h"
+
+#include <QDBusConnection>
+#include <QSignalSpy>
+
+using namespace dcc::accounts;
+
+namespace {
+const QString TestInterface = QStringLiteral("com.deepin.dcc.test.User");
+
+// 模拟 Accounts 服务中的用户对象
+class TestUser : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "com.deepin.dcc.test.User")
+    Q_PROPERTY(QString UserName READ userName)
+    Q_PROPERTY(int AccountType READ accountType)
+
+public:
+    explicit TestUser(const QString &name, QObject *parent = nullptr)
+        : QObject(parent)
+        , m_name(name)
+    {
+    }
+
+    QString userName() const { return m_name; }
+    int accountType() const { return 1; }
+
+private:
+    QString m_name;
+};
+}
+
+class Tst_UserPropertyLoader : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        bus = new QDBusConnection(QDBusConnection::sessionBus());
+        if (!bus->isConnected())
+            return;
+
+        for (int i = 0; i < UserCount; ++i) {
+            TestUser *user = new TestUser(QString("user%1").arg(i));
+            users << user;
+            bus->registerObject(path(i), user, QDBusConnection::ExportAllProperties);
+        }
+
+        obj = new UserPropertyLoader(bus->baseService(), TestInterface, *bus);
+    }
+
+    void TearDown() override
+    {
+        delete obj;
+        obj = nullptr;
+        for (int i = 0; i < users.size(); ++i)
+            bus->unregisterObject(path(i));
+        qDeleteAll(users);
+        users.clear();
+        delete bus;
+        bus = nullptr;
+    }
+
+    static QString path(int i)
+    {
+        return QString("/com/deepin/dcc/test/User%1").arg(i);
+    }
+
+    // 等待所有请求返回, 返回收到的批次
+    QList<QList<QPair<QString, QVariantMap>>> wait(int count)
+    {
+        QList<QList<QPair<QString, QVariantMap>>> batches;
+        int received = 0;
+        auto conn = QObject::connect(obj, &UserPropertyLoader::loaded, [&](const QList<QPair<QString, QVariantMap>> &users) {
+            batches << users;
+            received += users.size();
+        });
+
+        QSignalSpy spy(obj, &UserPropertyLoader::loaded);
+        while (received < count && spy.wait(3000)) {
+        }
+
+        QObject::disconnect(conn);
+        return batches;
+    }
+
+public:
+    static const int UserCount = 40;
+    QDBusConnection *bus = nullptr;
+    QList<TestUser *> users;
+    UserPropertyLoader *obj = nullptr;
+};
+
+TEST_F(Tst_UserPropertyLoader, load)
+{
+    if (!obj) {
+        qInfo() << "session bus is not available, skip";
+        return;
+    }
+
+    obj->setMaxPending(4);
+
+    QStringList paths;
+    for (int i = 0; i < UserCount; ++i)
+        paths << path(i);
+    // 重复的路径只请求一次
+    obj->load(paths);
+    obj->load(paths.mid(0, 10));
+    EXPECT_TRUE(obj->isLoading(path(0)));
+
+    QMap<QString, QVariantMap> result;
+    for (const auto &batch : wait(UserCount)) {
+        for (const auto &user : batch)
+            result.insert(user.first, user.second);
+    }
+
+    ASSERT_EQ(result.size(), UserCount);
+    EXPECT_EQ(result.value(path(7)).value("UserName").toString(), QString("user7"));
+    EXPECT_EQ(result.value(path(7)).value("AccountType").toInt(), 1);
+    EXPECT_FALSE(obj->isLoading(path(0)));
+}
+
+TEST_F(Tst_UserPropertyLoader, missing)
+{
+    if (!obj) {
+        qInfo() << "session bus is not available, skip";
+        return;
+    }
+
+    // 不存在的用户不出现在结果中
+    obj->load({ path(0), "/com/deepin/dcc/test/Missing" });
+
+    QStringList loaded;
+    for (const auto &batch : wait(1)) {
+        for (const auto &user : batch)
+            loaded << user.first;
+    }
+
+    EXPECT_EQ(loaded, QStringList { path(0) });
+}
+
+TEST_F(Tst_UserPropertyLoader, cancel)
+{
+    if (!obj) {
+        qInfo() << "session bus is not available, skip";
+        return;
+    }
+
+    obj->setMaxPending(2);
+
+    // 第一个请求已经发出, 最后一个还在队列中, 删除后都不出现在结果中
+    obj->load({ path(0), path(1), path(2), path(3) });
+    obj->cancel(path(0));
+    obj->cancel(path(3));
+    EXPECT_FALSE(obj->isLoading(path(0)));
+    EXPECT_FALSE(obj->isLoading(path(3)));
+
+    QStringList loaded;
+    for (const auto &batch : wait(2)) {
+        for (const auto &user : batch)
+            loaded << user.first;
+    }
+    loaded.sort();
+
+    EXPECT_EQ(loaded, QStringList({ path(1), path(2) }));
+
+    // 取消后可以重新获取
+    obj->load({ path(0) });
+    const auto &batches = wait(1);
+    ASSERT_FALSE(batches.isEmpty());
+    EXPECT_EQ(batches.first().first().first, path(0));
+}
+
+#include "tst_userpropertyloader.moc"
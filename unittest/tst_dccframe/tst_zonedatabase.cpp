@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "modules/datetime/timezone_dialog/timezone.h"
+
+using namespace installer;
+
+TEST(Tst_ZoneDatabase, shared)
+{
+    const ZoneDatabasePtr &database = GetZoneDatabase();
+    ASSERT_FALSE(database.isNull());
+
+    // tzdata 没有修改时不重新读取
+    EXPECT_EQ(GetZoneDatabase(), database);
+    EXPECT_EQ(GetZoneInfoList().size(), database->zones.size());
+}
+
+TEST(Tst_ZoneDatabase, indexes)
+{
+    const ZoneDatabasePtr &database = GetZoneDatabase();
+    if (database->zones.isEmpty())
+        return;
+
+    EXPECT_EQ(database->zone_indexes.size(), database->zones.size());
+    for (const ZoneInfo &zone : database->zones) {
+        EXPECT_EQ(database->zone_indexes.value(zone.timezone), GetZoneInfoByZone(database->zones, zone.timezone));
+        EXPECT_EQ(database->country_indexes.value(zone.country), GetZoneInfoByCountry(database->zones, zone.country));
+    }
+
+    EXPECT_EQ(database->zone_indexes.value("Nowhere/Somewhere", -1), -1);
+}
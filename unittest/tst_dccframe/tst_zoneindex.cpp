@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "modules/datetime/timezone_dialog/timezone_map_util.h"
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+using namespace installer;
+
+// 与 zone.tab 规模相同的随机时区,不依赖系统的时区数据
+class Tst_ZoneIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        quint32 seed = 1;
+        for (int i = 0; i < ZoneCount; ++i) {
+            ZoneInfo zone;
+            zone.country = QString::number(i % 250);
+            zone.timezone = QString("Zone/%1").arg(i);
+            zone.latitude = random(seed) % 14000 / 100.0 - 59;
+            zone.longitude = random(seed) % 36000 / 100.0 - 180;
+            zone.distance = 0;
+            zones << zone;
+        }
+    }
+
+    static quint32 random(quint32 &seed)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return seed >> 8;
+    }
+
+    static QStringList names(const ZoneInfoList &zones)
+    {
+        QStringList list;
+        for (const ZoneInfo &zone : zones)
+            list << zone.timezone;
+        return list;
+    }
+
+public:
+    static const int ZoneCount = 420;
+    static const int MapWidth = 760;
+    static const int MapHeight = 375;
+    ZoneInfoList zones;
+};
+
+TEST_F(Tst_ZoneIndex, nearest)
+{
+    ZoneIndex index(zones);
+    index.resize(MapWidth, MapHeight);
+
+    // 点击位置和暴力查找的结果完全一致,包括顺序
+    quint32 seed = 7;
+    for (int i = 0; i < 2000; ++i) {
+        const int x = random(seed) % (MapWidth + 40) - 20;
+        const int y = random(seed) % (MapHeight + 40) - 20;
+        ASSERT_EQ(names(index.nearestZones(64.0, x, y)),
+                  names(GetNearestZones(zones, 64.0, x, y, MapWidth, MapHeight)));
+    }
+}
+
+TEST_F(Tst_ZoneIndex, resize)
+{
+    ZoneIndex index(zones);
+    index.resize(MapWidth, MapHeight);
+    index.resize(MapWidth / 2, MapHeight / 2);
+
+    const QPointF &pos = index.position(0);
+    EXPECT_DOUBLE_EQ(pos.x(), ConvertLongitudeToX(zones.first().longitude) * (MapWidth / 2));
+    EXPECT_DOUBLE_EQ(pos.y(), ConvertLatitudeToY(zones.first().latitude) * (MapHeight / 2));
+
+    // 以时区所在位置查找时一定能找到它
+    EXPECT_TRUE(names(index.nearestZones(64.0, qRound(pos.x()), qRound(pos.y()))).contains(zones.first().timezone));
+}
+
+TEST_F(Tst_ZoneIndex, empty)
+{
+    ZoneIndex index({});
+    index.resize(MapWidth, MapHeight);
+
+    EXPECT_EQ(index.nearestZone(10, 10), -1);
+    EXPECT_TRUE(index.nearestZones(64.0, 10, 10).isEmpty());
+}
+
+TEST_F(Tst_ZoneIndex, benchmark)
+{
+    QVector<QPoint> points;
+    quint32 seed = 11;
+    for (int i = 0; i < 20000; ++i)
+        points << QPoint(random(seed) % MapWidth, random(seed) % MapHeight);
+
+    QElapsedTimer timer;
+    int found = 0;
+
+    timer.start();
+    for (const QPoint &point : points)
+        found += GetNearestZones(zones, 64.0, point.x(), point.y(), MapWidth, MapHeight).size();
+    const qint64 scanTime = timer.nsecsElapsed();
+
+    ZoneIndex index(zones);
+    timer.start();
+    index.resize(MapWidth, MapHeight);
+    const qint64 buildTime = timer.nsecsElapsed();
+
+    timer.start();
+    for (const QPoint &point : points)
+        found -= index.nearestZones(64.0, point.x(), point.y()).size();
+    const qint64 indexTime = timer.nsecsElapsed();
+    EXPECT_EQ(found, 0);
+
+    qInfo() << "zones:" << zones.size() << "clicks:" << points.size()
+            << "scan(us):" << scanTime / 1000
+            << "build(us):" << buildTime / 1000 << "index(us):" << indexTime / 1000;
+}